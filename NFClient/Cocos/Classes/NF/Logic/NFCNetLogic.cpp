@@ -59,7 +59,7 @@ void NFCNetLogic::ConnectServer(const std::string strIp, int nPort)
 			serverData->strIP = strIp;
 		}
 		serverData->nPort = nPort; 
-		serverData->mnLastActionTime = GetPluginManager()->GetNowTime()-9;
+		serverData->mnLastActionTime = GetPluginManager()->GetFrameTimeMS() - 9000;
 	}
 	else
 	{
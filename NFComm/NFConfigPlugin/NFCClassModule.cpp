@@ -118,6 +118,18 @@ bool NFCClassModule::AddPropertys(rapidxml::xml_node<>* pPropertyRootNode, NF_SH
                 NFASSERT(0, strPropertyName, __FILE__, __FUNCTION__);
             }
 
+            //optional, only the int, string and object values can be looked up
+            bool bIndex = false;
+            if (pPropertyNode->first_attribute("Index") != NULL)
+            {
+                bIndex = lexical_cast<bool>(pPropertyNode->first_attribute("Index")->value());
+                if (bIndex && varProperty.GetType() != TDATA_INT && varProperty.GetType() != TDATA_STRING && varProperty.GetType() != TDATA_OBJECT)
+                {
+                    NFASSERT(0, strPropertyName, __FILE__, __FUNCTION__);
+                    bIndex = false;
+                }
+            }
+
             //printf( " Property:%s[%s]\n", pstrPropertyName, pstrType );
 
             NF_SHARE_PTR<NFIProperty> xProperty = pClass->GetPropertyManager()->AddProperty(NFGUID(), strPropertyName, varProperty.GetType());
@@ -128,6 +140,7 @@ bool NFCClassModule::AddPropertys(rapidxml::xml_node<>* pPropertyRootNode, NF_SH
 			xProperty->SetRef(bRef);
 			xProperty->SetForce(bForce);
 			xProperty->SetUpload(bUpload);
+			xProperty->SetIndex(bIndex);
 
         }
     }
@@ -179,6 +192,7 @@ bool NFCClassModule::AddRecords(rapidxml::xml_node<>* pRecordRootNode, NF_SHARE_
 
 			NF_SHARE_PTR<NFDataList> recordVar(NF_NEW NFDataList());
 			NF_SHARE_PTR<NFDataList> recordTag(NF_NEW NFDataList());
+			std::vector<NF_RECORD_INDEX> recordIndex;
 
             for (rapidxml::xml_node<>* recordColNode = pRecordNode->first_node(); recordColNode;  recordColNode = recordColNode->next_sibling())
             {
@@ -202,6 +216,22 @@ bool NFCClassModule::AddRecords(rapidxml::xml_node<>* pRecordRootNode, NF_SHARE_
                 {
                     recordTag->Add("");
                 }
+
+                NF_RECORD_INDEX eIndex = NF_RECORD_INDEX_NONE;
+                if (recordColNode->first_attribute("Index") != NULL)
+                {
+                    const std::string strIndex = recordColNode->first_attribute("Index")->value();
+                    if (strIndex == "unique")
+                    {
+                        eIndex = NF_RECORD_INDEX_UNIQUE;
+                    }
+                    else if (strIndex == "multi")
+                    {
+                        eIndex = NF_RECORD_INDEX_MULTI;
+                    }
+                }
+
+                recordIndex.push_back(eIndex);
             }
 
             NF_SHARE_PTR<NFIRecord> xRecord = pClass->GetRecordManager()->AddRecord(NFGUID(), pstrRecordName, recordVar, recordTag, atoi(pstrRow));
@@ -213,6 +243,14 @@ bool NFCClassModule::AddRecords(rapidxml::xml_node<>* pRecordRootNode, NF_SHARE_
 			xRecord->SetRef(bRef);
 			xRecord->SetForce(bForce);
 			xRecord->SetUpload(bUpload);
+
+            for (int i = 0; i < (int)recordIndex.size(); ++i)
+            {
+                if (!xRecord->SetIndex(i, recordIndex[i]))
+                {
+                    NFASSERT(0, pstrRecordName, __FILE__, __FUNCTION__);
+                }
+            }
         }
     }
 
@@ -345,6 +383,70 @@ bool NFCClassModule::AddClass(const char* pstrClassFilePath, NF_SHARE_PTR<NFICla
     return true;
 }
 
+bool NFCClassModule::AddSlots(NF_SHARE_PTR<NFIClass> pClass)
+{
+    //the slots of the parent first, then the own ones sorted by name, the same order as NFProtocolDefine.hpp
+    NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pClass->GetPropertyManager();
+    NF_SHARE_PTR<NFIRecordManager> pRecordManager = pClass->GetRecordManager();
+    NF_SHARE_PTR<NFIClass> pParent = pClass->GetParent();
+    if (pParent)
+    {
+        NF_SHARE_PTR<NFIPropertyManager> pParentPropertyManager = pParent->GetPropertyManager();
+        for (int i = 0; i < pParentPropertyManager->GetPropertySlotCount(); ++i)
+        {
+            NF_SHARE_PTR<NFIProperty> pParentProperty = pParentPropertyManager->GetPropertyBySlot(i);
+            if (pParentProperty)
+            {
+                pPropertyManager->SetPropertySlot(i, pPropertyManager->GetElement(pParentProperty->GetKey()));
+            }
+        }
+
+        NF_SHARE_PTR<NFIRecordManager> pParentRecordManager = pParent->GetRecordManager();
+        for (int i = 0; i < pParentRecordManager->GetRecordSlotCount(); ++i)
+        {
+            NF_SHARE_PTR<NFIRecord> pParentRecord = pParentRecordManager->GetRecordBySlot(i);
+            if (pParentRecord)
+            {
+                pRecordManager->SetRecordSlot(i, pRecordManager->GetElement(pParentRecord->GetName()));
+            }
+        }
+    }
+
+    std::vector<std::string> xNameList;
+    for (NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->First(); pProperty; pProperty = pPropertyManager->Next())
+    {
+        if (pPropertyManager->GetPropertySlot(pProperty->GetKey()) < 0)
+        {
+            xNameList.push_back(pProperty->GetKey());
+        }
+    }
+
+    std::sort(xNameList.begin(), xNameList.end());
+    int nSlot = pPropertyManager->GetPropertySlotCount();
+    for (size_t i = 0; i < xNameList.size(); ++i)
+    {
+        pPropertyManager->SetPropertySlot(nSlot++, pPropertyManager->GetElement(xNameList[i]));
+    }
+
+    xNameList.clear();
+    for (NF_SHARE_PTR<NFIRecord> pRecord = pRecordManager->First(); pRecord; pRecord = pRecordManager->Next())
+    {
+        if (pRecordManager->GetRecordSlot(pRecord->GetName()) < 0)
+        {
+            xNameList.push_back(pRecord->GetName());
+        }
+    }
+
+    std::sort(xNameList.begin(), xNameList.end());
+    nSlot = pRecordManager->GetRecordSlotCount();
+    for (size_t i = 0; i < xNameList.size(); ++i)
+    {
+        pRecordManager->SetRecordSlot(nSlot++, pRecordManager->GetElement(xNameList[i]));
+    }
+
+    return true;
+}
+
 bool NFCClassModule::AddClass(const std::string& strClassName, const std::string& strParentName)
 {
     NF_SHARE_PTR<NFIClass> pParentClass = GetElement(strParentName);
@@ -382,6 +484,7 @@ bool NFCClassModule::Load(rapidxml::xml_node<>* attrNode, NF_SHARE_PTR<NFIClass>
     pClass->SetInstancePath(pstrInstancePath);
 
     AddClass(pstrPath, pClass);
+    AddSlots(pClass);
 
     for (rapidxml::xml_node<>* pDataNode = attrNode->first_node(); pDataNode; pDataNode = pDataNode->next_sibling())
     {
@@ -438,6 +541,47 @@ NF_SHARE_PTR<NFIRecordManager> NFCClassModule::GetClassRecordManager(const std::
     return NULL;
 }
 
+NF_SHARE_PTR<NFIClassStore> NFCClassModule::EnableClassStore(const std::string& strClassName)
+{
+    NF_SHARE_PTR<NFIClass> pClass = GetElement(strClassName);
+    if (nullptr == pClass)
+    {
+        return NULL;
+    }
+
+    if (pClass->GetClassStore())
+    {
+        return pClass->GetClassStore();
+    }
+
+    //a column for every slot except the strings
+    NF_SHARE_PTR<NFIClassStore> xStore(NF_NEW NFCClassStore());
+    NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pClass->GetPropertyManager();
+    for (int i = 0; i < pPropertyManager->GetPropertySlotCount(); ++i)
+    {
+        NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->GetPropertyBySlot(i);
+        if (pProperty && pProperty->GetType() != TDATA_STRING)
+        {
+            xStore->AddColumn(i, pProperty->GetType());
+        }
+    }
+
+    pClass->SetClassStore(xStore);
+
+    return xStore;
+}
+
+NF_SHARE_PTR<NFIClassStore> NFCClassModule::GetClassStore(const std::string& strClassName)
+{
+    NF_SHARE_PTR<NFIClass> pClass = GetElement(strClassName);
+    if (pClass)
+    {
+        return pClass->GetClassStore();
+    }
+
+    return NULL;
+}
+
 bool NFCClassModule::Clear()
 {
     return true;
@@ -11,6 +11,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
 #include "NFCElementModule.h"
 #include "Dependencies/RapidXML/rapidxml.hpp"
@@ -21,6 +22,7 @@
 #include "NFComm/NFCore/NFList.hpp"
 #include "NFComm/NFCore/NFCPropertyManager.h"
 #include "NFComm/NFCore/NFCRecordManager.h"
+#include "NFComm/NFCore/NFCClassStore.h"
 #include "NFComm/NFPluginModule/NFIClassModule.h"
 #include "NFComm/NFPluginModule/NFIElementModule.h"
 #include "NFComm/NFPluginModule/NFIPluginManager.h"
@@ -53,20 +55,30 @@ public:
         return m_pRecordManager;
     }
 
+    virtual void SetClassStore(NF_SHARE_PTR<NFIClassStore> xStore)
+    {
+        m_pClassStore = xStore;
+    }
+
+    virtual NF_SHARE_PTR<NFIClassStore> GetClassStore()
+    {
+        return m_pClassStore;
+    }
+
     virtual bool AddClassCallBack(const CLASS_EVENT_FUNCTOR_PTR& cb)
     {
-        return mxClassEventInfo.Add(cb);
+        mxClassEventInfo.push_back(cb);
+        return true;
     }
 
+    //by index and without copying the functors, a handler may create or destroy another object of this class
+    //and the hidden cursor of a list would be moved under the outer call
     virtual bool DoEvent(const NFGUID& objectID, const CLASS_OBJECT_EVENT eClassEvent, const NFDataList& valueList)
     {
-        CLASS_EVENT_FUNCTOR_PTR cb;
-        bool bRet = mxClassEventInfo.First(cb);
-        while (bRet)
+        for (int i = 0; i < (int)mxClassEventInfo.size(); ++i)
         {
-            cb->operator()(objectID, mstrClassName, eClassEvent,  valueList);
-
-            bRet = mxClassEventInfo.Next(cb);
+            CLASS_EVENT_FUNCTOR* pFunc = mxClassEventInfo[i].get();
+            pFunc->operator()(objectID, mstrClassName, eClassEvent, valueList);
         }
 
         return true;
@@ -121,6 +133,7 @@ public:
 private:
     NF_SHARE_PTR<NFIPropertyManager> m_pPropertyManager;
     NF_SHARE_PTR<NFIRecordManager> m_pRecordManager;
+    NF_SHARE_PTR<NFIClassStore> m_pClassStore;
 
     NF_SHARE_PTR<NFIClass> m_pParentClass;
     std::string mstrType;
@@ -129,7 +142,7 @@ private:
 
     std::vector<std::string> mIdList;
 
-    NFList<CLASS_EVENT_FUNCTOR_PTR> mxClassEventInfo;
+    std::vector<CLASS_EVENT_FUNCTOR_PTR> mxClassEventInfo;
 };
 
 class NFCClassModule
@@ -152,6 +165,9 @@ public:
     virtual NF_SHARE_PTR<NFIPropertyManager> GetClassPropertyManager(const std::string& strClassName);
     virtual NF_SHARE_PTR<NFIRecordManager> GetClassRecordManager(const std::string& strClassName);
 
+    virtual NF_SHARE_PTR<NFIClassStore> EnableClassStore(const std::string& strClassName);
+    virtual NF_SHARE_PTR<NFIClassStore> GetClassStore(const std::string& strClassName);
+
     virtual bool AddClass(const std::string& strClassName, const std::string& strParentName);
 
 protected:
@@ -161,6 +177,7 @@ protected:
     virtual bool AddComponents(rapidxml::xml_node<>* pRecordRootNode, NF_SHARE_PTR<NFIClass> pClass);
     virtual bool AddClassInclude(const char* pstrClassFilePath, NF_SHARE_PTR<NFIClass> pClass);
     virtual bool AddClass(const char* pstrClassFilePath, NF_SHARE_PTR<NFIClass> pClass);
+    virtual bool AddSlots(NF_SHARE_PTR<NFIClass> pClass);
 
     
     virtual bool Load(rapidxml::xml_node<>* attrNode, NF_SHARE_PTR<NFIClass> pParentClass);
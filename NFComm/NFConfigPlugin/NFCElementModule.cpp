@@ -171,6 +171,11 @@ bool NFCElementModule::Load(rapidxml::xml_node<>* attrNode, NF_SHARE_PTR<NFIClas
 			xRecord->SetForce(pRecord->GetForce());
 			xRecord->SetUpload(pRecord->GetUpload());
 
+            for (int i = 0; i < pRecord->GetCols(); ++i)
+            {
+                xRecord->SetIndex(i, pRecord->GetIndex(i));
+            }
+
             pRecord = pClassRecordManager->Next();
         }
 
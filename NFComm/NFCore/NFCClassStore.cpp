@@ -0,0 +1,257 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFCClassStore.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-20
+//    @Module           :    NFCClassStore
+//
+// -------------------------------------------------------------------------
+
+#include "NFCClassStore.h"
+
+NFCClassStore::NFCClassStore()
+{
+}
+
+NFCClassStore::~NFCClassStore()
+{
+}
+
+bool NFCClassStore::AddColumn(const int nSlot, const NFDATA_TYPE eType)
+{
+    if (nSlot < 0 || HasColumn(nSlot))
+    {
+        return false;
+    }
+
+    //the rows are added later, the columns must be there before the first object
+    if (!mxRowObject.empty())
+    {
+        return false;
+    }
+
+    int nIndex = -1;
+    switch (eType)
+    {
+    case TDATA_INT:
+        nIndex = (int)mxIntColumn.size();
+        mxIntColumn.push_back(std::vector<NFINT64>());
+        break;
+    case TDATA_FLOAT:
+        nIndex = (int)mxFloatColumn.size();
+        mxFloatColumn.push_back(std::vector<double>());
+        break;
+    case TDATA_OBJECT:
+        nIndex = (int)mxObjectColumn.size();
+        mxObjectColumn.push_back(std::vector<NFGUID>());
+        break;
+    case TDATA_VECTOR2:
+        nIndex = (int)mxVector2Column.size();
+        mxVector2Column.push_back(std::vector<NFVector2>());
+        break;
+    case TDATA_VECTOR3:
+        nIndex = (int)mxVector3Column.size();
+        mxVector3Column.push_back(std::vector<NFVector3>());
+        break;
+    default:
+        return false;
+    }
+
+    if (nSlot >= (int)mxSlotColumn.size())
+    {
+        mxSlotColumn.resize(nSlot + 1);
+    }
+
+    mxSlotColumn[nSlot].eType = eType;
+    mxSlotColumn[nSlot].nIndex = nIndex;
+
+    return true;
+}
+
+bool NFCClassStore::HasColumn(const int nSlot) const
+{
+    return nSlot >= 0 && nSlot < (int)mxSlotColumn.size() && mxSlotColumn[nSlot].nIndex >= 0;
+}
+
+int NFCClassStore::AddRow(const NFGUID& self)
+{
+    if (self.IsNull() || mxObjectRow.find(self) != mxObjectRow.end())
+    {
+        return -1;
+    }
+
+    int nRow = 0;
+    if (!mxFreeRow.empty())
+    {
+        nRow = *mxFreeRow.begin();
+        mxFreeRow.erase(mxFreeRow.begin());
+    }
+    else
+    {
+        nRow = (int)mxRowObject.size();
+        ResizeRow(nRow + 1);
+    }
+
+    mxRowObject[nRow] = self;
+    mxObjectRow.insert(std::map<NFGUID, int>::value_type(self, nRow));
+
+    return nRow;
+}
+
+bool NFCClassStore::RemoveRow(const NFGUID& self)
+{
+    std::map<NFGUID, int>::iterator it = mxObjectRow.find(self);
+    if (it == mxObjectRow.end())
+    {
+        return false;
+    }
+
+    const int nRow = it->second;
+    mxObjectRow.erase(it);
+
+    ClearRow(nRow);
+    mxRowObject[nRow] = NFGUID();
+    mxFreeRow.insert(nRow);
+
+    //give back the free rows at the end
+    int nCount = (int)mxRowObject.size();
+    while (!mxFreeRow.empty() && *mxFreeRow.rbegin() == nCount - 1)
+    {
+        mxFreeRow.erase(--mxFreeRow.end());
+        --nCount;
+    }
+
+    if (nCount < (int)mxRowObject.size())
+    {
+        ResizeRow(nCount);
+    }
+
+    return true;
+}
+
+int NFCClassStore::GetRow(const NFGUID& self) const
+{
+    std::map<NFGUID, int>::const_iterator it = mxObjectRow.find(self);
+    if (it != mxObjectRow.end())
+    {
+        return it->second;
+    }
+
+    return -1;
+}
+
+int NFCClassStore::GetRowCount() const
+{
+    return (int)mxRowObject.size();
+}
+
+const NFGUID* NFCClassStore::GetRowObject() const
+{
+    return mxRowObject.empty() ? NULL : &mxRowObject[0];
+}
+
+NFINT64* NFCClassStore::GetIntColumn(const int nSlot)
+{
+    if (!HasColumn(nSlot) || mxSlotColumn[nSlot].eType != TDATA_INT || mxRowObject.empty())
+    {
+        return NULL;
+    }
+
+    return &mxIntColumn[mxSlotColumn[nSlot].nIndex][0];
+}
+
+double* NFCClassStore::GetFloatColumn(const int nSlot)
+{
+    if (!HasColumn(nSlot) || mxSlotColumn[nSlot].eType != TDATA_FLOAT || mxRowObject.empty())
+    {
+        return NULL;
+    }
+
+    return &mxFloatColumn[mxSlotColumn[nSlot].nIndex][0];
+}
+
+NFGUID* NFCClassStore::GetObjectColumn(const int nSlot)
+{
+    if (!HasColumn(nSlot) || mxSlotColumn[nSlot].eType != TDATA_OBJECT || mxRowObject.empty())
+    {
+        return NULL;
+    }
+
+    return &mxObjectColumn[mxSlotColumn[nSlot].nIndex][0];
+}
+
+NFVector2* NFCClassStore::GetVector2Column(const int nSlot)
+{
+    if (!HasColumn(nSlot) || mxSlotColumn[nSlot].eType != TDATA_VECTOR2 || mxRowObject.empty())
+    {
+        return NULL;
+    }
+
+    return &mxVector2Column[mxSlotColumn[nSlot].nIndex][0];
+}
+
+NFVector3* NFCClassStore::GetVector3Column(const int nSlot)
+{
+    if (!HasColumn(nSlot) || mxSlotColumn[nSlot].eType != TDATA_VECTOR3 || mxRowObject.empty())
+    {
+        return NULL;
+    }
+
+    return &mxVector3Column[mxSlotColumn[nSlot].nIndex][0];
+}
+
+void NFCClassStore::ClearRow(const int nRow)
+{
+    for (size_t i = 0; i < mxIntColumn.size(); ++i)
+    {
+        mxIntColumn[i][nRow] = 0;
+    }
+
+    for (size_t i = 0; i < mxFloatColumn.size(); ++i)
+    {
+        mxFloatColumn[i][nRow] = 0.0;
+    }
+
+    for (size_t i = 0; i < mxObjectColumn.size(); ++i)
+    {
+        mxObjectColumn[i][nRow] = NFGUID();
+    }
+
+    for (size_t i = 0; i < mxVector2Column.size(); ++i)
+    {
+        mxVector2Column[i][nRow] = NFVector2();
+    }
+
+    for (size_t i = 0; i < mxVector3Column.size(); ++i)
+    {
+        mxVector3Column[i][nRow] = NFVector3();
+    }
+}
+
+void NFCClassStore::ResizeRow(const int nCount)
+{
+    mxRowObject.resize(nCount);
+    for (size_t i = 0; i < mxIntColumn.size(); ++i)
+    {
+        mxIntColumn[i].resize(nCount, 0);
+    }
+
+    for (size_t i = 0; i < mxFloatColumn.size(); ++i)
+    {
+        mxFloatColumn[i].resize(nCount, 0.0);
+    }
+
+    for (size_t i = 0; i < mxObjectColumn.size(); ++i)
+    {
+        mxObjectColumn[i].resize(nCount);
+    }
+
+    for (size_t i = 0; i < mxVector2Column.size(); ++i)
+    {
+        mxVector2Column[i].resize(nCount);
+    }
+
+    for (size_t i = 0; i < mxVector3Column.size(); ++i)
+    {
+        mxVector3Column[i].resize(nCount);
+    }
+}
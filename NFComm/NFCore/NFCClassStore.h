@@ -0,0 +1,71 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFCClassStore.h
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-20
+//    @Module           :    NFCClassStore
+//
+// -------------------------------------------------------------------------
+
+#ifndef NFC_CLASS_STORE_H
+#define NFC_CLASS_STORE_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include "NFIClassStore.h"
+
+class _NFExport NFCClassStore : public NFIClassStore
+{
+public:
+    NFCClassStore();
+    virtual ~NFCClassStore();
+
+    virtual bool AddColumn(const int nSlot, const NFDATA_TYPE eType);
+    virtual bool HasColumn(const int nSlot) const;
+
+    virtual int AddRow(const NFGUID& self);
+    virtual bool RemoveRow(const NFGUID& self);
+    virtual int GetRow(const NFGUID& self) const;
+
+    virtual int GetRowCount() const;
+    virtual const NFGUID* GetRowObject() const;
+
+    virtual NFINT64* GetIntColumn(const int nSlot);
+    virtual double* GetFloatColumn(const int nSlot);
+    virtual NFGUID* GetObjectColumn(const int nSlot);
+    virtual NFVector2* GetVector2Column(const int nSlot);
+    virtual NFVector3* GetVector3Column(const int nSlot);
+
+private:
+    void ClearRow(const int nRow);
+    void ResizeRow(const int nCount);
+
+private:
+    struct SlotColumn
+    {
+        SlotColumn()
+        {
+            eType = TDATA_UNKNOWN;
+            nIndex = -1;
+        }
+
+        NFDATA_TYPE eType;
+        //index in the column list of that type
+        int nIndex;
+    };
+
+    std::vector<SlotColumn> mxSlotColumn;
+
+    std::vector<std::vector<NFINT64>> mxIntColumn;
+    std::vector<std::vector<double>> mxFloatColumn;
+    std::vector<std::vector<NFGUID>> mxObjectColumn;
+    std::vector<std::vector<NFVector2>> mxVector2Column;
+    std::vector<std::vector<NFVector3>> mxVector3Column;
+
+    std::vector<NFGUID> mxRowObject;
+    //the lowest free row is used first, so the free ones gather at the end and are cut off
+    std::set<int> mxFreeRow;
+    std::map<NFGUID, int> mxObjectRow;
+};
+
+#endif
@@ -199,7 +199,7 @@ const std::string& NFCObject::GetPropertyString(const std::string& strPropertyNa
     return NULL_STR;
 }
 
-const NFGUID& NFCObject::GetPropertyObject(const std::string& strPropertyName)
+NFGUID NFCObject::GetPropertyObject(const std::string& strPropertyName)
 {
     NF_SHARE_PTR<NFIProperty> pProperty = GetPropertyManager()->GetElement(strPropertyName);
     if (pProperty)
@@ -210,7 +210,7 @@ const NFGUID& NFCObject::GetPropertyObject(const std::string& strPropertyName)
     return NULL_OBJECT;
 }
 
-const NFVector2& NFCObject::GetPropertyVector2(const std::string& strPropertyName)
+NFVector2 NFCObject::GetPropertyVector2(const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIProperty> pProperty = GetPropertyManager()->GetElement(strPropertyName);
 	if (pProperty)
@@ -221,7 +221,7 @@ const NFVector2& NFCObject::GetPropertyVector2(const std::string& strPropertyNam
 	return NULL_VECTOR2;
 }
 
-const NFVector3& NFCObject::GetPropertyVector3(const std::string& strPropertyName)
+NFVector3 NFCObject::GetPropertyVector3(const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIProperty> pProperty = GetPropertyManager()->GetElement(strPropertyName);
 	if (pProperty)
@@ -232,6 +232,71 @@ const NFVector3& NFCObject::GetPropertyVector3(const std::string& strPropertyNam
 	return NULL_VECTOR3;
 }
 
+bool NFCObject::SetPropertyInt(const int nSlot, const NFINT64 nValue)
+{
+    return m_pPropertyManager->SetPropertyInt(nSlot, nValue);
+}
+
+bool NFCObject::SetPropertyFloat(const int nSlot, const double dwValue)
+{
+    return m_pPropertyManager->SetPropertyFloat(nSlot, dwValue);
+}
+
+bool NFCObject::SetPropertyString(const int nSlot, const std::string& strValue)
+{
+    return m_pPropertyManager->SetPropertyString(nSlot, strValue);
+}
+
+bool NFCObject::SetPropertyObject(const int nSlot, const NFGUID& obj)
+{
+    return m_pPropertyManager->SetPropertyObject(nSlot, obj);
+}
+
+bool NFCObject::SetPropertyVector2(const int nSlot, const NFVector2& value)
+{
+    return m_pPropertyManager->SetPropertyVector2(nSlot, value);
+}
+
+bool NFCObject::SetPropertyVector3(const int nSlot, const NFVector3& value)
+{
+    return m_pPropertyManager->SetPropertyVector3(nSlot, value);
+}
+
+NFINT64 NFCObject::GetPropertyInt(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyInt(nSlot);
+}
+
+int NFCObject::GetPropertyInt32(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyInt32(nSlot);
+}
+
+double NFCObject::GetPropertyFloat(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyFloat(nSlot);
+}
+
+const std::string& NFCObject::GetPropertyString(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyString(nSlot);
+}
+
+NFGUID NFCObject::GetPropertyObject(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyObject(nSlot);
+}
+
+NFVector2 NFCObject::GetPropertyVector2(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyVector2(nSlot);
+}
+
+NFVector3 NFCObject::GetPropertyVector3(const int nSlot)
+{
+    return m_pPropertyManager->GetPropertyVector3(nSlot);
+}
+
 bool NFCObject::FindRecord(const std::string& strRecordName)
 {
     NF_SHARE_PTR<NFIRecord> pRecord = GetRecordManager()->GetElement(strRecordName);
@@ -55,9 +55,24 @@ public:
 	virtual int GetPropertyInt32(const std::string& strPropertyName);
     virtual double GetPropertyFloat(const std::string& strPropertyName);
     virtual const std::string& GetPropertyString(const std::string& strPropertyName);
-    virtual const NFGUID& GetPropertyObject(const std::string& strPropertyName);
-	virtual const NFVector2& GetPropertyVector2(const std::string& strPropertyName);
-	virtual const NFVector3& GetPropertyVector3(const std::string& strPropertyName);
+    virtual NFGUID GetPropertyObject(const std::string& strPropertyName);
+	virtual NFVector2 GetPropertyVector2(const std::string& strPropertyName);
+	virtual NFVector3 GetPropertyVector3(const std::string& strPropertyName);
+
+    virtual bool SetPropertyInt(const int nSlot, const NFINT64 nValue);
+    virtual bool SetPropertyFloat(const int nSlot, const double dwValue);
+    virtual bool SetPropertyString(const int nSlot, const std::string& strValue);
+    virtual bool SetPropertyObject(const int nSlot, const NFGUID& obj);
+    virtual bool SetPropertyVector2(const int nSlot, const NFVector2& value);
+    virtual bool SetPropertyVector3(const int nSlot, const NFVector3& value);
+
+    virtual NFINT64 GetPropertyInt(const int nSlot);
+    virtual int GetPropertyInt32(const int nSlot);
+    virtual double GetPropertyFloat(const int nSlot);
+    virtual const std::string& GetPropertyString(const int nSlot);
+    virtual NFGUID GetPropertyObject(const int nSlot);
+    virtual NFVector2 GetPropertyVector2(const int nSlot);
+    virtual NFVector3 GetPropertyVector3(const int nSlot);
 
     virtual bool FindRecord(const std::string& strRecordName);
 
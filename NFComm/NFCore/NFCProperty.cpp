@@ -11,33 +11,31 @@
 
 NFCProperty::NFCProperty()
 {
-	mbPublic = false;
-	mbPrivate = false;
-	mbSave = false;
-	mbCache = false;
-	mbRef = false;
-	mbForce = false;
-	mbUpload = false;
-
 	mSelf = NFGUID();
 	eType = TDATA_UNKNOWN;
 
-	msPropertyName = "";
+	mnStoreSlot = -1;
+	mnStoreRow = -1;
+	mbStoreUsed = false;
+
+	mpDirtySet = NULL;
+	mnDirtySlot = -1;
 }
 
 NFCProperty::NFCProperty(const NFGUID& self, const std::string& strPropertyName, const NFDATA_TYPE varType)
 {
-	mbPublic = false;
-	mbPrivate = false;
-	mbSave = false;
-	mbCache = false;
-	mbRef = false;
-	mbUpload = false;
-
 	mSelf = self;
 
-	msPropertyName = strPropertyName;
+	mxMeta = NF_SHARE_PTR<NFPropertyMeta>(NF_NEW NFPropertyMeta());
+	mxMeta->strName = strPropertyName;
 	eType = varType;
+
+	mnStoreSlot = -1;
+	mnStoreRow = -1;
+	mbStoreUsed = false;
+
+	mpDirtySet = NULL;
+	mnDirtySlot = -1;
 }
 
 NFCProperty::~NFCProperty()
@@ -64,6 +62,31 @@ void NFCProperty::SetValue(const NFData& xData)
 		return;
 	}
 
+	if (mxStore)
+	{
+		if (mtPropertyCallback.size() == 0)
+		{
+			SaveStore(xData);
+		}
+		else
+		{
+			NFData oldValue(eType);
+			LoadStore(oldValue);
+
+			SaveStore(xData);
+
+			NFData newValue(eType);
+			LoadStore(newValue);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return;
+	}
+
 	if (nullptr == mxData)
 	{
 		mxData = NF_SHARE_PTR<NFData>(NF_NEW NFData(xData));
@@ -86,6 +109,7 @@ void NFCProperty::SetValue(const NFData& xData)
 		OnEventHandler(oldValue, newValue);
 	}
 
+	SetDirty();
 }
 
 void NFCProperty::SetValue(const NFIProperty* pProperty)
@@ -93,8 +117,16 @@ void NFCProperty::SetValue(const NFIProperty* pProperty)
 	SetValue(pProperty->GetValue());
 }
 
-const NFData& NFCProperty::GetValue() const
+NFData NFCProperty::GetValue() const
 {
+	if (mxStore)
+	{
+		NFData xData(eType);
+		LoadStore(xData);
+
+		return xData;
+	}
+
 	if (mxData)
 	{
 		return *mxData;
@@ -105,81 +137,117 @@ const NFData& NFCProperty::GetValue() const
 
 const std::string&  NFCProperty::GetKey() const
 {
-	return msPropertyName;
+	return mxMeta->strName;
 }
 
 const bool NFCProperty::GetSave() const
 {
-	return mbSave;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_SAVE) != 0;
 }
 
 const bool NFCProperty::GetPublic() const
 {
-	return mbPublic;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_PUBLIC) != 0;
 }
 
 const bool NFCProperty::GetPrivate() const
 {
-	return mbPrivate;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_PRIVATE) != 0;
 }
 
 const bool NFCProperty::GetCache() const
 {
-	return mbCache;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_CACHE) != 0;
 }
 
 const bool NFCProperty::GetRef() const
 {
-	return mbRef;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_REF) != 0;
 }
 
 const bool NFCProperty::GetForce() const
 {
-	return mbForce;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_FORCE) != 0;
 }
 
 const bool NFCProperty::GetUpload() const
 {
-	return mbUpload;
+	return (mxMeta->nMask & NF_PROPERTY_MASK_UPLOAD) != 0;
+}
+
+const bool NFCProperty::GetIndex() const
+{
+	return (mxMeta->nMask & NF_PROPERTY_MASK_INDEX) != 0;
+}
+
+const int NFCProperty::GetMask() const
+{
+	return mxMeta->nMask;
 }
 
 void NFCProperty::SetSave(bool bSave)
 {
-	mbSave = bSave;
+	SetMaskFlag(NF_PROPERTY_MASK_SAVE, bSave);
 }
 
 void NFCProperty::SetPublic(bool bPublic)
 {
-	mbPublic = bPublic;
+	SetMaskFlag(NF_PROPERTY_MASK_PUBLIC, bPublic);
 }
 
 void NFCProperty::SetPrivate(bool bPrivate)
 {
-	mbPrivate = bPrivate;
+	SetMaskFlag(NF_PROPERTY_MASK_PRIVATE, bPrivate);
 }
 
 void NFCProperty::SetCache(bool bCache)
 {
-    mbCache = bCache;
+	SetMaskFlag(NF_PROPERTY_MASK_CACHE, bCache);
 }
 
 void NFCProperty::SetRef(bool bRef)
 {
-	mbRef = bRef;
+	SetMaskFlag(NF_PROPERTY_MASK_REF, bRef);
 }
 
 void NFCProperty::SetForce(bool bRef)
 {
-	mbForce = bRef;
+	SetMaskFlag(NF_PROPERTY_MASK_FORCE, bRef);
 }
 
 void NFCProperty::SetUpload(bool bUpload)
 {
-	mbUpload = bUpload;
+	SetMaskFlag(NF_PROPERTY_MASK_UPLOAD, bUpload);
+}
+
+void NFCProperty::SetIndex(bool bIndex)
+{
+	SetMaskFlag(NF_PROPERTY_MASK_INDEX, bIndex);
+}
+
+void NFCProperty::SetMaskFlag(const int nFlag, const bool bValue)
+{
+	const int nMask = bValue ? (mxMeta->nMask | nFlag) : (mxMeta->nMask & ~nFlag);
+	if (nMask == mxMeta->nMask)
+	{
+		return;
+	}
+
+	if (mxMeta.use_count() > 1)
+	{
+		mxMeta = NF_SHARE_PTR<NFPropertyMeta>(NF_NEW NFPropertyMeta(*mxMeta));
+	}
+
+	mxMeta->nMask = nMask;
 }
 
 NFINT64 NFCProperty::GetInt() const
 {
+	if (mxStore)
+	{
+		return mxStore->GetIntColumn(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return 0;
@@ -190,6 +258,11 @@ NFINT64 NFCProperty::GetInt() const
 
 int NFCProperty::GetInt32() const
 {
+	if (mxStore)
+	{
+		return (int)mxStore->GetIntColumn(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return 0;
@@ -201,6 +274,11 @@ int NFCProperty::GetInt32() const
 
 double NFCProperty::GetFloat() const
 {
+	if (mxStore)
+	{
+		return mxStore->GetFloatColumn(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return 0.0;
@@ -219,8 +297,13 @@ const std::string& NFCProperty::GetString() const
 	return mxData->GetString();
 }
 
-const NFGUID& NFCProperty::GetObject() const
+NFGUID NFCProperty::GetObject() const
 {
+	if (mxStore)
+	{
+		return mxStore->GetObjectColumn(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return NULL_OBJECT;
@@ -229,8 +312,13 @@ const NFGUID& NFCProperty::GetObject() const
 	return mxData->GetObject();
 }
 
-const NFVector2& NFCProperty::GetVector2() const
+NFVector2 NFCProperty::GetVector2() const
 {
+	if (mxStore)
+	{
+		return mxStore->GetVector2Column(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return NULL_VECTOR2;
@@ -239,8 +327,13 @@ const NFVector2& NFCProperty::GetVector2() const
 	return mxData->GetVector2();
 }
 
-const NFVector3& NFCProperty::GetVector3() const
+NFVector3 NFCProperty::GetVector3() const
 {
+	if (mxStore)
+	{
+		return mxStore->GetVector3Column(mnStoreSlot)[mnStoreRow];
+	}
+
 	if (!mxData)
 	{
 		return NULL_VECTOR3;
@@ -254,6 +347,147 @@ void NFCProperty::RegisterCallback(const PROPERTY_EVENT_FUNCTOR_PTR& cb)
 	mtPropertyCallback.push_back(cb);
 }
 
+bool NFCProperty::SetStore(NF_SHARE_PTR<NFIClassStore> xStore, const int nSlot, const int nRow)
+{
+	if (nullptr == xStore)
+	{
+		if (mxStore)
+		{
+			if (mbStoreUsed)
+			{
+				mxData = NF_SHARE_PTR<NFData>(NF_NEW NFData(eType));
+				LoadStore(*mxData);
+			}
+
+			mxStore.reset();
+			mnStoreSlot = -1;
+			mnStoreRow = -1;
+			mbStoreUsed = false;
+		}
+
+		return true;
+	}
+
+	if (mxStore || nRow < 0 || nRow >= xStore->GetRowCount())
+	{
+		return false;
+	}
+
+	bool bColumn = false;
+	switch (eType)
+	{
+	case TDATA_INT:
+		bColumn = NULL != xStore->GetIntColumn(nSlot);
+		break;
+	case TDATA_FLOAT:
+		bColumn = NULL != xStore->GetFloatColumn(nSlot);
+		break;
+	case TDATA_OBJECT:
+		bColumn = NULL != xStore->GetObjectColumn(nSlot);
+		break;
+	case TDATA_VECTOR2:
+		bColumn = NULL != xStore->GetVector2Column(nSlot);
+		break;
+	case TDATA_VECTOR3:
+		bColumn = NULL != xStore->GetVector3Column(nSlot);
+		break;
+	default:
+		break;
+	}
+
+	if (!bColumn)
+	{
+		return false;
+	}
+
+	mxStore = xStore;
+	mnStoreSlot = nSlot;
+	mnStoreRow = nRow;
+
+	mbStoreUsed = false;
+	if (mxData)
+	{
+		//the value set before goes into the column
+		SaveStore(*mxData);
+
+		mxData.reset();
+		mbStoreUsed = true;
+	}
+
+	return true;
+}
+
+void NFCProperty::LoadStore(NFData& xData) const
+{
+	switch (eType)
+	{
+	case TDATA_INT:
+		xData.SetInt(mxStore->GetIntColumn(mnStoreSlot)[mnStoreRow]);
+		break;
+	case TDATA_FLOAT:
+		xData.SetFloat(mxStore->GetFloatColumn(mnStoreSlot)[mnStoreRow]);
+		break;
+	case TDATA_OBJECT:
+		xData.SetObject(mxStore->GetObjectColumn(mnStoreSlot)[mnStoreRow]);
+		break;
+	case TDATA_VECTOR2:
+		xData.SetVector2(mxStore->GetVector2Column(mnStoreSlot)[mnStoreRow]);
+		break;
+	case TDATA_VECTOR3:
+		xData.SetVector3(mxStore->GetVector3Column(mnStoreSlot)[mnStoreRow]);
+		break;
+	default:
+		break;
+	}
+}
+
+void NFCProperty::SaveStore(const NFData& xData)
+{
+	switch (eType)
+	{
+	case TDATA_INT:
+		mxStore->GetIntColumn(mnStoreSlot)[mnStoreRow] = xData.GetInt();
+		break;
+	case TDATA_FLOAT:
+		mxStore->GetFloatColumn(mnStoreSlot)[mnStoreRow] = xData.GetFloat();
+		break;
+	case TDATA_OBJECT:
+		mxStore->GetObjectColumn(mnStoreSlot)[mnStoreRow] = xData.GetObject();
+		break;
+	case TDATA_VECTOR2:
+		mxStore->GetVector2Column(mnStoreSlot)[mnStoreRow] = xData.GetVector2();
+		break;
+	case TDATA_VECTOR3:
+		mxStore->GetVector3Column(mnStoreSlot)[mnStoreRow] = xData.GetVector3();
+		break;
+	default:
+		break;
+	}
+}
+
+void NFCProperty::InitFrom(const NFGUID& self, const NFIProperty& xPrototype)
+{
+	mSelf = self;
+	eType = xPrototype.GetType();
+
+	const NFCProperty* pClassProperty = dynamic_cast<const NFCProperty*>(&xPrototype);
+	if (pClassProperty)
+	{
+		mxMeta = pClassProperty->mxMeta;
+		return;
+	}
+
+	mxMeta = NF_SHARE_PTR<NFPropertyMeta>(NF_NEW NFPropertyMeta());
+	mxMeta->strName = xPrototype.GetKey();
+	mxMeta->nMask = xPrototype.GetMask();
+}
+
+void NFCProperty::SetDirtySet(NFDirtySet* pDirtySet, const int nSlot)
+{
+	mpDirtySet = pDirtySet;
+	mnDirtySlot = nSlot;
+}
+
 int NFCProperty::OnEventHandler(const NFData& oldVar, const NFData& newVar)
 {
 	if (mtPropertyCallback.size() <= 0)
@@ -268,7 +502,7 @@ int NFCProperty::OnEventHandler(const NFData& oldVar, const NFData& newVar)
 		
 		PROPERTY_EVENT_FUNCTOR_PTR& pFunPtr = *it;
 		PROPERTY_EVENT_FUNCTOR* pFunc = pFunPtr.get();
-		pFunc->operator()(mSelf, msPropertyName, oldVar, newVar);
+		pFunc->operator()(mSelf, mxMeta->strName, oldVar, newVar);
 	}
 
 	return 0;
@@ -281,6 +515,37 @@ bool NFCProperty::SetInt(const NFINT64 value)
 		return false;
 	}
 
+	if (mxStore)
+	{
+		NFINT64& xValue = mxStore->GetIntColumn(mnStoreSlot)[mnStoreRow];
+		if (value == xValue)
+		{
+			return false;
+		}
+
+		if (mtPropertyCallback.size() == 0)
+		{
+			xValue = value;
+		}
+		else
+		{
+			NFData oldValue(TDATA_INT);
+			oldValue.SetInt(xValue);
+
+			xValue = value;
+
+			NFData newValue(TDATA_INT);
+			newValue.SetInt(value);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return true;
+	}
+
 	if (!mxData)
 	{
 		
@@ -312,6 +577,8 @@ bool NFCProperty::SetInt(const NFINT64 value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -322,6 +589,37 @@ bool NFCProperty::SetFloat(const double value)
 		return false;
 	}
 
+	if (mxStore)
+	{
+		double& xValue = mxStore->GetFloatColumn(mnStoreSlot)[mnStoreRow];
+		if (IsZeroDouble(value - xValue))
+		{
+			return false;
+		}
+
+		if (mtPropertyCallback.size() == 0)
+		{
+			xValue = value;
+		}
+		else
+		{
+			NFData oldValue(TDATA_FLOAT);
+			oldValue.SetFloat(xValue);
+
+			xValue = value;
+
+			NFData newValue(TDATA_FLOAT);
+			newValue.SetFloat(value);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return true;
+	}
+
 	if (!mxData)
 	{
 		
@@ -353,6 +651,8 @@ bool NFCProperty::SetFloat(const double value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -394,6 +694,8 @@ bool NFCProperty::SetString(const std::string& value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -404,6 +706,37 @@ bool NFCProperty::SetObject(const NFGUID& value)
 		return false;
 	}
 
+	if (mxStore)
+	{
+		NFGUID& xValue = mxStore->GetObjectColumn(mnStoreSlot)[mnStoreRow];
+		if (value == xValue)
+		{
+			return false;
+		}
+
+		if (mtPropertyCallback.size() == 0)
+		{
+			xValue = value;
+		}
+		else
+		{
+			NFData oldValue(TDATA_OBJECT);
+			oldValue.SetObject(xValue);
+
+			xValue = value;
+
+			NFData newValue(TDATA_OBJECT);
+			newValue.SetObject(value);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return true;
+	}
+
 	if (!mxData)
 	{
 		
@@ -435,6 +768,8 @@ bool NFCProperty::SetObject(const NFGUID& value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -445,6 +780,37 @@ bool NFCProperty::SetVector2(const NFVector2& value)
 		return false;
 	}
 
+	if (mxStore)
+	{
+		NFVector2& xValue = mxStore->GetVector2Column(mnStoreSlot)[mnStoreRow];
+		if (value == xValue)
+		{
+			return false;
+		}
+
+		if (mtPropertyCallback.size() == 0)
+		{
+			xValue = value;
+		}
+		else
+		{
+			NFData oldValue(TDATA_VECTOR2);
+			oldValue.SetVector2(xValue);
+
+			xValue = value;
+
+			NFData newValue(TDATA_VECTOR2);
+			newValue.SetVector2(value);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return true;
+	}
+
 	if (!mxData)
 	{
 		
@@ -476,6 +842,8 @@ bool NFCProperty::SetVector2(const NFVector2& value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -486,6 +854,37 @@ bool NFCProperty::SetVector3(const NFVector3& value)
 		return false;
 	}
 
+	if (mxStore)
+	{
+		NFVector3& xValue = mxStore->GetVector3Column(mnStoreSlot)[mnStoreRow];
+		if (value == xValue)
+		{
+			return false;
+		}
+
+		if (mtPropertyCallback.size() == 0)
+		{
+			xValue = value;
+		}
+		else
+		{
+			NFData oldValue(TDATA_VECTOR3);
+			oldValue.SetVector3(xValue);
+
+			xValue = value;
+
+			NFData newValue(TDATA_VECTOR3);
+			newValue.SetVector3(value);
+
+			OnEventHandler(oldValue, newValue);
+		}
+
+		mbStoreUsed = true;
+		SetDirty();
+
+		return true;
+	}
+
 	if (!mxData)
 	{
 		
@@ -517,6 +916,8 @@ bool NFCProperty::SetVector3(const NFVector3& value)
 		OnEventHandler(oldValue, *mxData);
 	}
 
+	SetDirty();
+
 	return true;
 }
 
@@ -532,6 +933,11 @@ const NFDATA_TYPE NFCProperty::GetType() const
 
 const bool NFCProperty::GeUsed() const
 {
+	if (mxStore)
+	{
+		return mbStoreUsed;
+	}
+
 	if (mxData)
 	{
 		return true;
@@ -18,7 +18,28 @@
 class _NFExport NFCProperty : public NFIProperty
 {
 private:
+    //the property manager builds the properties of an object in one block from the class ones
+    friend class NFCPropertyManager;
+
     NFCProperty();
+    //the name, type and flags of the class property, for a default constructed one
+    void InitFrom(const NFGUID& self, const NFIProperty& xPrototype);
+
+    //the name and flags are the same for the property of every object of a class, they are shared with the class property
+    struct NFPropertyMeta
+    {
+        NFPropertyMeta()
+        {
+            nMask = 0;
+        }
+
+        std::string strName;
+        //NF_PROPERTY_MASK bits
+        int nMask;
+    };
+
+    //a shared meta is copied before the first change
+    void SetMaskFlag(const int nFlag, const bool bValue);
 
 public:
     NFCProperty(const NFGUID& self, const std::string& strPropertyName, const NFDATA_TYPE varType);
@@ -45,6 +66,8 @@ public:
 	virtual const bool GetRef() const;
 	virtual const bool GetForce() const;
 	virtual const bool GetUpload() const;
+	virtual const bool GetIndex() const;
+	virtual const int GetMask() const;
 
     virtual void SetSave(bool bSave);
     virtual void SetPublic(bool bPublic);
@@ -53,16 +76,17 @@ public:
 	virtual void SetRef(bool bRef);
 	virtual void SetForce(bool bRef);
 	virtual void SetUpload(bool bUpload);
+	virtual void SetIndex(bool bIndex);
 
     virtual NFINT64 GetInt() const;
 	virtual int GetInt32() const;
     virtual double GetFloat() const;
     virtual const std::string& GetString() const;
-    virtual const NFGUID& GetObject() const;
-	virtual const NFVector2& GetVector2() const;
-	virtual const NFVector3& GetVector3() const;
+    virtual NFGUID GetObject() const;
+	virtual NFVector2 GetVector2() const;
+	virtual NFVector3 GetVector3() const;
 
-    virtual const NFData& GetValue() const;
+    virtual NFData GetValue() const;
     virtual const NF_SHARE_PTR<NFList<std::string>> GetEmbeddedList() const;
     virtual const NF_SHARE_PTR<NFMapEx<std::string, std::string>> GetEmbeddedMap() const;
 
@@ -74,28 +98,45 @@ public:
 
     virtual void RegisterCallback(const PROPERTY_EVENT_FUNCTOR_PTR& cb);
 
+    virtual bool SetStore(NF_SHARE_PTR<NFIClassStore> xStore, const int nSlot, const int nRow);
+
+    virtual void SetDirtySet(NFDirtySet* pDirtySet, const int nSlot);
+
 private:
     int OnEventHandler(const NFData& oldVar, const NFData& newVar);
 
+    void SetDirty()
+    {
+        if (mpDirtySet)
+        {
+            mpDirtySet->Set(mnDirtySlot);
+        }
+    }
+
+    //mxData is null while the property has a store, the value lives in the column
+    void LoadStore(NFData& xData) const;
+    void SaveStore(const NFData& xData);
+
 private:
     typedef std::vector<PROPERTY_EVENT_FUNCTOR_PTR> TPROPERTYCALLBACKEX;
     TPROPERTYCALLBACKEX mtPropertyCallback;
 
     NFGUID mSelf;
-    std::string msPropertyName;
+    NF_SHARE_PTR<NFPropertyMeta> mxMeta;
     NFDATA_TYPE eType;
 
     NF_SHARE_PTR<NFData> mxData;
     NF_SHARE_PTR<NFMapEx<std::string, std::string>> mxEmbeddedMap;
     NF_SHARE_PTR<NFList<std::string>> mxEmbeddedList;
 
-    bool mbPublic;
-    bool mbPrivate;
-    bool mbSave;
-    bool mbCache;
-	bool mbRef;
-	bool mbForce;
-	bool mbUpload;
+    NF_SHARE_PTR<NFIClassStore> mxStore;
+    int mnStoreSlot;
+    int mnStoreRow;
+    //what GeUsed says while the value is in the column
+    bool mbStoreUsed;
+
+    NFDirtySet* mpDirtySet;
+    int mnDirtySlot;
 };
 
 #endif
@@ -11,6 +11,14 @@
 
 NFCPropertyManager::~NFCPropertyManager()
 {
+    for (int i = 0; i < (int)mxPropertySlot.size(); ++i)
+    {
+        if (mxPropertySlot[i])
+        {
+            mxPropertySlot[i]->SetDirtySet(NULL, -1);
+        }
+    }
+
     ClearAll();
 }
 
@@ -40,6 +48,7 @@ NF_SHARE_PTR<NFIProperty> NFCPropertyManager::AddProperty(const NFGUID& self, NF
         pNewProperty->SetCache(pProperty->GetCache());
         pNewProperty->SetRef(pProperty->GetRef());
 		pNewProperty->SetUpload(pProperty->GetUpload());
+		pNewProperty->SetIndex(pProperty->GetIndex());
 
         this->AddElement(strProperty, pNewProperty);
     }
@@ -173,7 +182,7 @@ const std::string& NFCPropertyManager::GetPropertyString(const std::string& strP
     return NULL_STR;
 }
 
-const NFGUID& NFCPropertyManager::GetPropertyObject(const std::string& strPropertyName)
+NFGUID NFCPropertyManager::GetPropertyObject(const std::string& strPropertyName)
 {
     NF_SHARE_PTR<NFIProperty> pProperty = GetElement(strPropertyName);
     if (pProperty)
@@ -184,7 +193,7 @@ const NFGUID& NFCPropertyManager::GetPropertyObject(const std::string& strProper
     return NULL_OBJECT;
 }
 
-const NFVector2& NFCPropertyManager::GetPropertyVector2(const std::string& strPropertyName)
+NFVector2 NFCPropertyManager::GetPropertyVector2(const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIProperty> pProperty = GetElement(strPropertyName);
 	if (pProperty)
@@ -195,7 +204,7 @@ const NFVector2& NFCPropertyManager::GetPropertyVector2(const std::string& strPr
 	return NULL_VECTOR2;
 }
 
-const NFVector3& NFCPropertyManager::GetPropertyVector3(const std::string& strPropertyName)
+NFVector3 NFCPropertyManager::GetPropertyVector3(const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIProperty> pProperty = GetElement(strPropertyName);
 	if (pProperty)
@@ -205,3 +214,194 @@ const NFVector3& NFCPropertyManager::GetPropertyVector3(const std::string& strPr
 
 	return NULL_VECTOR3;
 }
+
+bool NFCPropertyManager::SetPropertySlot(const int nSlot, NF_SHARE_PTR<NFIProperty> pProperty)
+{
+    if (nSlot < 0 || !pProperty)
+    {
+        return false;
+    }
+
+    if (nSlot >= (int)mxPropertySlot.size())
+    {
+        mxPropertySlot.resize(nSlot + 1);
+    }
+
+    if (!mxPropertyIndexMap)
+    {
+        mxPropertyIndexMap = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>());
+    }
+    else if (mxPropertyIndexMap.use_count() > 1)
+    {
+        mxPropertyIndexMap = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>(*mxPropertyIndexMap));
+    }
+
+    mxPropertySlot[nSlot] = pProperty;
+    (*mxPropertyIndexMap)[pProperty->GetKey()] = nSlot;
+    pProperty->SetDirtySet(&mxDirtySet, nSlot);
+
+    return true;
+}
+
+int NFCPropertyManager::GetPropertySlot(const std::string& strPropertyName)
+{
+    if (!mxPropertyIndexMap)
+    {
+        return -1;
+    }
+
+    std::map<std::string, int>::iterator it = mxPropertyIndexMap->find(strPropertyName);
+    if (it != mxPropertyIndexMap->end())
+    {
+        return it->second;
+    }
+
+    return -1;
+}
+
+int NFCPropertyManager::GetPropertySlotCount()
+{
+    return (int)mxPropertySlot.size();
+}
+
+NF_SHARE_PTR<NFIProperty> NFCPropertyManager::GetPropertyBySlot(const int nSlot)
+{
+    if (nSlot >= 0 && nSlot < (int)mxPropertySlot.size())
+    {
+        return mxPropertySlot[nSlot];
+    }
+
+    return nullptr;
+}
+
+bool NFCPropertyManager::CloneFrom(NF_SHARE_PTR<NFIPropertyManager> pPrototype)
+{
+    NFCPropertyManager* pClassManager = dynamic_cast<NFCPropertyManager*>(pPrototype.get());
+    if (!pClassManager || Count() > 0)
+    {
+        return false;
+    }
+
+    //all the properties in one block, every slot keeps the block alive
+    const int nCount = (int)pClassManager->mxPropertySlot.size();
+    NF_SHARE_PTR<NFCProperty> xBlock(NF_NEW NFCProperty[nCount], std::default_delete<NFCProperty[]>());
+
+    mxPropertySlot.resize(nCount);
+    for (int i = 0; i < nCount; ++i)
+    {
+        const NF_SHARE_PTR<NFIProperty>& pClassProperty = pClassManager->mxPropertySlot[i];
+        if (!pClassProperty)
+        {
+            continue;
+        }
+
+        NFCProperty* pProperty = xBlock.get() + i;
+        pProperty->InitFrom(mSelf, *pClassProperty);
+        pProperty->SetDirtySet(&mxDirtySet, i);
+
+        mxPropertySlot[i] = NF_SHARE_PTR<NFIProperty>(xBlock, pProperty);
+        AddElement(pProperty->GetKey(), mxPropertySlot[i]);
+    }
+
+    mxPropertyIndexMap = pClassManager->mxPropertyIndexMap;
+
+    return true;
+}
+
+int NFCPropertyManager::GetDirtySlot(std::vector<int>& vSlotList)
+{
+    return mxDirtySet.GetList(vSlotList);
+}
+
+bool NFCPropertyManager::IsDirty(const int nSlot)
+{
+    return mxDirtySet.Test(nSlot);
+}
+
+void NFCPropertyManager::ClearDirty()
+{
+    mxDirtySet.Clear();
+}
+
+void NFCPropertyManager::ClearDirty(const int nSlot)
+{
+    mxDirtySet.Reset(nSlot);
+}
+
+bool NFCPropertyManager::SetPropertyInt(const int nSlot, const NFINT64 nValue)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetInt(nValue) : false;
+}
+
+bool NFCPropertyManager::SetPropertyFloat(const int nSlot, const double dwValue)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetFloat(dwValue) : false;
+}
+
+bool NFCPropertyManager::SetPropertyString(const int nSlot, const std::string& strValue)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetString(strValue) : false;
+}
+
+bool NFCPropertyManager::SetPropertyObject(const int nSlot, const NFGUID& obj)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetObject(obj) : false;
+}
+
+bool NFCPropertyManager::SetPropertyVector2(const int nSlot, const NFVector2& value)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetVector2(value) : false;
+}
+
+bool NFCPropertyManager::SetPropertyVector3(const int nSlot, const NFVector3& value)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->SetVector3(value) : false;
+}
+
+NFINT64 NFCPropertyManager::GetPropertyInt(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetInt() : 0;
+}
+
+int NFCPropertyManager::GetPropertyInt32(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetInt32() : 0;
+}
+
+double NFCPropertyManager::GetPropertyFloat(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetFloat() : 0.0;
+}
+
+const std::string& NFCPropertyManager::GetPropertyString(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetString() : NULL_STR;
+}
+
+NFGUID NFCPropertyManager::GetPropertyObject(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetObject() : NULL_OBJECT;
+}
+
+NFVector2 NFCPropertyManager::GetPropertyVector2(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetVector2() : NULL_VECTOR2;
+}
+
+NFVector3 NFCPropertyManager::GetPropertyVector3(const int nSlot)
+{
+    NFIProperty* pProperty = GetSlot(nSlot);
+    return pProperty ? pProperty->GetVector3() : NULL_VECTOR3;
+}
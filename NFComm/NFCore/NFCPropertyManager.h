@@ -45,13 +45,54 @@ public:
 	virtual int GetPropertyInt32(const std::string& strPropertyName);
     virtual double GetPropertyFloat(const std::string& strPropertyName);
     virtual const std::string& GetPropertyString(const std::string& strPropertyName);
-    virtual const NFGUID& GetPropertyObject(const std::string& strPropertyName);
-	virtual const NFVector2& GetPropertyVector2(const std::string& strPropertyName);
-	virtual const NFVector3& GetPropertyVector3(const std::string& strPropertyName);
+    virtual NFGUID GetPropertyObject(const std::string& strPropertyName);
+	virtual NFVector2 GetPropertyVector2(const std::string& strPropertyName);
+	virtual NFVector3 GetPropertyVector3(const std::string& strPropertyName);
+
+    virtual bool SetPropertySlot(const int nSlot, NF_SHARE_PTR<NFIProperty> pProperty);
+    virtual int GetPropertySlot(const std::string& strPropertyName);
+    virtual int GetPropertySlotCount();
+    virtual NF_SHARE_PTR<NFIProperty> GetPropertyBySlot(const int nSlot);
+    virtual bool CloneFrom(NF_SHARE_PTR<NFIPropertyManager> pPrototype);
+
+    virtual int GetDirtySlot(std::vector<int>& vSlotList);
+    virtual bool IsDirty(const int nSlot);
+    virtual void ClearDirty();
+    virtual void ClearDirty(const int nSlot);
+
+    virtual bool SetPropertyInt(const int nSlot, const NFINT64 nValue);
+    virtual bool SetPropertyFloat(const int nSlot, const double dwValue);
+    virtual bool SetPropertyString(const int nSlot, const std::string& strValue);
+    virtual bool SetPropertyObject(const int nSlot, const NFGUID& obj);
+    virtual bool SetPropertyVector2(const int nSlot, const NFVector2& value);
+    virtual bool SetPropertyVector3(const int nSlot, const NFVector3& value);
+
+    virtual NFINT64 GetPropertyInt(const int nSlot);
+    virtual int GetPropertyInt32(const int nSlot);
+    virtual double GetPropertyFloat(const int nSlot);
+    virtual const std::string& GetPropertyString(const int nSlot);
+    virtual NFGUID GetPropertyObject(const int nSlot);
+    virtual NFVector2 GetPropertyVector2(const int nSlot);
+    virtual NFVector3 GetPropertyVector3(const int nSlot);
+
+private:
+    NFIProperty* GetSlot(const int nSlot)
+    {
+        if (nSlot >= 0 && nSlot < (int)mxPropertySlot.size())
+        {
+            return mxPropertySlot[nSlot].get();
+        }
+
+        return NULL;
+    }
 
 private:
     NFGUID mSelf;
-    std::map<std::string, int> mxPropertyIndexMap;
+    //property name -> slot
+    //shared with the class manager until a slot is set here
+    NF_SHARE_PTR<std::map<std::string, int>> mxPropertyIndexMap;
+    std::vector<NF_SHARE_PTR<NFIProperty>> mxPropertySlot;
+    NFDirtySet mxDirtySet;
 };
 
 
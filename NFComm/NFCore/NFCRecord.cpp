@@ -7,9 +7,52 @@
 // -------------------------------------------------------------------------
 
 #include <exception>
+#include <algorithm>
+#include <new>
+#include <cstddef>
 #include "NFDataList.hpp"
 #include "NFCRecord.h"
 
+//the cell types must fit their units and need no more alignment than the buffer start and the unit give them
+static_assert(sizeof(double) <= sizeof(NFINT64) && sizeof(NFVector2) <= sizeof(NFINT64), "one unit cell");
+static_assert(sizeof(NFGUID) <= 2 * sizeof(NFINT64) && sizeof(NFVector3) <= 2 * sizeof(NFINT64), "two unit cell");
+static_assert(alignof(NFGUID) <= alignof(NFINT64) && alignof(NFVector3) <= alignof(NFINT64) && alignof(double) <= alignof(NFINT64), "cell alignment");
+static_assert(alignof(NFINT64) <= alignof(std::max_align_t), "buffer alignment");
+
+//the rows of one value are kept in ascending order, so the first one is the one a scan finds
+template<typename T>
+static void InsertIndexRow(T& xIndex, const typename T::key_type& key, const int nRow)
+{
+    std::vector<int>& xRows = xIndex[key];
+    std::vector<int>::iterator it = std::lower_bound(xRows.begin(), xRows.end(), nRow);
+    if (it == xRows.end() || *it != nRow)
+    {
+        xRows.insert(it, nRow);
+    }
+}
+
+template<typename T>
+static void EraseIndexRow(T& xIndex, const typename T::key_type& key, const int nRow)
+{
+    typename T::iterator it = xIndex.find(key);
+    if (it == xIndex.end())
+    {
+        return;
+    }
+
+    std::vector<int>& xRows = it->second;
+    std::vector<int>::iterator itRow = std::lower_bound(xRows.begin(), xRows.end(), nRow);
+    if (itRow != xRows.end() && *itRow == nRow)
+    {
+        xRows.erase(itRow);
+    }
+
+    if (xRows.empty())
+    {
+        xIndex.erase(it);
+    }
+}
+
 NFCRecord::NFCRecord()
 {
     mSelf = NFGUID();
@@ -24,6 +67,11 @@ NFCRecord::NFCRecord()
 
     mstrRecordName = "";
     mnMaxRow = 0;
+    mnRowWidth = 0;
+    mnStringCols = 0;
+
+    mpDirtySet = NULL;
+    mnDirtySlot = -1;
 
 }
 
@@ -42,6 +90,9 @@ NFCRecord::NFCRecord(const NFGUID& self, const std::string& strRecordName, const
 
     mstrRecordName = strRecordName;
 
+    mpDirtySet = NULL;
+    mnDirtySlot = -1;
+
     mnMaxRow = nMaxRow;
     
     mVecUsedState.resize(mnMaxRow);
@@ -51,39 +102,154 @@ NFCRecord::NFCRecord(const NFGUID& self, const std::string& strRecordName, const
         mVecUsedState[i] = 0;
     }
 
-	//init share_pointer for all data
-    for (int i = 0; i < GetRows() * GetCols(); i++)
+    //the layout of one row, then one buffer for all the rows
+    mnRowWidth = 0;
+    mnStringCols = 0;
+    mxColLayout.resize(GetCols());
+    for (int i = 0; i < GetCols(); ++i)
+    {
+        ColLayout& xLayout = mxColLayout[i];
+        xLayout.eType = GetColType(i);
+        switch (xLayout.eType)
+        {
+            case TDATA_STRING:
+                xLayout.nOffset = mnStringCols++;
+                break;
+            case TDATA_OBJECT:
+            case TDATA_VECTOR3:
+                xLayout.nOffset = mnRowWidth;
+                mnRowWidth += 2;
+                break;
+            default:
+                xLayout.nOffset = mnRowWidth;
+                mnRowWidth += 1;
+                break;
+        }
+    }
+
+    mxCellData.resize(mnMaxRow * mnRowWidth * CELL_UNIT_SIZE);
+    mxStringCell.resize(mnMaxRow * mnStringCols);
+
+    for (int nRow = 0; nRow < mnMaxRow; ++nRow)
     {
-        mtRecordVec.push_back(NF_SHARE_PTR<NFData>());
+        InitRowCell(nRow, NULL);
     }
 
-	//optimize would be better, it should be applied memory space only once
+    mmTag = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>());
     for (int i = 0; i < mVarRecordTag->GetCount(); ++i)
     {
         if (!mVarRecordTag->String(i).empty())
         {
-            mmTag[mVarRecordTag->String(i)] = i;
+            (*mmTag)[mVarRecordTag->String(i)] = i;
         }
     }
 }
 
-NFCRecord::~NFCRecord()
+NFCRecord::NFCRecord(const NFGUID& self, const NFCRecord& xPrototype)
 {
-    for (TRECORDVEC::iterator iter = mtRecordVec.begin(); iter != mtRecordVec.end(); ++iter)
+    mVarRecordType = xPrototype.mVarRecordType;
+    mVarRecordTag = xPrototype.mVarRecordTag;
+    mmTag = xPrototype.mmTag;
+
+    mSelf = self;
+
+    mbSave = xPrototype.mbSave;
+    mbPublic = xPrototype.mbPublic;
+    mbPrivate = xPrototype.mbPrivate;
+    mbCache = xPrototype.mbCache;
+    mbRef = xPrototype.mbRef;
+    mbForce = xPrototype.mbForce;
+    mbUpload = xPrototype.mbUpload;
+
+    mstrRecordName = xPrototype.mstrRecordName;
+
+    mpDirtySet = NULL;
+    mnDirtySlot = -1;
+
+    //the layout is the same, so the cells are copied over one by one in their own types
+    mnMaxRow = xPrototype.mnMaxRow;
+    mnRowWidth = xPrototype.mnRowWidth;
+    mnStringCols = xPrototype.mnStringCols;
+    mxColLayout = xPrototype.mxColLayout;
+    mxColIndex = xPrototype.mxColIndex;
+    mxCellData.resize(xPrototype.mxCellData.size());
+    for (int nRow = 0; nRow < mnMaxRow; ++nRow)
     {
-        iter->reset();
+        InitRowCell(nRow, &xPrototype);
     }
 
+    mxStringCell = xPrototype.mxStringCell;
+    mVecUsedState = xPrototype.mVecUsedState;
+}
+
+NFCRecord::~NFCRecord()
+{
     for (TRECORDCALLBACKEX::iterator iter = mtRecordCallback.begin(); iter != mtRecordCallback.end(); ++iter)
     {
         iter->reset();
     }
 
-    mtRecordVec.clear();
+    mxCellData.clear();
+    mxStringCell.clear();
     mVecUsedState.clear();
     mtRecordCallback.clear();
 }
 
+void NFCRecord::InitRowCell(const int nRow, const NFCRecord* pFrom)
+{
+    for (int i = 0; i < (int)mxColLayout.size(); ++i)
+    {
+        unsigned char* pCell = GetCellBuff(nRow, i);
+        switch (mxColLayout[i].eType)
+        {
+            case TDATA_INT:
+                new (pCell) NFINT64(pFrom ? pFrom->GetCell<NFINT64>(nRow, i) : 0);
+                break;
+            case TDATA_FLOAT:
+                new (pCell) double(pFrom ? pFrom->GetCell<double>(nRow, i) : 0.0);
+                break;
+            case TDATA_OBJECT:
+                new (pCell) NFGUID(pFrom ? pFrom->GetCell<NFGUID>(nRow, i) : NFGUID());
+                break;
+            case TDATA_VECTOR2:
+                new (pCell) NFVector2(pFrom ? pFrom->GetCell<NFVector2>(nRow, i) : NFVector2());
+                break;
+            case TDATA_VECTOR3:
+                new (pCell) NFVector3(pFrom ? pFrom->GetCell<NFVector3>(nRow, i) : NFVector3());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void NFCRecord::SwapRowCell(const int nOriginRow, const int nTargetRow)
+{
+    for (int i = 0; i < (int)mxColLayout.size(); ++i)
+    {
+        switch (mxColLayout[i].eType)
+        {
+            case TDATA_INT:
+                std::swap(GetCell<NFINT64>(nOriginRow, i), GetCell<NFINT64>(nTargetRow, i));
+                break;
+            case TDATA_FLOAT:
+                std::swap(GetCell<double>(nOriginRow, i), GetCell<double>(nTargetRow, i));
+                break;
+            case TDATA_OBJECT:
+                std::swap(GetCell<NFGUID>(nOriginRow, i), GetCell<NFGUID>(nTargetRow, i));
+                break;
+            case TDATA_VECTOR2:
+                std::swap(GetCell<NFVector2>(nOriginRow, i), GetCell<NFVector2>(nTargetRow, i));
+                break;
+            case TDATA_VECTOR3:
+                std::swap(GetCell<NFVector3>(nOriginRow, i), GetCell<NFVector3>(nTargetRow, i));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 int NFCRecord::GetCols() const
 {
     return mVarRecordType->GetCount();
@@ -104,6 +270,57 @@ const std::string& NFCRecord::GetColTag(const int nCol) const
     return mVarRecordTag->String(nCol);
 }
 
+bool NFCRecord::SetIndex(const int nCol, const NF_RECORD_INDEX eIndex)
+{
+    if (!ValidCol(nCol))
+    {
+        return false;
+    }
+
+    switch (GetColType(nCol))
+    {
+        case TDATA_INT:
+        case TDATA_STRING:
+        case TDATA_OBJECT:
+            break;
+        default:
+            return NF_RECORD_INDEX_NONE == eIndex;
+    }
+
+    if (mxColIndex.empty())
+    {
+        if (NF_RECORD_INDEX_NONE == eIndex)
+        {
+            return true;
+        }
+
+        mxColIndex.resize(GetCols());
+    }
+
+    ColIndex& xColIndex = mxColIndex[nCol];
+    xColIndex.eIndex = eIndex;
+    xColIndex.xIntIndex.clear();
+    xColIndex.xStringIndex.clear();
+    xColIndex.xObjectIndex.clear();
+
+    for (int i = 0; i < mnMaxRow; ++i)
+    {
+        AddIndex(i, nCol);
+    }
+
+    return true;
+}
+
+NF_RECORD_INDEX NFCRecord::GetIndex(const int nCol) const
+{
+    if (!IsIndexed(nCol))
+    {
+        return NF_RECORD_INDEX_NONE;
+    }
+
+    return mxColIndex[nCol].eIndex;
+}
+
 
 int NFCRecord::AddRow(const int nRow)
 {
@@ -154,21 +371,25 @@ int NFCRecord::AddRow(const int nRow, const NFDataList& var)
         {
             return -1;
         }
+
+        if (!CheckIndex(nFindRow, i, *var.GetStack(i)))
+        {
+            return -1;
+        }
     }
 
-    SetUsed(nFindRow, 1);
+    //the covered values leave the index first
+    RemoveRowIndex(nFindRow);
+    mVecUsedState[nFindRow] = 1;
 
     for (int i = 0; i < GetCols(); ++i)
     {
-        NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nFindRow, i));
-		if (nullptr == pVar)
-		{
-			pVar = NF_SHARE_PTR<NFData>(NF_NEW NFData(var.Type(i)));
-		}
-
-		pVar->variantData = var.GetStack(i)->variantData;
+        SetCellData(nFindRow, i, var, i);
     }
 
+    AddRowIndex(nFindRow);
+    SetDirty(nFindRow);
+
 	RECORD_EVENT_DATA xEventData;
 	xEventData.nOpType = bCover? RECORD_EVENT_DATA::Cover : RECORD_EVENT_DATA::Add;
 	xEventData.nRow = nFindRow;
@@ -199,19 +420,25 @@ bool NFCRecord::SetRow(const int nRow, const NFDataList & var)
 		{
 			return false;
 		}
+
+		if (!CheckIndex(nRow, i, *var.GetStack(i)))
+		{
+			return false;
+		}
 	}
 
 	for (int i = 0; i < GetCols(); ++i)
 	{
-		NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, i));
-		if (nullptr == pVar)
-		{
-			pVar = NF_SHARE_PTR<NFData>(NF_NEW NFData(var.Type(i)));
-		}
+		NFData oldValue;
+		GetCellData(nRow, i, oldValue);
 
-		NFData oldValue = *pVar;
+		RemoveIndex(nRow, i);
+		SetCellData(nRow, i, var, i);
+		AddIndex(nRow, i);
+		SetDirty(nRow);
 
-		pVar->variantData = var.GetStack(i)->variantData;
+		NFData newValue;
+		GetCellData(nRow, i, newValue);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -219,7 +446,7 @@ bool NFCRecord::SetRow(const int nRow, const NFDataList & var)
 		xEventData.nCol = i;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
 	return false;
@@ -242,31 +469,39 @@ bool NFCRecord::SetInt(const int nRow, const int nCol, const NFINT64 value)
         return false;
     }
 
-	NFData var;
-    var.SetInt(value);
-
-    NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-	//must have memory
-	if (nullptr == pVar)
+	NFINT64& xValue = GetCell<NFINT64>(nRow, nCol);
+	if (xValue == value)
 	{
 		return false;
 	}
 
-	if (var == *pVar)
+	if (IsIndexed(nCol))
 	{
-		return false;
+		NFData var;
+		var.SetInt(value);
+		if (!CheckIndex(nRow, nCol, var))
+		{
+			return false;
+		}
+
+		RemoveIndex(nRow, nCol);
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetInt(value);
+		xValue = value;
+		AddIndex(nRow, nCol);
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetInt(pVar->GetInt());
+		oldValue.SetInt(xValue);
 
-		pVar->SetInt(value);
+		xValue = value;
+		AddIndex(nRow, nCol);
+
+		NFData newValue;
+		newValue.SetInt(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -274,9 +509,11 @@ bool NFCRecord::SetInt(const int nRow, const int nCol, const NFINT64 value)
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
+    SetDirty(nRow);
+
     return true;
 }
 
@@ -303,31 +540,25 @@ bool NFCRecord::SetFloat(const int nRow, const int nCol, const double value)
         return false;
     }
 
-    NFData var;
-    var.SetFloat(value);
-
-    NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-
-	//must have memory
-	if (nullptr == pVar)
-	{
-		return false;
-	}
-
-	if (var == *pVar)
+	double& xValue = GetCell<double>(nRow, nCol);
+	if (xValue - value < 0.001 && xValue - value > -0.001)
 	{
 		return false;
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetFloat(value);
+		xValue = value;
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetFloat(pVar->GetFloat());
-		pVar->SetFloat(value);
+		oldValue.SetFloat(xValue);
+
+		xValue = value;
+
+		NFData newValue;
+		newValue.SetFloat(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -335,9 +566,11 @@ bool NFCRecord::SetFloat(const int nRow, const int nCol, const double value)
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
+    SetDirty(nRow);
+
     return true;
 }
 
@@ -364,32 +597,39 @@ bool NFCRecord::SetString(const int nRow, const int nCol, const std::string& val
         return false;
     }
 
-    NFData var;
-    var.SetString(value);
-
-    NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-
-	//must have memory
-	if (nullptr == pVar)
+	std::string& xValue = GetStringCell(nRow, nCol);
+	if (xValue == value)
 	{
 		return false;
 	}
 
-	if (var == *pVar)
+	if (IsIndexed(nCol))
 	{
-		return false;
+		NFData var;
+		var.SetString(value);
+		if (!CheckIndex(nRow, nCol, var))
+		{
+			return false;
+		}
+
+		RemoveIndex(nRow, nCol);
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetString(value);
+		xValue = value;
+		AddIndex(nRow, nCol);
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetString(pVar->GetString());
+		oldValue.SetString(xValue);
 
-		pVar->SetString(value);
+		xValue = value;
+		AddIndex(nRow, nCol);
+
+		NFData newValue;
+		newValue.SetString(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -397,9 +637,11 @@ bool NFCRecord::SetString(const int nRow, const int nCol, const std::string& val
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
+    SetDirty(nRow);
+
     return true;
 }
 
@@ -426,32 +668,39 @@ bool NFCRecord::SetObject(const int nRow, const int nCol, const NFGUID& value)
         return false;
     }
 
-    NFData var;
-    var.SetObject(value);
-
-    NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-
-	//must have memory
-	if (nullptr == pVar)
+	NFGUID& xValue = GetCell<NFGUID>(nRow, nCol);
+	if (xValue == value)
 	{
 		return false;
 	}
 
-	if (var == *pVar)
+	if (IsIndexed(nCol))
 	{
-		return false;
+		NFData var;
+		var.SetObject(value);
+		if (!CheckIndex(nRow, nCol, var))
+		{
+			return false;
+		}
+
+		RemoveIndex(nRow, nCol);
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetObject(value);
+		xValue = value;
+		AddIndex(nRow, nCol);
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetObject(pVar->GetObject());
+		oldValue.SetObject(xValue);
+
+		xValue = value;
+		AddIndex(nRow, nCol);
 
-		pVar->SetObject(value);
+		NFData newValue;
+		newValue.SetObject(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -459,9 +708,11 @@ bool NFCRecord::SetObject(const int nRow, const int nCol, const NFGUID& value)
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
+    SetDirty(nRow);
+
     return true;
 }
 
@@ -473,47 +724,40 @@ bool NFCRecord::SetObject(const int nRow, const std::string& strColTag, const NF
 
 bool NFCRecord::SetVector2(const int nRow, const int nCol, const NFVector2& value)
 {
-	if (!ValidPos(nRow, nCol))
-	{
-		return false;
-	}
-
-	if (TDATA_VECTOR2 != GetColType(nCol))
-	{
-		return false;
-	}
-
-	if (!IsUsed(nRow))
-	{
-		return false;
-	}
-
-	NFData var;
-	var.SetVector2(value);
+    if (!ValidPos(nRow, nCol))
+    {
+        return false;
+    }
 
-	NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
+    if (TDATA_VECTOR2 != GetColType(nCol))
+    {
+        return false;
+    }
 
-	//must have memory
-	if (nullptr == pVar)
-	{
-		return false;
-	}
+    if (!IsUsed(nRow))
+    {
+        return false;
+    }
 
-	if (var == *pVar)
+	NFVector2& xValue = GetCell<NFVector2>(nRow, nCol);
+	if (xValue == value)
 	{
 		return false;
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetVector2(value);
+		xValue = value;
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetVector2(pVar->GetVector2());
+		oldValue.SetVector2(xValue);
 
-		pVar->SetVector2(value);
+		xValue = value;
+
+		NFData newValue;
+		newValue.SetVector2(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -521,55 +765,50 @@ bool NFCRecord::SetVector2(const int nRow, const int nCol, const NFVector2& valu
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
-	return true;
+    SetDirty(nRow);
+
+    return true;
 }
 
 bool NFCRecord::SetVector3(const int nRow, const int nCol, const NFVector3& value)
 {
-	if (!ValidPos(nRow, nCol))
-	{
-		return false;
-	}
-
-	if (TDATA_VECTOR3 != GetColType(nCol))
-	{
-		return false;
-	}
-
-	if (!IsUsed(nRow))
-	{
-		return false;
-	}
-
-	NFData var;
-	var.SetVector3(value);
+    if (!ValidPos(nRow, nCol))
+    {
+        return false;
+    }
 
-	NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
+    if (TDATA_VECTOR3 != GetColType(nCol))
+    {
+        return false;
+    }
 
-	//must have memory
-	if (nullptr == pVar)
-	{
-		return false;
-	}
+    if (!IsUsed(nRow))
+    {
+        return false;
+    }
 
-	if (var == *pVar)
+	NFVector3& xValue = GetCell<NFVector3>(nRow, nCol);
+	if (xValue == value)
 	{
 		return false;
 	}
 
 	if (mtRecordCallback.size() == 0)
 	{
-		pVar->SetVector3(value);
+		xValue = value;
 	}
 	else
 	{
 		NFData oldValue;
-		oldValue.SetVector3(pVar->GetVector3());
+		oldValue.SetVector3(xValue);
+
+		xValue = value;
 
-		pVar->SetVector3(value);
+		NFData newValue;
+		newValue.SetVector3(value);
 
 		RECORD_EVENT_DATA xEventData;
 		xEventData.nOpType = RECORD_EVENT_DATA::Update;
@@ -577,10 +816,12 @@ bool NFCRecord::SetVector3(const int nRow, const int nCol, const NFVector3& valu
 		xEventData.nCol = nCol;
 		xEventData.strRecordName = mstrRecordName;
 
-		OnEventHandler(mSelf, xEventData, oldValue, *pVar);
+		OnEventHandler(mSelf, xEventData, oldValue, newValue);
 	}
 
-	return true;
+    SetDirty(nRow);
+
+    return true;
 }
 
 bool NFCRecord::SetVector2(const int nRow, const std::string& strColTag, const NFVector2& value)
@@ -611,42 +852,29 @@ bool NFCRecord::QueryRow(const int nRow, NFDataList& varList)
     varList.Clear();
     for (int i = 0; i < GetCols(); ++i)
     {
-        NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, i));
-        if (pVar)
-        {
-            varList.Append(*pVar);
-        }
-        else
+        switch (mxColLayout[i].eType)
         {
-            switch (GetColType(i))
-            {
-                case TDATA_INT:
-                    varList.Add(NFINT64(0));
-                    break;
-
-                case TDATA_FLOAT:
-                    varList.Add(0.0f);
-                    break;
-
-                case TDATA_STRING:
-                    varList.Add(NULL_STR.c_str());
-                    break;
-
-                case TDATA_OBJECT:
-                    varList.Add(NFGUID());
-                    break;
-
-				case TDATA_VECTOR2:
-					varList.Add(NFVector2());
-					break;
-
-				case TDATA_VECTOR3:
-					varList.Add(NFVector3());
-					break;
-                default:
-                    return false;
-                    break;
-            }
+            case TDATA_INT:
+                varList.Add(GetCell<NFINT64>(nRow, i));
+                break;
+            case TDATA_FLOAT:
+                varList.Add(GetCell<double>(nRow, i));
+                break;
+            case TDATA_STRING:
+                varList.Add(GetStringCell(nRow, i));
+                break;
+            case TDATA_OBJECT:
+                varList.Add(GetCell<NFGUID>(nRow, i));
+                break;
+			case TDATA_VECTOR2:
+				varList.Add(GetCell<NFVector2>(nRow, i));
+				break;
+			case TDATA_VECTOR3:
+				varList.Add(GetCell<NFVector3>(nRow, i));
+				break;
+            default:
+                return false;
+                break;
         }
     }
 
@@ -665,18 +893,12 @@ NFINT64 NFCRecord::GetInt(const int nRow, const int nCol) const
         return 0;
     }
 
-    if (!IsUsed(nRow))
-    {
-        return 0;
-    }
-
-    const NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-    if (!pVar)
+    if (!IsUsed(nRow) || TDATA_INT != mxColLayout[nCol].eType)
     {
         return 0;
     }
 
-    return pVar->GetInt();
+    return GetCell<NFINT64>(nRow, nCol);
 }
 
 NFINT64 NFCRecord::GetInt(const int nRow, const std::string& strColTag) const
@@ -692,18 +914,12 @@ double NFCRecord::GetFloat(const int nRow, const int nCol) const
         return 0.0f;
     }
 
-    if (!IsUsed(nRow))
-    {
-        return 0.0f;
-    }
-
-    const NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-    if (!pVar)
+    if (!IsUsed(nRow) || TDATA_FLOAT != mxColLayout[nCol].eType)
     {
         return 0.0f;
     }
 
-    return pVar->GetFloat();
+    return GetCell<double>(nRow, nCol);
 }
 
 double NFCRecord::GetFloat(const int nRow, const std::string& strColTag) const
@@ -719,18 +935,12 @@ const std::string& NFCRecord::GetString(const int nRow, const int nCol) const
         return NULL_STR;
     }
 
-    if (!IsUsed(nRow))
-    {
-        return NULL_STR;
-    }
-
-    const NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-    if (!pVar)
+    if (!IsUsed(nRow) || TDATA_STRING != mxColLayout[nCol].eType)
     {
         return NULL_STR;
     }
 
-    return pVar->GetString();
+    return GetStringCell(nRow, nCol);
 }
 
 const std::string& NFCRecord::GetString(const int nRow, const std::string& strColTag) const
@@ -746,18 +956,12 @@ const NFGUID& NFCRecord::GetObject(const int nRow, const int nCol) const
         return NULL_OBJECT;
     }
 
-    if (!IsUsed(nRow))
-    {
-        return NULL_OBJECT;
-    }
-
-    const  NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-    if (!pVar)
+    if (!IsUsed(nRow) || TDATA_OBJECT != mxColLayout[nCol].eType)
     {
         return NULL_OBJECT;
     }
 
-    return pVar->GetObject();
+    return GetCell<NFGUID>(nRow, nCol);
 }
 
 const NFGUID& NFCRecord::GetObject(const int nRow, const std::string& strColTag) const
@@ -768,23 +972,17 @@ const NFGUID& NFCRecord::GetObject(const int nRow, const std::string& strColTag)
 
 const NFVector2& NFCRecord::GetVector2(const int nRow, const int nCol) const
 {
-	if (!ValidPos(nRow, nCol))
-	{
-		return NULL_VECTOR2;
-	}
-
-	if (!IsUsed(nRow))
-	{
-		return NULL_VECTOR2;
-	}
+    if (!ValidPos(nRow, nCol))
+    {
+        return NULL_VECTOR2;
+    }
 
-	const  NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-	if (!pVar)
-	{
-		return NULL_VECTOR2;
-	}
+    if (!IsUsed(nRow) || TDATA_VECTOR2 != mxColLayout[nCol].eType)
+    {
+        return NULL_VECTOR2;
+    }
 
-	return pVar->GetVector2();
+    return GetCell<NFVector2>(nRow, nCol);
 }
 
 const NFVector2& NFCRecord::GetVector2(const int nRow, const std::string& strColTag) const
@@ -795,23 +993,17 @@ const NFVector2& NFCRecord::GetVector2(const int nRow, const std::string& strCol
 
 const NFVector3& NFCRecord::GetVector3(const int nRow, const int nCol) const
 {
-	if (!ValidPos(nRow, nCol))
-	{
-		return NULL_VECTOR3;
-	}
-
-	if (!IsUsed(nRow))
-	{
-		return NULL_VECTOR3;
-	}
+    if (!ValidPos(nRow, nCol))
+    {
+        return NULL_VECTOR3;
+    }
 
-	const  NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, nCol));
-	if (!pVar)
-	{
-		return NULL_VECTOR3;
-	}
+    if (!IsUsed(nRow) || TDATA_VECTOR3 != mxColLayout[nCol].eType)
+    {
+        return NULL_VECTOR3;
+    }
 
-	return pVar->GetVector3();
+    return GetCell<NFVector3>(nRow, nCol);
 }
 
 const NFVector3& NFCRecord::GetVector3(const int nRow, const std::string& strColTag) const
@@ -884,6 +1076,20 @@ int NFCRecord::FindInt(const int nCol, const NFINT64 value, NFDataList& varResul
         return -1;
     }
 
+    if (IsIndexed(nCol))
+    {
+        const std::vector<int>* pRows = FindIndex(nCol, value);
+        if (pRows)
+        {
+            for (size_t i = 0; i < pRows->size(); ++i)
+            {
+                varResult << (int64_t)(*pRows)[i];
+            }
+        }
+
+        return varResult.GetCount();
+    }
+
     {
         for (int i = 0; i < mnMaxRow; ++i)
         {
@@ -892,7 +1098,7 @@ int NFCRecord::FindInt(const int nCol, const NFINT64 value, NFDataList& varResul
                 continue;
             }
 
-            if (GetInt(i, nCol) == value)
+            if (GetCell<NFINT64>(i, nCol) == value)
             {
                 varResult << i;
             }
@@ -934,7 +1140,7 @@ int NFCRecord::FindFloat(const int nCol, const double value, NFDataList& varResu
             continue;
         }
 
-        if (GetFloat(i, nCol) == value)
+        if (GetCell<double>(i, nCol) == value)
         {
             varResult << i;
         }
@@ -966,6 +1172,19 @@ int NFCRecord::FindString(const int nCol, const std::string& value, NFDataList&
         return -1;
     }
 
+    if (IsIndexed(nCol))
+    {
+        const std::vector<int>* pRows = FindIndex(nCol, value);
+        if (pRows)
+        {
+            for (size_t i = 0; i < pRows->size(); ++i)
+            {
+                varResult << (int64_t)(*pRows)[i];
+            }
+        }
+
+        return varResult.GetCount();
+    }
 
     {
         for (int i = 0; i < mnMaxRow; ++i)
@@ -975,8 +1194,7 @@ int NFCRecord::FindString(const int nCol, const std::string& value, NFDataList&
                 continue;
             }
 
-            const std::string& strData = GetString(i, nCol);
-            if (0 == strcmp(strData.c_str(), value.c_str()))
+            if (GetStringCell(i, nCol) == value)
             {
                 varResult << (int64_t)i;
             }
@@ -1011,6 +1229,20 @@ int NFCRecord::FindObject(const int nCol, const NFGUID& value, NFDataList& varRe
         return -1;
     }
 
+    if (IsIndexed(nCol))
+    {
+        const std::vector<int>* pRows = FindIndex(nCol, value);
+        if (pRows)
+        {
+            for (size_t i = 0; i < pRows->size(); ++i)
+            {
+                varResult << (int64_t)(*pRows)[i];
+            }
+        }
+
+        return varResult.GetCount();
+    }
+
     {
         for (int i = 0; i < mnMaxRow; ++i)
         {
@@ -1019,7 +1251,7 @@ int NFCRecord::FindObject(const int nCol, const NFGUID& value, NFDataList& varRe
                 continue;
             }
 
-            if (GetObject(i, nCol) == value)
+            if (GetCell<NFGUID>(i, nCol) == value)
             {
                 varResult << (int64_t)i;
             }
@@ -1062,7 +1294,7 @@ int NFCRecord::FindVector2(const int nCol, const NFVector2& value, NFDataList& v
 				continue;
 			}
 
-			if (GetVector2(i, nCol) == value)
+			if (GetCell<NFVector2>(i, nCol) == value)
 			{
 				varResult << (int64_t)i;
 			}
@@ -1105,7 +1337,7 @@ int NFCRecord::FindVector3(const int nCol, const NFVector3& value, NFDataList& v
 				continue;
 			}
 
-			if (GetVector3(i, nCol) == value)
+			if (GetCell<NFVector3>(i, nCol) == value)
 			{
 				varResult << (int64_t)i;
 			}
@@ -1119,11 +1351,27 @@ int NFCRecord::FindVector3(const int nCol, const NFVector3& value, NFDataList& v
 
 int NFCRecord::FindRowByColValue(const int nCol, const NFData & var)
 {
-	NFDataList xDataList;
-	int nRowCount = FindRowByColValue(nCol, var, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
+	{
+		return -1;
+	}
+
+	switch (var.GetType())
 	{
-		return (int) xDataList.Int(0);
+		case TDATA_INT:
+			return FindInt(nCol, var.GetInt());
+		case TDATA_FLOAT:
+			return FindFloat(nCol, var.GetFloat());
+		case TDATA_STRING:
+			return FindString(nCol, var.GetString());
+		case TDATA_OBJECT:
+			return FindObject(nCol, var.GetObject());
+		case TDATA_VECTOR2:
+			return FindVector2(nCol, var.GetVector2());
+		case TDATA_VECTOR3:
+			return FindVector3(nCol, var.GetVector3());
+		default:
+			break;
 	}
 
 	return -1;
@@ -1131,11 +1379,28 @@ int NFCRecord::FindRowByColValue(const int nCol, const NFData & var)
 
 int NFCRecord::FindInt(const int nCol, const NFINT64 value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindInt(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
+	{
+		return -1;
+	}
+
+	if (TDATA_INT != mVarRecordType->Type(nCol))
+	{
+		return -1;
+	}
+
+	if (IsIndexed(nCol))
 	{
-		return (int) xDataList.Int(0);
+		const std::vector<int>* pRows = FindIndex(nCol, value);
+		return pRows ? pRows->front() : -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetCell<NFINT64>(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1143,11 +1408,22 @@ int NFCRecord::FindInt(const int nCol, const NFINT64 value)
 
 int NFCRecord::FindFloat(const int nCol, const double value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindFloat(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
+	{
+		return -1;
+	}
+
+	if (TDATA_FLOAT != mVarRecordType->Type(nCol))
 	{
-		return (int) xDataList.Int(0);
+		return -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetCell<double>(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1155,11 +1431,28 @@ int NFCRecord::FindFloat(const int nCol, const double value)
 
 int NFCRecord::FindString(const int nCol, const std::string & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindString(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
 	{
-		return (int) xDataList.Int(0);
+		return -1;
+	}
+
+	if (TDATA_STRING != mVarRecordType->Type(nCol))
+	{
+		return -1;
+	}
+
+	if (IsIndexed(nCol))
+	{
+		const std::vector<int>* pRows = FindIndex(nCol, value);
+		return pRows ? pRows->front() : -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetStringCell(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1167,11 +1460,28 @@ int NFCRecord::FindString(const int nCol, const std::string & value)
 
 int NFCRecord::FindObject(const int nCol, const NFGUID & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindObject(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
+	{
+		return -1;
+	}
+
+	if (TDATA_OBJECT != mVarRecordType->Type(nCol))
+	{
+		return -1;
+	}
+
+	if (IsIndexed(nCol))
 	{
-		return (int) xDataList.Int(0);
+		const std::vector<int>* pRows = FindIndex(nCol, value);
+		return pRows ? pRows->front() : -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetCell<NFGUID>(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1179,11 +1489,22 @@ int NFCRecord::FindObject(const int nCol, const NFGUID & value)
 
 int NFCRecord::FindVector2(const int nCol, const NFVector2 & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindVector2(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
+	{
+		return -1;
+	}
+
+	if (TDATA_VECTOR2 != mVarRecordType->Type(nCol))
 	{
-		return (int) xDataList.Int(0);
+		return -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetCell<NFVector2>(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1191,11 +1512,22 @@ int NFCRecord::FindVector2(const int nCol, const NFVector2 & value)
 
 int NFCRecord::FindVector3(const int nCol, const NFVector3 & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindVector3(nCol, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
+	if (!ValidCol(nCol))
 	{
-		return (int) xDataList.Int(0);
+		return -1;
+	}
+
+	if (TDATA_VECTOR3 != mVarRecordType->Type(nCol))
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < mnMaxRow; ++i)
+	{
+		if (IsUsed(i) && GetCell<NFVector3>(i, nCol) == value)
+		{
+			return i;
+		}
 	}
 
 	return -1;
@@ -1214,86 +1546,37 @@ int NFCRecord::FindVector3(const std::string& strColTag, const NFVector3& value,
 
 int NFCRecord::FindRowByColValue(const std::string & strColTag, const NFData & var)
 {
-	NFDataList xDataList;
-	int nRowCount = FindRowByColValue(strColTag, var, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindRowByColValue(GetCol(strColTag), var);
 }
 
 int NFCRecord::FindInt(const std::string & strColTag, const NFINT64 value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindInt(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindInt(GetCol(strColTag), value);
 }
 
 int NFCRecord::FindFloat(const std::string & strColTag, const double value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindFloat(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindFloat(GetCol(strColTag), value);
 }
 
 int NFCRecord::FindString(const std::string & strColTag, const std::string & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindString(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindString(GetCol(strColTag), value);
 }
 
 int NFCRecord::FindObject(const std::string & strColTag, const NFGUID & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindObject(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindObject(GetCol(strColTag), value);
 }
 
 int NFCRecord::FindVector2(const std::string & strColTag, const NFVector2 & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindVector2(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindVector2(GetCol(strColTag), value);
 }
 
 int NFCRecord::FindVector3(const std::string & strColTag, const NFVector3 & value)
 {
-	NFDataList xDataList;
-	int nRowCount = FindVector3(strColTag, value, xDataList);
-	if (nRowCount > 0 && xDataList.GetCount() > 0)
-	{
-		return (int) xDataList.Int(0);
-	}
-
-	return -1;
+	return FindVector3(GetCol(strColTag), value);
 }
 
 bool NFCRecord::Remove(const int nRow)
@@ -1310,7 +1593,9 @@ bool NFCRecord::Remove(const int nRow)
 
 			OnEventHandler(mSelf, xEventData, NFData(), NFData());
 
+			RemoveRowIndex(nRow);
 			mVecUsedState[nRow] = 0;
+			SetDirty(nRow);
 
 			return true;
         }
@@ -1334,6 +1619,27 @@ void NFCRecord::AddRecordHook(const RECORD_EVENT_FUNCTOR_PTR& cb)
     mtRecordCallback.push_back(cb);
 }
 
+void NFCRecord::SetDirtySet(NFDirtySet* pDirtySet, const int nSlot)
+{
+    mpDirtySet = pDirtySet;
+    mnDirtySlot = nSlot;
+}
+
+int NFCRecord::GetDirtyRow(std::vector<int>& vRowList) const
+{
+    return mxDirtyRow.GetList(vRowList);
+}
+
+bool NFCRecord::IsDirty() const
+{
+    return mxDirtyRow.Any();
+}
+
+void NFCRecord::ClearDirty()
+{
+    mxDirtyRow.Clear();
+}
+
 const bool NFCRecord::GetSave()
 {
     return mbSave;
@@ -1369,11 +1675,6 @@ const bool NFCRecord::GetPrivate()
     return mbPrivate;
 }
 
-int NFCRecord::GetPos(int nRow, int nCol) const
-{
-    return nRow * mVarRecordType->GetCount() + nCol;
-}
-
 const std::string& NFCRecord::GetName() const
 {
     return mstrRecordName;
@@ -1459,17 +1760,24 @@ bool NFCRecord::SwapRowInfo(const int nOriginRow, const int nTargetRow)
     if (ValidRow(nOriginRow)
         && ValidRow(nTargetRow))
     {
-        for (int i = 0; i < GetCols(); ++i)
+        RemoveRowIndex(nOriginRow);
+        RemoveRowIndex(nTargetRow);
+
+        SwapRowCell(nOriginRow, nTargetRow);
+        for (int i = 0; i < mnStringCols; ++i)
         {
-            NF_SHARE_PTR<NFData> pOrigin = mtRecordVec.at(GetPos(nOriginRow, i));
-            mtRecordVec[GetPos(nOriginRow, i)] = mtRecordVec.at(GetPos(nTargetRow, i));
-            mtRecordVec[GetPos(nTargetRow, i)] = pOrigin;
+            mxStringCell[nOriginRow * mnStringCols + i].swap(mxStringCell[nTargetRow * mnStringCols + i]);
         }
 
         int nOriginUse = mVecUsedState[nOriginRow];
         mVecUsedState[nOriginRow] = mVecUsedState[nTargetRow];
         mVecUsedState[nTargetRow] = nOriginUse;
 
+        AddRowIndex(nOriginRow);
+        AddRowIndex(nTargetRow);
+        SetDirty(nOriginRow);
+        SetDirty(nTargetRow);
+
         RECORD_EVENT_DATA xEventData;
         xEventData.nOpType = RECORD_EVENT_DATA::Swap;
         xEventData.nRow = nOriginRow;
@@ -1492,16 +1800,38 @@ const NF_SHARE_PTR<NFDataList> NFCRecord::GetTag() const
     return pIniData;
 }
 
-const NFIRecord::TRECORDVEC& NFCRecord::GetRecordVec() const
-{
-    return mtRecordVec;
-}
-
 bool NFCRecord::SetUsed(const int nRow, const int bUse)
 {
     if (ValidRow(nRow))
     {
+        if (bUse <= 0)
+        {
+            RemoveRowIndex(nRow);
+        }
+
+        const bool bUsed = IsUsed(nRow);
+        if (!bUsed && bUse > 0)
+        {
+            //a row coming back must not repeat a unique key
+            for (int i = 0; i < (int)mxColIndex.size(); ++i)
+            {
+                NFData xData;
+                GetCellData(nRow, i, xData);
+                if (!CheckIndex(nRow, i, xData))
+                {
+                    return false;
+                }
+            }
+        }
+
         mVecUsedState[nRow] = bUse;
+        SetDirty(nRow);
+
+        if (!bUsed && bUse > 0)
+        {
+            AddRowIndex(nRow);
+        }
+
         return true;
     }
 
@@ -1515,16 +1845,16 @@ bool NFCRecord::PreAllocMemoryForRow(const int nRow)
 		return false;
 	}
 
+	RemoveRowIndex(nRow);
+
+	//the cells are always there, the row is reset to the init data
 	for (int i = 0; i < GetCols(); ++i)
 	{
-		NF_SHARE_PTR<NFData>& pVar = mtRecordVec.at(GetPos(nRow, i));
-		if (nullptr == pVar)
-		{
-			pVar = NF_SHARE_PTR<NFData>(NF_NEW NFData(mVarRecordType->Type(i)));
-		}
-
-		pVar->variantData = mVarRecordType->GetStack(i)->variantData;
+		SetCellData(nRow, i, *mVarRecordType, i);
 	}
+
+	AddRowIndex(nRow);
+	SetDirty(nRow);
 	return true;
 }
 
@@ -1561,11 +1891,201 @@ bool NFCRecord::ValidCol(int nCol) const
 
 int NFCRecord::GetCol(const std::string& strTag) const
 {
-    std::map<std::string, int>::const_iterator it = mmTag.find(strTag);
-    if (it != mmTag.end())
+    if (!mmTag)
+    {
+        return -1;
+    }
+
+    std::map<std::string, int>::const_iterator it = mmTag->find(strTag);
+    if (it != mmTag->end())
     {
         return it->second;
     }
 
     return -1;
 }
+
+bool NFCRecord::IsIndexed(const int nCol) const
+{
+    return nCol >= 0 && nCol < (int)mxColIndex.size() && NF_RECORD_INDEX_NONE != mxColIndex[nCol].eIndex;
+}
+
+bool NFCRecord::CheckIndex(const int nRow, const int nCol, const NFData& var) const
+{
+    if (!IsIndexed(nCol) || NF_RECORD_INDEX_UNIQUE != mxColIndex[nCol].eIndex || var.IsNullValue())
+    {
+        return true;
+    }
+
+    const std::vector<int>* pRows = NULL;
+    switch (var.GetType())
+    {
+        case TDATA_INT:
+            pRows = FindIndex(nCol, var.GetInt());
+            break;
+        case TDATA_STRING:
+            pRows = FindIndex(nCol, var.GetString());
+            break;
+        case TDATA_OBJECT:
+            pRows = FindIndex(nCol, var.GetObject());
+            break;
+        default:
+            break;
+    }
+
+    return NULL == pRows || (pRows->size() == 1 && pRows->front() == nRow);
+}
+
+void NFCRecord::AddIndex(const int nRow, const int nCol)
+{
+    if (!IsIndexed(nCol) || !IsUsed(nRow))
+    {
+        return;
+    }
+
+    ColIndex& xColIndex = mxColIndex[nCol];
+    switch (GetColType(nCol))
+    {
+        case TDATA_INT:
+            InsertIndexRow(xColIndex.xIntIndex, GetInt(nRow, nCol), nRow);
+            break;
+        case TDATA_STRING:
+            InsertIndexRow(xColIndex.xStringIndex, GetString(nRow, nCol), nRow);
+            break;
+        case TDATA_OBJECT:
+            InsertIndexRow(xColIndex.xObjectIndex, GetObject(nRow, nCol), nRow);
+            break;
+        default:
+            break;
+    }
+}
+
+void NFCRecord::RemoveIndex(const int nRow, const int nCol)
+{
+    if (!IsIndexed(nCol) || !IsUsed(nRow))
+    {
+        return;
+    }
+
+    ColIndex& xColIndex = mxColIndex[nCol];
+    switch (GetColType(nCol))
+    {
+        case TDATA_INT:
+            EraseIndexRow(xColIndex.xIntIndex, GetInt(nRow, nCol), nRow);
+            break;
+        case TDATA_STRING:
+            EraseIndexRow(xColIndex.xStringIndex, GetString(nRow, nCol), nRow);
+            break;
+        case TDATA_OBJECT:
+            EraseIndexRow(xColIndex.xObjectIndex, GetObject(nRow, nCol), nRow);
+            break;
+        default:
+            break;
+    }
+}
+
+void NFCRecord::AddRowIndex(const int nRow)
+{
+    for (int i = 0; i < (int)mxColIndex.size(); ++i)
+    {
+        AddIndex(nRow, i);
+    }
+}
+
+void NFCRecord::RemoveRowIndex(const int nRow)
+{
+    for (int i = 0; i < (int)mxColIndex.size(); ++i)
+    {
+        RemoveIndex(nRow, i);
+    }
+}
+
+const std::vector<int>* NFCRecord::FindIndex(const int nCol, const NFINT64 value) const
+{
+    const std::unordered_map<NFINT64, std::vector<int>>& xIndex = mxColIndex[nCol].xIntIndex;
+    std::unordered_map<NFINT64, std::vector<int>>::const_iterator it = xIndex.find(value);
+    if (it != xIndex.end())
+    {
+        return &it->second;
+    }
+
+    return NULL;
+}
+
+const std::vector<int>* NFCRecord::FindIndex(const int nCol, const std::string& value) const
+{
+    const std::unordered_map<std::string, std::vector<int>>& xIndex = mxColIndex[nCol].xStringIndex;
+    std::unordered_map<std::string, std::vector<int>>::const_iterator it = xIndex.find(value);
+    if (it != xIndex.end())
+    {
+        return &it->second;
+    }
+
+    return NULL;
+}
+
+const std::vector<int>* NFCRecord::FindIndex(const int nCol, const NFGUID& value) const
+{
+    const std::unordered_map<NFGUID, std::vector<int>>& xIndex = mxColIndex[nCol].xObjectIndex;
+    std::unordered_map<NFGUID, std::vector<int>>::const_iterator it = xIndex.find(value);
+    if (it != xIndex.end())
+    {
+        return &it->second;
+    }
+
+    return NULL;
+}
+
+void NFCRecord::GetCellData(const int nRow, const int nCol, NFData& var) const
+{
+    switch (mxColLayout[nCol].eType)
+    {
+        case TDATA_INT:
+            var.SetInt(GetCell<NFINT64>(nRow, nCol));
+            break;
+        case TDATA_FLOAT:
+            var.SetFloat(GetCell<double>(nRow, nCol));
+            break;
+        case TDATA_STRING:
+            var.SetString(GetStringCell(nRow, nCol));
+            break;
+        case TDATA_OBJECT:
+            var.SetObject(GetCell<NFGUID>(nRow, nCol));
+            break;
+        case TDATA_VECTOR2:
+            var.SetVector2(GetCell<NFVector2>(nRow, nCol));
+            break;
+        case TDATA_VECTOR3:
+            var.SetVector3(GetCell<NFVector3>(nRow, nCol));
+            break;
+        default:
+            break;
+    }
+}
+
+void NFCRecord::SetCellData(const int nRow, const int nCol, const NFDataList& var, const int nIndex)
+{
+    switch (mxColLayout[nCol].eType)
+    {
+        case TDATA_INT:
+            GetCell<NFINT64>(nRow, nCol) = var.Int(nIndex);
+            break;
+        case TDATA_FLOAT:
+            GetCell<double>(nRow, nCol) = var.Float(nIndex);
+            break;
+        case TDATA_STRING:
+            GetStringCell(nRow, nCol) = var.String(nIndex);
+            break;
+        case TDATA_OBJECT:
+            GetCell<NFGUID>(nRow, nCol) = var.Object(nIndex);
+            break;
+        case TDATA_VECTOR2:
+            GetCell<NFVector2>(nRow, nCol) = var.Vector2(nIndex);
+            break;
+        case TDATA_VECTOR3:
+            GetCell<NFVector3>(nRow, nCol) = var.Vector3(nIndex);
+            break;
+        default:
+            break;
+    }
+}
@@ -10,6 +10,7 @@
 #define NFC_RECORD_H
 
 #include <vector>
+#include <unordered_map>
 #include "NFIRecord.h"
 #include "NFDataList.hpp"
 #include "NFMapEx.hpp"
@@ -20,6 +21,8 @@ class _NFExport NFCRecord : public NFIRecord
 public:
     NFCRecord();
     NFCRecord(const NFGUID& self, const std::string& strRecordName, const NF_SHARE_PTR<NFDataList>& valueList, const NF_SHARE_PTR<NFDataList>& tagList, const int nMaxRow);
+    //a copy of the class record for the object self, the types, tags and tag map are shared with it
+    NFCRecord(const NFGUID& self, const NFCRecord& xPrototype);
 
     virtual ~NFCRecord();
 
@@ -36,6 +39,9 @@ public:
     virtual NFDATA_TYPE GetColType(const int nCol) const;
     virtual const std::string& GetColTag(const int nCol) const;
 
+    virtual bool SetIndex(const int nCol, const NF_RECORD_INDEX eIndex);
+    virtual NF_RECORD_INDEX GetIndex(const int nCol) const;
+
     
     virtual int AddRow(const int nRow);
 
@@ -113,6 +119,11 @@ public:
 
     virtual void AddRecordHook(const RECORD_EVENT_FUNCTOR_PTR& cb);
 
+    virtual void SetDirtySet(NFDirtySet* pDirtySet, const int nSlot);
+    virtual int GetDirtyRow(std::vector<int>& vRowList) const;
+    virtual bool IsDirty() const;
+    virtual void ClearDirty();
+
     virtual const bool GetSave();
 
     virtual const bool GetCache();
@@ -148,9 +159,53 @@ public:
     virtual const NF_SHARE_PTR<NFDataList> GetInitData() const;
     virtual const NF_SHARE_PTR<NFDataList> GetTag() const;
 
-    virtual const TRECORDVEC& GetRecordVec() const;
 protected:
-    int GetPos(int nRow, int nCol) const;
+    enum
+    {
+        //int, float and vector2 take one unit, object and vector3 two
+        CELL_UNIT_SIZE = sizeof(NFINT64),
+    };
+
+    unsigned char* GetCellBuff(const int nRow, const int nCol)
+    {
+        return &mxCellData[(nRow * mnRowWidth + mxColLayout[nCol].nOffset) * CELL_UNIT_SIZE];
+    }
+
+    const unsigned char* GetCellBuff(const int nRow, const int nCol) const
+    {
+        return &mxCellData[(nRow * mnRowWidth + mxColLayout[nCol].nOffset) * CELL_UNIT_SIZE];
+    }
+
+    //the cell is an object of its col type constructed in the buffer by InitRowCell, T must be that type
+    template<typename T>
+    T& GetCell(const int nRow, const int nCol)
+    {
+        return *reinterpret_cast<T*>(GetCellBuff(nRow, nCol));
+    }
+
+    template<typename T>
+    const T& GetCell(const int nRow, const int nCol) const
+    {
+        return *reinterpret_cast<const T*>(GetCellBuff(nRow, nCol));
+    }
+
+    //construct the cells of a row in the buffer, as copies of the same row of pFrom if it is given
+    void InitRowCell(const int nRow, const NFCRecord* pFrom);
+    void SwapRowCell(const int nOriginRow, const int nTargetRow);
+
+    std::string& GetStringCell(const int nRow, const int nCol)
+    {
+        return mxStringCell[nRow * mnStringCols + mxColLayout[nCol].nOffset];
+    }
+
+    const std::string& GetStringCell(const int nRow, const int nCol) const
+    {
+        return mxStringCell[nRow * mnStringCols + mxColLayout[nCol].nOffset];
+    }
+
+    //copy the cell to/from a NFData or the index of a NFDataList, the types must match
+    void GetCellData(const int nRow, const int nCol, NFData& var) const;
+    void SetCellData(const int nRow, const int nCol, const NFDataList& var, const int nIndex);
 
     int GetCol(const std::string& strTag) const;
 
@@ -160,16 +215,75 @@ protected:
 
     void OnEventHandler(const NFGUID& self, const RECORD_EVENT_DATA& xEventData, const NFData& oldVar, const NFData& newVar);
 
+    void SetDirty(const int nRow)
+    {
+        mxDirtyRow.Set(nRow);
+        if (mpDirtySet)
+        {
+            mpDirtySet->Set(mnDirtySlot);
+        }
+    }
+
+    bool IsIndexed(const int nCol) const;
+    //false if the unique index already has the value in another row
+    bool CheckIndex(const int nRow, const int nCol, const NFData& var) const;
+    //the current value of the cell is added to/removed from the index of the col
+    void AddIndex(const int nRow, const int nCol);
+    void RemoveIndex(const int nRow, const int nCol);
+    void AddRowIndex(const int nRow);
+    void RemoveRowIndex(const int nRow);
+    //the used rows having the value in ascending order, NULL if none
+    const std::vector<int>* FindIndex(const int nCol, const NFINT64 value) const;
+    const std::vector<int>* FindIndex(const int nCol, const std::string& value) const;
+    const std::vector<int>* FindIndex(const int nCol, const NFGUID& value) const;
+
 protected:
     
 	NF_SHARE_PTR<NFDataList> mVarRecordType;
 	NF_SHARE_PTR<NFDataList> mVarRecordTag;
 
-    std::map<std::string, int> mmTag;
+    //tag -> col, never changed after the constructor so the copies share it
+    NF_SHARE_PTR<std::map<std::string, int>> mmTag;
+
+    struct ColIndex
+    {
+        ColIndex()
+        {
+            eIndex = NF_RECORD_INDEX_NONE;
+        }
+
+        NF_RECORD_INDEX eIndex;
+        std::unordered_map<NFINT64, std::vector<int>> xIntIndex;
+        std::unordered_map<std::string, std::vector<int>> xStringIndex;
+        std::unordered_map<NFGUID, std::vector<int>> xObjectIndex;
+    };
+
+    //empty if no col has index
+    std::vector<ColIndex> mxColIndex;
 
 	////////////////////////////
-	
-	TRECORDVEC mtRecordVec;
+
+    struct ColLayout
+    {
+        ColLayout()
+        {
+            eType = TDATA_UNKNOWN;
+            nOffset = 0;
+        }
+
+        NFDATA_TYPE eType;
+        //in CELL_UNIT_SIZE units inside a row of mxCellData, or the index inside a row of mxStringCell
+        int nOffset;
+    };
+
+    std::vector<ColLayout> mxColLayout;
+    int mnRowWidth;
+    int mnStringCols;
+
+    //all the rows in one byte buffer, it comes from operator new so it is aligned for every cell type
+    std::vector<unsigned char> mxCellData;
+    //the strings keep short values inline, so a config id does not allocate
+    std::vector<std::string> mxStringCell;
 	std::vector<int> mVecUsedState;
     int mnMaxRow;
 
@@ -185,6 +299,10 @@ protected:
 
     typedef std::vector<RECORD_EVENT_FUNCTOR_PTR> TRECORDCALLBACKEX;
     TRECORDCALLBACKEX mtRecordCallback;
+
+    NFDirtySet mxDirtyRow;
+    NFDirtySet* mpDirtySet;
+    int mnDirtySlot;
 };
 
 #endif
@@ -10,6 +10,14 @@
 
 NFCRecordManager::~NFCRecordManager()
 {
+    for (int i = 0; i < (int)mxRecordSlot.size(); ++i)
+    {
+        if (mxRecordSlot[i])
+        {
+            mxRecordSlot[i]->SetDirtySet(NULL, -1);
+        }
+    }
+
     ClearAll();
 }
 
@@ -295,3 +303,122 @@ const NFVector3& NFCRecordManager::GetRecordVector3(const std::string& strRecord
 
 	return NULL_VECTOR3;
 }
+
+bool NFCRecordManager::SetRecordSlot(const int nSlot, NF_SHARE_PTR<NFIRecord> pRecord)
+{
+    if (nSlot < 0 || !pRecord)
+    {
+        return false;
+    }
+
+    if (nSlot >= (int)mxRecordSlot.size())
+    {
+        mxRecordSlot.resize(nSlot + 1);
+    }
+
+    if (!mxRecordIndexMap)
+    {
+        mxRecordIndexMap = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>());
+    }
+    else if (mxRecordIndexMap.use_count() > 1)
+    {
+        mxRecordIndexMap = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>(*mxRecordIndexMap));
+    }
+
+    mxRecordSlot[nSlot] = pRecord;
+    (*mxRecordIndexMap)[pRecord->GetName()] = nSlot;
+    pRecord->SetDirtySet(&mxDirtySet, nSlot);
+
+    return true;
+}
+
+int NFCRecordManager::GetRecordSlot(const std::string& strRecordName)
+{
+    if (!mxRecordIndexMap)
+    {
+        return -1;
+    }
+
+    std::map<std::string, int>::iterator it = mxRecordIndexMap->find(strRecordName);
+    if (it != mxRecordIndexMap->end())
+    {
+        return it->second;
+    }
+
+    return -1;
+}
+
+int NFCRecordManager::GetRecordSlotCount()
+{
+    return (int)mxRecordSlot.size();
+}
+
+NF_SHARE_PTR<NFIRecord> NFCRecordManager::GetRecordBySlot(const int nSlot)
+{
+    if (nSlot >= 0 && nSlot < (int)mxRecordSlot.size())
+    {
+        return mxRecordSlot[nSlot];
+    }
+
+    return nullptr;
+}
+
+bool NFCRecordManager::CloneFrom(NF_SHARE_PTR<NFIRecordManager> pPrototype)
+{
+    NFCRecordManager* pClassManager = dynamic_cast<NFCRecordManager*>(pPrototype.get());
+    if (!pClassManager || Count() > 0)
+    {
+        return false;
+    }
+
+    mxRecordSlot.resize(pClassManager->mxRecordSlot.size());
+    for (int i = 0; i < (int)mxRecordSlot.size(); ++i)
+    {
+        NFCRecord* pClassRecord = dynamic_cast<NFCRecord*>(pClassManager->mxRecordSlot[i].get());
+        if (!pClassRecord)
+        {
+            continue;
+        }
+
+        NF_SHARE_PTR<NFIRecord> pRecord(NF_NEW NFCRecord(mSelf, *pClassRecord));
+        pRecord->SetDirtySet(&mxDirtySet, i);
+
+        mxRecordSlot[i] = pRecord;
+        AddElement(pRecord->GetName(), pRecord);
+    }
+
+    mxRecordIndexMap = pClassManager->mxRecordIndexMap;
+
+    return true;
+}
+
+int NFCRecordManager::GetDirtySlot(std::vector<int>& vSlotList)
+{
+    return mxDirtySet.GetList(vSlotList);
+}
+
+bool NFCRecordManager::IsDirty(const int nSlot)
+{
+    return mxDirtySet.Test(nSlot);
+}
+
+void NFCRecordManager::ClearDirty()
+{
+    std::vector<int> vSlotList;
+    mxDirtySet.GetList(vSlotList);
+    for (size_t i = 0; i < vSlotList.size(); ++i)
+    {
+        ClearDirty(vSlotList[i]);
+    }
+}
+
+void NFCRecordManager::ClearDirty(const int nSlot)
+{
+    NF_SHARE_PTR<NFIRecord> pRecord = GetRecordBySlot(nSlot);
+    if (pRecord)
+    {
+        pRecord->ClearDirty();
+    }
+
+    mxDirtySet.Reset(nSlot);
+}
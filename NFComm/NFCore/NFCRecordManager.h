@@ -61,8 +61,25 @@ public:
 	virtual const NFVector2& GetRecordVector2(const std::string& strRecordName, const int nRow, const std::string& strColTag);
 	virtual const NFVector3& GetRecordVector3(const std::string& strRecordName, const int nRow, const std::string& strColTag);
     //////////////////////////////////////////////////////////////////////////
+
+    virtual bool SetRecordSlot(const int nSlot, NF_SHARE_PTR<NFIRecord> pRecord);
+    virtual int GetRecordSlot(const std::string& strRecordName);
+    virtual int GetRecordSlotCount();
+    virtual NF_SHARE_PTR<NFIRecord> GetRecordBySlot(const int nSlot);
+    virtual bool CloneFrom(NF_SHARE_PTR<NFIRecordManager> pPrototype);
+
+    virtual int GetDirtySlot(std::vector<int>& vSlotList);
+    virtual bool IsDirty(const int nSlot);
+    virtual void ClearDirty();
+    virtual void ClearDirty(const int nSlot);
+
 private:
     NFGUID mSelf;
+    //record name -> slot
+    //shared with the class manager until a slot is set here
+    NF_SHARE_PTR<std::map<std::string, int>> mxRecordIndexMap;
+    std::vector<NF_SHARE_PTR<NFIRecord>> mxRecordSlot;
+    NFDirtySet mxDirtySet;
 
 };
 
@@ -81,6 +81,26 @@ public:
 		variantData = value.variantData;
 	}
 
+	NFData(NFData&& value)
+	{
+		nType = value.nType;
+		variantData = std::move(value.variantData);
+	}
+
+	NFData& operator=(const NFData& value)
+	{
+		nType = value.nType;
+		variantData = value.variantData;
+		return *this;
+	}
+
+	NFData& operator=(NFData&& value)
+	{
+		nType = value.nType;
+		variantData = std::move(value.variantData);
+		return *this;
+	}
+
 	~NFData()
 	{
 		nType = TDATA_UNKNOWN;
@@ -501,17 +521,57 @@ public:
 	mapbox::util::variant<NFINT64, double, std::string, NFGUID, NFVector2, NFVector3> variantData;
 };
 
+//the first STACK_SIZE elements are stored inside the list, only the ones after them go to the heap
 class NFDataList :public NFMemoryCounter<NFDataList>
 {
 public:
     NFDataList() : NFMemoryCounter(GET_CLASS_NAME(NFDataList))
     {
         mnUseSize = 0;
-        mvList.reserve(STACK_SIZE);
-        for (int i = 0; i < STACK_SIZE; ++i)
+    }
+
+    NFDataList(const NFDataList& src) : NFMemoryCounter(GET_CLASS_NAME(NFDataList))
+    {
+        mnUseSize = 0;
+        InnerAppendEx(src, 0, src.GetCount());
+    }
+
+    NFDataList(NFDataList&& src) : NFMemoryCounter(GET_CLASS_NAME(NFDataList))
+    {
+        mnUseSize = 0;
+        *this = std::move(src);
+    }
+
+    NFDataList& operator=(const NFDataList& src)
+    {
+        if (this != &src)
         {
-            mvList.push_back(NF_SHARE_PTR<NFData>(NF_NEW NFData()));
+            Clear();
+            InnerAppendEx(src, 0, src.GetCount());
         }
+
+        return *this;
+    }
+
+    NFDataList& operator=(NFDataList&& src)
+    {
+        if (this != &src)
+        {
+            const int nStackCount = src.mnUseSize < STACK_SIZE ? src.mnUseSize : STACK_SIZE;
+            for (int i = 0; i < nStackCount; ++i)
+            {
+                mxStack[i] = std::move(src.mxStack[i]);
+                src.mxStack[i].Reset();
+            }
+
+            mxHeap.swap(src.mxHeap);
+            src.mxHeap.clear();
+
+            mnUseSize = src.mnUseSize;
+            src.mnUseSize = 0;
+        }
+
+        return *this;
     }
 
 	virtual ~NFDataList()
@@ -582,14 +642,14 @@ public:
 
 public:
 
-	virtual const NF_SHARE_PTR<NFData> GetStack(const int index) const
+	virtual const NFData* GetStack(const int index) const
 	{
-		if (index < (int)mvList.size())
+		if (ValidIndex(index))
 		{
-			return mvList[index];
+			return &GetData(index);
 		}
 
-		return NF_SHARE_PTR<NFData>();
+		return NULL;
 	}
 
 	virtual bool Concat(const NFDataList& src)
@@ -660,15 +720,7 @@ public:
 	virtual void Clear()
 	{
 		mnUseSize = 0;
-
-		if (mvList.size() > STACK_SIZE)
-		{
-			mvList.erase(mvList.begin() + STACK_SIZE, mvList.end());
-		}
-		for (int i = 0; i < STACK_SIZE; ++i)
-		{
-			mvList[i]->Reset();
-		}
+		mxHeap.clear();
 	}
     
 	virtual bool IsEmpty() const
@@ -688,20 +740,7 @@ public:
 			return TDATA_UNKNOWN;
 		}
 
-		if (index < STACK_SIZE)
-		{
-			return mvList[index]->GetType();
-		}
-		else
-		{
-			const NF_SHARE_PTR<NFData> pData = GetStack(index);
-			if (pData)
-			{
-				return pData->GetType();
-			}
-		}
-
-		return TDATA_UNKNOWN;
+		return GetData(index).GetType();
 	}
     
 	virtual bool TypeEx(const  int nType, ...) const
@@ -773,129 +812,53 @@ public:
     
 	virtual bool Add(const NFINT64 value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
+		AddData().SetInt(value);
 
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetInt(value);
-			mnUseSize++;
-
-			return true;
-		}
-
-		return false;
+		return true;
 	}
 
 	virtual bool Add(const double value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
-
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetFloat(value);
-			mnUseSize++;
+		AddData().SetFloat(value);
 
-			return true;
-		}
-
-		return false;
+		return true;
 	}
 
 	virtual bool Add(const std::string& value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
-
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetString(value);
-			mnUseSize++;
+		AddData().SetString(value);
 
-			return true;
-		}
-
-		return false;
+		return true;
 	}
 
 	virtual bool Add(const NFGUID& value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
-
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetObject(value);
-			mnUseSize++;
-
-			return true;
-		}
+		AddData().SetObject(value);
 
-		return false;
+		return true;
 	}
 
 	virtual bool Add(const NFVector2& value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
-
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetVector2(value);
-			mnUseSize++;
-
-			return true;
-		}
+		AddData().SetVector2(value);
 
-		return false;
+		return true;
 	}
 
 	virtual bool Add(const NFVector3& value)
 	{
-		if (GetCount() == (int)(mvList.size()))
-		{
-			AddStatck();
-		}
-
-		NF_SHARE_PTR<NFData> var = GetStack(GetCount());
-		if (var)
-		{
-			var->SetVector3(value);
-			mnUseSize++;
-
-			return true;
-		}
+		AddData().SetVector3(value);
 
-		return false;
+		return true;
 	}
 
 	virtual bool Set(const int index, const NFINT64 value)
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_INT)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetInt(value);
+			GetData(index).SetInt(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -905,13 +868,9 @@ public:
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_FLOAT)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetFloat(value);
+			GetData(index).SetFloat(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -921,13 +880,9 @@ public:
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_STRING)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetString(value);
+			GetData(index).SetString(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -937,13 +892,9 @@ public:
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_OBJECT)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetObject(value);
+			GetData(index).SetObject(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -953,13 +904,9 @@ public:
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_VECTOR2)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetVector2(value);
+			GetData(index).SetVector2(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -969,13 +916,9 @@ public:
 	{
 		if (ValidIndex(index) && Type(index) == TDATA_VECTOR3)
 		{
-			NF_SHARE_PTR<NFData> var = GetStack(index);
-			if (var)
-			{
-				var->SetVector3(value);
+			GetData(index).SetVector3(value);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -986,10 +929,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			if (Type(index) == TDATA_INT)
+			const NFData& var = GetData(index);
+			if (TDATA_INT == var.GetType())
 			{
-				const NF_SHARE_PTR<NFData> var = GetStack(index);
-				return var->GetInt();
+				return var.GetInt();
 			}
 		}
 
@@ -1005,10 +948,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			const NF_SHARE_PTR<NFData> var = mvList[index];
-			if (var && TDATA_FLOAT == var->GetType())
+			const NFData& var = GetData(index);
+			if (TDATA_FLOAT == var.GetType())
 			{
-				return var->GetFloat();
+				return var.GetFloat();
 			}
 		}
 
@@ -1019,10 +962,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			const NF_SHARE_PTR<NFData> var = mvList[index];
-			if (var && TDATA_STRING == var->GetType())
+			const NFData& var = GetData(index);
+			if (TDATA_STRING == var.GetType())
 			{
-				return var->GetString();
+				return var.GetString();
 			}
 		}
 
@@ -1033,14 +976,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			NFDATA_TYPE type = Type(index);
-			if (TDATA_OBJECT == type)
+			const NFData& var = GetData(index);
+			if (TDATA_OBJECT == var.GetType())
 			{
-				NF_SHARE_PTR<NFData> var = GetStack(index);
-				if (var)
-				{
-					return var->GetObject();
-				}
+				return var.GetObject();
 			}
 		}
 
@@ -1051,14 +990,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			NFDATA_TYPE type = Type(index);
-			if (TDATA_VECTOR2 == type)
+			const NFData& var = GetData(index);
+			if (TDATA_VECTOR2 == var.GetType())
 			{
-				NF_SHARE_PTR<NFData> var = GetStack(index);
-				if (var)
-				{
-					return var->GetVector2();
-				}
+				return var.GetVector2();
 			}
 		}
 
@@ -1069,14 +1004,10 @@ public:
 	{
 		if (ValidIndex(index))
 		{
-			NFDATA_TYPE type = Type(index);
-			if (TDATA_VECTOR3 == type)
+			const NFData& var = GetData(index);
+			if (TDATA_VECTOR3 == var.GetType())
 			{
-				NF_SHARE_PTR<NFData> var = GetStack(index);
-				if (var)
-				{
-					return var->GetVector3();
-				}
+				return var.GetVector3();
 			}
 		}
 
@@ -1258,13 +1189,29 @@ protected:
 		return (index < GetCount()) && (index >= 0);
 	}
 
-	void AddStatck()
+	NFData& GetData(const int index)
+	{
+		return index < STACK_SIZE ? mxStack[index] : mxHeap[index - STACK_SIZE];
+	}
+
+	const NFData& GetData(const int index) const
 	{
-		for (int i = 0; i < STACK_SIZE; ++i)
+		return index < STACK_SIZE ? mxStack[index] : mxHeap[index - STACK_SIZE];
+	}
+
+	//a new element without any type
+	NFData& AddData()
+	{
+		if (mnUseSize < STACK_SIZE)
 		{
-			NF_SHARE_PTR<NFData> pData(NF_NEW  NFData());
-			mvList.push_back(pData);
+			NFData& var = mxStack[mnUseSize++];
+			var.Reset();
+			return var;
 		}
+
+		mxHeap.push_back(NFData());
+		mnUseSize++;
+		return mxHeap.back();
 	}
 
 	void InnerAppendEx(const NFDataList& src, const int start, const int end)
@@ -1300,8 +1247,8 @@ protected:
 protected:
 
     int mnUseSize;
-    std::vector< NF_SHARE_PTR<NFData> > mvList;
-    std::map<std::string, NF_SHARE_PTR<NFData> > mxMap;
+    NFData mxStack[STACK_SIZE];
+    std::vector<NFData> mxHeap;
 };
 
 const static NFData NULL_TDATA = NFData();
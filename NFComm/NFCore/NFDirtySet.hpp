@@ -0,0 +1,102 @@
+// -------------------------------------------------------------------------
+//    @FileName			:    NFDirtySet.hpp
+//    @Author			:    LvSheng.Huang
+//    @Date				:    2017-10-24
+//    @Module			:    NFDirtySet
+//
+// -------------------------------------------------------------------------
+
+#ifndef NF_DIRTY_SET_H
+#define NF_DIRTY_SET_H
+
+#include <vector>
+#include <algorithm>
+#include "NFComm/NFPluginModule/NFPlatform.h"
+
+//the slots or rows changed since the last Clear, one bit each
+class NFDirtySet
+{
+public:
+	NFDirtySet()
+	{
+	}
+
+	void Set(const int nIndex)
+	{
+		if (nIndex < 0)
+		{
+			return;
+		}
+
+		const int nWord = nIndex >> 6;
+		if (nWord >= (int)mxBits.size())
+		{
+			mxBits.resize(nWord + 1, 0);
+		}
+
+		mxBits[nWord] |= ((NFUINT64)1 << (nIndex & 63));
+	}
+
+	void Reset(const int nIndex)
+	{
+		const int nWord = nIndex >> 6;
+		if (nIndex >= 0 && nWord < (int)mxBits.size())
+		{
+			mxBits[nWord] &= ~((NFUINT64)1 << (nIndex & 63));
+		}
+	}
+
+	bool Test(const int nIndex) const
+	{
+		const int nWord = nIndex >> 6;
+		if (nIndex >= 0 && nWord < (int)mxBits.size())
+		{
+			return (mxBits[nWord] & ((NFUINT64)1 << (nIndex & 63))) != 0;
+		}
+
+		return false;
+	}
+
+	bool Any() const
+	{
+		for (int i = 0; i < (int)mxBits.size(); ++i)
+		{
+			if (mxBits[i] != 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Clear()
+	{
+		std::fill(mxBits.begin(), mxBits.end(), 0);
+	}
+
+	//appends the set indexes in order, returns how many
+	int GetList(std::vector<int>& vList) const
+	{
+		int nCount = 0;
+		for (int i = 0; i < (int)mxBits.size(); ++i)
+		{
+			NFUINT64 nBits = mxBits[i];
+			for (int nBit = 0; nBits != 0; ++nBit, nBits >>= 1)
+			{
+				if (nBits & 1)
+				{
+					vList.push_back((i << 6) + nBit);
+					nCount++;
+				}
+			}
+		}
+
+		return nCount;
+	}
+
+private:
+	std::vector<NFUINT64> mxBits;
+};
+
+#endif
@@ -0,0 +1,508 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFHashMapEx.hpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFHashMapEx
+//
+// -------------------------------------------------------------------------
+
+#ifndef NF_HASH_MAPEX_H
+#define NF_HASH_MAPEX_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include "NFComm/NFPluginModule/NFPlatform.h"
+#include "NFComm/NFPluginModule/NFGUID.h"
+
+//same interface as NFMapEx, but an open addressing hash table over a dense element array
+//the elements are in no order, use range-for to iterate without the hidden cursor of First/Next
+//a handle is the index of an element plus the generation of that index, 0 is never valid
+//it can be kept anywhere and fails to resolve once the element is removed
+//the freed indexes are reused oldest first, and an index whose generation runs out is never reused
+//removing or adding while iterating is fine, but adding may move the entries
+//so copy what you need out of the entry of a range-for step before anything is added
+template <typename T, typename TD, typename THash = std::hash<T> >
+class NFHashMapEx
+{
+public:
+    enum
+    {
+        HANDLE_INDEX_BIT = 20,
+        HANDLE_INDEX_MASK = (1 << HANDLE_INDEX_BIT) - 1,
+        HANDLE_GENERATION_MASK = (1 << (32 - HANDLE_INDEX_BIT)) - 1,
+    };
+
+    struct Entry
+    {
+        T first;
+        NF_SHARE_PTR<TD> second;
+        size_t nHash;
+        NFUINT32 nGeneration;
+    };
+
+    class iterator
+    {
+    public:
+        iterator(std::vector<Entry>* pEntry, int nIndex) : mpEntry(pEntry), mnIndex(nIndex)
+        {
+            Skip();
+        }
+
+        Entry& operator*() const
+        {
+            return (*mpEntry)[mnIndex];
+        }
+
+        Entry* operator->() const
+        {
+            return &(*mpEntry)[mnIndex];
+        }
+
+        iterator& operator++()
+        {
+            ++mnIndex;
+            Skip();
+            return *this;
+        }
+
+        //end() keeps the size it was taken at, and elements added and removed while iterating
+        //can make Skip step past it, so any index at or past the other one is the end
+        bool operator==(const iterator& xOther) const
+        {
+            return !(*this != xOther);
+        }
+
+        bool operator!=(const iterator& xOther) const
+        {
+            return mnIndex < xOther.mnIndex;
+        }
+
+        NFUINT32 GetHandle() const
+        {
+            return MakeHandle(mnIndex, (*mpEntry)[mnIndex].nGeneration);
+        }
+
+    private:
+        void Skip()
+        {
+            while (mnIndex < (int)mpEntry->size() && (*mpEntry)[mnIndex].second == nullptr)
+            {
+                ++mnIndex;
+            }
+        }
+
+        std::vector<Entry>* mpEntry;
+        int mnIndex;
+    };
+
+    NFHashMapEx()
+    {
+        mnCount = 0;
+        mnCurIndex = 0;
+        mnBucketBit = 0;
+    };
+
+    virtual ~NFHashMapEx()
+    {
+    };
+
+    virtual bool ExistElement(const T& name)
+    {
+        return Find(name) >= 0;
+    }
+
+    virtual bool AddElement(const T& name, const NF_SHARE_PTR<TD> data)
+    {
+        if (data == nullptr)
+        {
+            return false;
+        }
+
+        const size_t nHash = mxHash(name);
+        if (Find(name, nHash) >= 0)
+        {
+            return false;
+        }
+
+        //keep the table at most half full
+        if ((mnCount + 1) * 2 > (int)mxBucket.size())
+        {
+            Rehash(mxBucket.empty() ? 16 : (int)mxBucket.size() * 2);
+        }
+
+        int nIndex = 0;
+        if (!mxFreeEntry.empty())
+        {
+            nIndex = mxFreeEntry.front();
+            mxFreeEntry.pop_front();
+        }
+        else
+        {
+            nIndex = (int)mxEntry.size();
+            mxEntry.push_back(Entry());
+            mxEntry.back().nGeneration = 1;
+        }
+
+        Entry& xEntry = mxEntry[nIndex];
+        xEntry.first = name;
+        xEntry.second = data;
+        xEntry.nHash = nHash;
+
+        InsertBucket(nIndex);
+        ++mnCount;
+
+        return true;
+    }
+
+    virtual bool RemoveElement(const T& name)
+    {
+        const size_t nHash = mxHash(name);
+        const int nBucket = FindBucket(name, nHash);
+        if (nBucket < 0)
+        {
+            return false;
+        }
+
+        const int nIndex = mxBucket[nBucket];
+        EraseBucket(nBucket);
+        FreeEntry(nIndex);
+        --mnCount;
+
+        return true;
+    }
+
+    virtual TD* GetElementNude(const T& name)
+    {
+        const int nIndex = Find(name);
+        if (nIndex >= 0)
+        {
+            return mxEntry[nIndex].second.get();
+        }
+
+        return NULL;
+    }
+
+    virtual NF_SHARE_PTR<TD> GetElement(const T& name)
+    {
+        const int nIndex = Find(name);
+        if (nIndex >= 0)
+        {
+            return mxEntry[nIndex].second;
+        }
+
+        return nullptr;
+    }
+
+    //0 if not found, or if the element is beyond the HANDLE_INDEX_BIT indexes a handle can hold
+    NFUINT32 GetHandle(const T& name)
+    {
+        const int nIndex = Find(name);
+        if (nIndex < 0 || nIndex > HANDLE_INDEX_MASK)
+        {
+            return 0;
+        }
+
+        return MakeHandle(nIndex, mxEntry[nIndex].nGeneration);
+    }
+
+    NF_SHARE_PTR<TD> GetElementByHandle(const NFUINT32 nHandle)
+    {
+        const int nIndex = FindHandle(nHandle);
+        if (nIndex >= 0)
+        {
+            return mxEntry[nIndex].second;
+        }
+
+        return nullptr;
+    }
+
+    TD* GetElementNudeByHandle(const NFUINT32 nHandle)
+    {
+        const int nIndex = FindHandle(nHandle);
+        if (nIndex >= 0)
+        {
+            return mxEntry[nIndex].second.get();
+        }
+
+        return NULL;
+    }
+
+    const T* GetKeyByHandle(const NFUINT32 nHandle)
+    {
+        const int nIndex = FindHandle(nHandle);
+        if (nIndex >= 0)
+        {
+            return &mxEntry[nIndex].first;
+        }
+
+        return NULL;
+    }
+
+    iterator begin()
+    {
+        return iterator(&mxEntry, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(&mxEntry, (int)mxEntry.size());
+    }
+
+    virtual TD* FirstNude(T& name)
+    {
+        mnCurIndex = 0;
+        return CurNude(&name);
+    }
+
+    virtual TD* NextNude(T& name)
+    {
+        ++mnCurIndex;
+        return CurNude(&name);
+    }
+
+    virtual TD* FirstNude()
+    {
+        mnCurIndex = 0;
+        return CurNude(NULL);
+    }
+
+    virtual TD* NextNude()
+    {
+        ++mnCurIndex;
+        return CurNude(NULL);
+    }
+
+    virtual NF_SHARE_PTR<TD> First()
+    {
+        mnCurIndex = 0;
+        return Cur(NULL);
+    }
+
+    virtual NF_SHARE_PTR<TD> Next()
+    {
+        ++mnCurIndex;
+        return Cur(NULL);
+    }
+
+    virtual NF_SHARE_PTR<TD> First(T& name)
+    {
+        mnCurIndex = 0;
+        return Cur(&name);
+    }
+
+    virtual NF_SHARE_PTR<TD> Next(T& name)
+    {
+        ++mnCurIndex;
+        return Cur(&name);
+    }
+
+    virtual bool ClearAll()
+    {
+        //the entries stay, so that the handles given out so far never resolve again
+        mxFreeEntry.clear();
+        for (int i = 0; i < (int)mxEntry.size(); ++i)
+        {
+            if (mxEntry[i].second != nullptr)
+            {
+                FreeEntry(i);
+            }
+            else if (mxEntry[i].nGeneration != 0)
+            {
+                mxFreeEntry.push_back(i);
+            }
+        }
+
+        mxBucket.assign(mxBucket.size(), -1);
+        mnCount = 0;
+        mnCurIndex = 0;
+        return true;
+    }
+
+    int Count()
+    {
+        return mnCount;
+    }
+
+protected:
+    static NFUINT32 MakeHandle(const int nIndex, const NFUINT32 nGeneration)
+    {
+        return (nGeneration << HANDLE_INDEX_BIT) | (NFUINT32)nIndex;
+    }
+
+    int FindHandle(const NFUINT32 nHandle) const
+    {
+        const int nIndex = (int)(nHandle & HANDLE_INDEX_MASK);
+        if (nHandle == 0 || nIndex >= (int)mxEntry.size())
+        {
+            return -1;
+        }
+
+        const Entry& xEntry = mxEntry[nIndex];
+        if (xEntry.second == nullptr || xEntry.nGeneration != (nHandle >> HANDLE_INDEX_BIT))
+        {
+            return -1;
+        }
+
+        return nIndex;
+    }
+
+    void FreeEntry(const int nIndex)
+    {
+        Entry& xEntry = mxEntry[nIndex];
+        xEntry.first = T();
+        xEntry.second.reset();
+        xEntry.nGeneration = (xEntry.nGeneration + 1) & HANDLE_GENERATION_MASK;
+        if (xEntry.nGeneration == 0)
+        {
+            //retired, a new generation 1 would let the old handles of this index resolve again
+            return;
+        }
+
+        mxFreeEntry.push_back(nIndex);
+    }
+
+    int Find(const T& name)
+    {
+        return Find(name, mxHash(name));
+    }
+
+    int Find(const T& name, const size_t nHash)
+    {
+        const int nBucket = FindBucket(name, nHash);
+        return nBucket >= 0 ? mxBucket[nBucket] : -1;
+    }
+
+    int FindBucket(const T& name, const size_t nHash)
+    {
+        if (mnCount <= 0)
+        {
+            return -1;
+        }
+
+        const int nMask = (int)mxBucket.size() - 1;
+        for (int i = HomeBucket(nHash); ; i = (i + 1) & nMask)
+        {
+            const int nIndex = mxBucket[i];
+            if (nIndex < 0)
+            {
+                return -1;
+            }
+
+            const Entry& xEntry = mxEntry[nIndex];
+            if (xEntry.nHash == nHash && xEntry.first == name)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    //fibonacci hashing, so that weak hashes like the identity of int still spread over the buckets
+    int HomeBucket(const size_t nHash) const
+    {
+        return (int)(((NFUINT64)nHash * 11400714819323198485ULL) >> (64 - mnBucketBit));
+    }
+
+    void InsertBucket(const int nIndex)
+    {
+        const int nMask = (int)mxBucket.size() - 1;
+        int i = HomeBucket(mxEntry[nIndex].nHash);
+        while (mxBucket[i] >= 0)
+        {
+            i = (i + 1) & nMask;
+        }
+
+        mxBucket[i] = nIndex;
+    }
+
+    //backward shift, no tombstones
+    void EraseBucket(int nBucket)
+    {
+        const int nMask = (int)mxBucket.size() - 1;
+        int j = nBucket;
+        while (true)
+        {
+            j = (j + 1) & nMask;
+            if (mxBucket[j] < 0)
+            {
+                break;
+            }
+
+            //move it back if its home is not in (nBucket, j]
+            const int nHome = HomeBucket(mxEntry[mxBucket[j]].nHash);
+            if (((j - nHome) & nMask) >= ((j - nBucket) & nMask))
+            {
+                mxBucket[nBucket] = mxBucket[j];
+                nBucket = j;
+            }
+        }
+
+        mxBucket[nBucket] = -1;
+    }
+
+    void Rehash(const int nSize)
+    {
+        mnBucketBit = 0;
+        while ((1 << mnBucketBit) < nSize)
+        {
+            ++mnBucketBit;
+        }
+
+        mxBucket.assign(1 << mnBucketBit, -1);
+        for (int i = 0; i < (int)mxEntry.size(); ++i)
+        {
+            if (mxEntry[i].second != nullptr)
+            {
+                InsertBucket(i);
+            }
+        }
+    }
+
+    TD* CurNude(T* pName)
+    {
+        const int nIndex = SkipCur(pName);
+        return nIndex >= 0 ? mxEntry[nIndex].second.get() : NULL;
+    }
+
+    NF_SHARE_PTR<TD> Cur(T* pName)
+    {
+        const int nIndex = SkipCur(pName);
+        return nIndex >= 0 ? mxEntry[nIndex].second : nullptr;
+    }
+
+    int SkipCur(T* pName)
+    {
+        while (mnCurIndex < (int)mxEntry.size())
+        {
+            const Entry& xEntry = mxEntry[mnCurIndex];
+            if (xEntry.second != nullptr)
+            {
+                if (pName)
+                {
+                    *pName = xEntry.first;
+                }
+
+                return mnCurIndex;
+            }
+
+            ++mnCurIndex;
+        }
+
+        return -1;
+    }
+
+protected:
+    std::vector<Entry> mxEntry;
+    std::deque<int> mxFreeEntry;
+    //entry index per bucket, -1 if empty
+    std::vector<int> mxBucket;
+    int mnBucketBit;
+    int mnCount;
+    int mnCurIndex;
+    THash mxHash;
+};
+
+#endif
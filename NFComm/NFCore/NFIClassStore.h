@@ -0,0 +1,43 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFIClassStore.h
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-20
+//    @Module           :    NFIClassStore
+//
+// -------------------------------------------------------------------------
+
+#ifndef NFI_CLASS_STORE_H
+#define NFI_CLASS_STORE_H
+
+#include "NFDataList.hpp"
+#include "NFComm/NFPluginModule/NFPlatform.h"
+
+//the int, float, object and vector properties of all the objects of one class, one contiguous column per property slot
+//every object is a row, the strings stay in the properties
+class _NFExport NFIClassStore
+{
+public:
+    virtual ~NFIClassStore() {}
+
+    virtual bool AddColumn(const int nSlot, const NFDATA_TYPE eType) = 0;
+    virtual bool HasColumn(const int nSlot) const = 0;
+
+    //-1 if failed, a removed row is zeroed and reused by the next object, the free rows at the end are dropped
+    virtual int AddRow(const NFGUID& self) = 0;
+    virtual bool RemoveRow(const NFGUID& self) = 0;
+    virtual int GetRow(const NFGUID& self) const = 0;
+
+    //rows in use and free ones, the free ones have a null object and zero values
+    virtual int GetRowCount() const = 0;
+    virtual const NFGUID* GetRowObject() const = 0;
+
+    //GetRowCount() elements, NULL if the slot has no column of that type
+    //AddRow and RemoveRow may move them, and writing them directly skips the property callbacks
+    virtual NFINT64* GetIntColumn(const int nSlot) = 0;
+    virtual double* GetFloatColumn(const int nSlot) = 0;
+    virtual NFGUID* GetObjectColumn(const int nSlot) = 0;
+    virtual NFVector2* GetVector2Column(const int nSlot) = 0;
+    virtual NFVector3* GetVector3Column(const int nSlot) = 0;
+};
+
+#endif
@@ -85,9 +85,25 @@ public:
 	virtual int GetPropertyInt32(const std::string& strPropertyName) = 0;
     virtual double GetPropertyFloat(const std::string& strPropertyName) = 0;
     virtual const std::string& GetPropertyString(const std::string& strPropertyName) = 0;
-    virtual const NFGUID& GetPropertyObject(const std::string& strPropertyName) = 0;
-	virtual const NFVector2& GetPropertyVector2(const std::string& strPropertyName) = 0;
-	virtual const NFVector3& GetPropertyVector3(const std::string& strPropertyName) = 0;
+    virtual NFGUID GetPropertyObject(const std::string& strPropertyName) = 0;
+	virtual NFVector2 GetPropertyVector2(const std::string& strPropertyName) = 0;
+	virtual NFVector3 GetPropertyVector3(const std::string& strPropertyName) = 0;
+
+    //slot versions, see NFIPropertyManager::SetPropertySlot
+    virtual bool SetPropertyInt(const int nSlot, const NFINT64 nValue) = 0;
+    virtual bool SetPropertyFloat(const int nSlot, const double dwValue) = 0;
+    virtual bool SetPropertyString(const int nSlot, const std::string& strValue) = 0;
+    virtual bool SetPropertyObject(const int nSlot, const NFGUID& obj) = 0;
+    virtual bool SetPropertyVector2(const int nSlot, const NFVector2& value) = 0;
+    virtual bool SetPropertyVector3(const int nSlot, const NFVector3& value) = 0;
+
+    virtual NFINT64 GetPropertyInt(const int nSlot) = 0;
+    virtual int GetPropertyInt32(const int nSlot) = 0;
+    virtual double GetPropertyFloat(const int nSlot) = 0;
+    virtual const std::string& GetPropertyString(const int nSlot) = 0;
+    virtual NFGUID GetPropertyObject(const int nSlot) = 0;
+    virtual NFVector2 GetPropertyVector2(const int nSlot) = 0;
+    virtual NFVector3 GetPropertyVector3(const int nSlot) = 0;
 
     virtual bool FindRecord(const std::string& strRecordName) = 0;
 
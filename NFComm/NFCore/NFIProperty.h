@@ -11,11 +11,31 @@
 
 #include "NFDataList.hpp"
 #include "NFList.hpp"
+#include "NFIClassStore.h"
+#include "NFDirtySet.hpp"
 #include "NFComm/NFPluginModule/NFPlatform.h"
 
 typedef std::function<int(const NFGUID&, const std::string&, const NFData&, const NFData&)> PROPERTY_EVENT_FUNCTOR;
 typedef NF_SHARE_PTR<PROPERTY_EVENT_FUNCTOR> PROPERTY_EVENT_FUNCTOR_PTR;
 
+//the slots of the properties of one object changed during a frame, each slot once
+typedef std::function<int(const NFGUID&, const std::vector<int>&)> PROPERTY_BATCH_EVENT_FUNCTOR;
+typedef NF_SHARE_PTR<PROPERTY_BATCH_EVENT_FUNCTOR> PROPERTY_BATCH_EVENT_FUNCTOR_PTR;
+
+//the flags of a property as bits, a property event listener says which ones it wants
+enum NF_PROPERTY_MASK
+{
+	NF_PROPERTY_MASK_PUBLIC = 1 << 0,
+	NF_PROPERTY_MASK_PRIVATE = 1 << 1,
+	NF_PROPERTY_MASK_SAVE = 1 << 2,
+	NF_PROPERTY_MASK_CACHE = 1 << 3,
+	NF_PROPERTY_MASK_REF = 1 << 4,
+	NF_PROPERTY_MASK_FORCE = 1 << 5,
+	NF_PROPERTY_MASK_UPLOAD = 1 << 6,
+	NF_PROPERTY_MASK_INDEX = 1 << 7,
+	NF_PROPERTY_MASK_ALL = 0xFF,
+};
+
 class _NFExport NFIProperty :public NFMemoryCounter<NFIProperty>
 {
 public:
@@ -45,6 +65,10 @@ public:
 	virtual const bool GetRef() const = 0;
 	virtual const bool GetForce() const = 0;
 	virtual const bool GetUpload() const = 0;
+	//the objects of a scene group can be looked up by its value
+	virtual const bool GetIndex() const = 0;
+	//NF_PROPERTY_MASK bits of the flags above
+	virtual const int GetMask() const = 0;
 
 	virtual void SetSave(bool bSave) = 0;
 	virtual void SetPublic(bool bPublic) = 0;
@@ -53,16 +77,17 @@ public:
 	virtual void SetRef(bool bRef) = 0;
 	virtual void SetForce(bool bRef) = 0;
 	virtual void SetUpload(bool bUpload) = 0;
+	virtual void SetIndex(bool bIndex) = 0;
 
 	virtual NFINT64 GetInt() const = 0;
 	virtual int GetInt32() const = 0;
 	virtual double GetFloat() const = 0;
 	virtual const std::string& GetString() const = 0;
-	virtual const NFGUID& GetObject() const = 0;
-	virtual const NFVector2& GetVector2() const = 0;
-	virtual const NFVector3& GetVector3() const = 0;
+	virtual NFGUID GetObject() const = 0;
+	virtual NFVector2 GetVector2() const = 0;
+	virtual NFVector3 GetVector3() const = 0;
 
-	virtual const NFData& GetValue() const = 0;
+	virtual NFData GetValue() const = 0;
 	virtual const NF_SHARE_PTR<NFList<std::string>> GetEmbeddedList() const = 0;
 	virtual const NF_SHARE_PTR<NFMapEx<std::string, std::string>> GetEmbeddedMap() const = 0;
 
@@ -73,6 +98,12 @@ public:
 	virtual bool DeSerialization() = 0;
 
 	virtual void RegisterCallback(const PROPERTY_EVENT_FUNCTOR_PTR& cb) = 0;
+
+	//keep the value in the column nSlot of the class store, a null store moves it back into the property
+	virtual bool SetStore(NF_SHARE_PTR<NFIClassStore> xStore, const int nSlot, const int nRow) = 0;
+
+	//every change sets the bit nSlot of the dirty set of the owner, NULL to stop
+	virtual void SetDirtySet(NFDirtySet* pDirtySet, const int nSlot) = 0;
 };
 
 #endif
@@ -41,9 +41,41 @@ public:
 	virtual int GetPropertyInt32(const std::string& strPropertyName) = 0;
     virtual double GetPropertyFloat(const std::string& strPropertyName) = 0;
     virtual const std::string& GetPropertyString(const std::string& strPropertyName) = 0;
-    virtual const NFGUID& GetPropertyObject(const std::string& strPropertyName) = 0;
-	virtual const NFVector2& GetPropertyVector2(const std::string& strPropertyName) = 0;
-	virtual const NFVector3& GetPropertyVector3(const std::string& strPropertyName) = 0;
+    virtual NFGUID GetPropertyObject(const std::string& strPropertyName) = 0;
+	virtual NFVector2 GetPropertyVector2(const std::string& strPropertyName) = 0;
+	virtual NFVector3 GetPropertyVector3(const std::string& strPropertyName) = 0;
+
+    //////////////////////////////////////////////////////////////////////////
+    //dense slots given by the class module, the same order as NFrame::xxx::PropertySlot
+    //a slot of IObject works for every class, the others only for the objects of that class
+    virtual bool SetPropertySlot(const int nSlot, NF_SHARE_PTR<NFIProperty> pProperty) = 0;
+    //-1 if the property has no slot
+    virtual int GetPropertySlot(const std::string& strPropertyName) = 0;
+    virtual int GetPropertySlotCount() = 0;
+    virtual NF_SHARE_PTR<NFIProperty> GetPropertyBySlot(const int nSlot) = 0;
+    //copy every property of the class manager into this empty one, with the same slots and flags
+    virtual bool CloneFrom(NF_SHARE_PTR<NFIPropertyManager> pPrototype) = 0;
+
+    //slots of the properties changed since the last ClearDirty, for the delta sync and the delta save
+    virtual int GetDirtySlot(std::vector<int>& vSlotList) = 0;
+    virtual bool IsDirty(const int nSlot) = 0;
+    virtual void ClearDirty() = 0;
+    virtual void ClearDirty(const int nSlot) = 0;
+
+    virtual bool SetPropertyInt(const int nSlot, const NFINT64 nValue) = 0;
+    virtual bool SetPropertyFloat(const int nSlot, const double dwValue) = 0;
+    virtual bool SetPropertyString(const int nSlot, const std::string& strValue) = 0;
+    virtual bool SetPropertyObject(const int nSlot, const NFGUID& obj) = 0;
+    virtual bool SetPropertyVector2(const int nSlot, const NFVector2& value) = 0;
+    virtual bool SetPropertyVector3(const int nSlot, const NFVector3& value) = 0;
+
+    virtual NFINT64 GetPropertyInt(const int nSlot) = 0;
+    virtual int GetPropertyInt32(const int nSlot) = 0;
+    virtual double GetPropertyFloat(const int nSlot) = 0;
+    virtual const std::string& GetPropertyString(const int nSlot) = 0;
+    virtual NFGUID GetPropertyObject(const int nSlot) = 0;
+    virtual NFVector2 GetPropertyVector2(const int nSlot) = 0;
+    virtual NFVector3 GetPropertyVector3(const int nSlot) = 0;
 
     //////////////////////////////////////////////////////////////////////////
 
@@ -10,6 +10,7 @@
 #define NFI_RECORD_H
 
 #include "NFDataList.hpp"
+#include "NFDirtySet.hpp"
 #include "NFComm/NFPluginModule/NFPlatform.h"
 
 struct RECORD_EVENT_DATA
@@ -40,6 +41,14 @@ struct RECORD_EVENT_DATA
 	std::string strRecordName;
 };
 
+//an indexed col is found by a hash lookup instead of scanning the rows, only the int, string and object cols can be indexed
+enum NF_RECORD_INDEX
+{
+	NF_RECORD_INDEX_NONE = 0,
+	NF_RECORD_INDEX_UNIQUE = 1,//two used rows can not have the same value, except the null value
+	NF_RECORD_INDEX_MULTI = 2,
+};
+
 typedef std::function<int(const NFGUID&, const RECORD_EVENT_DATA&, const NFData&, const NFData&)> RECORD_EVENT_FUNCTOR;
 typedef NF_SHARE_PTR<RECORD_EVENT_FUNCTOR> RECORD_EVENT_FUNCTOR_PTR;
 
@@ -50,9 +59,6 @@ public:
 	{
 	}
 
-    typedef std::vector< NF_SHARE_PTR<NFData> > TRECORDVEC;
-    typedef TRECORDVEC::const_iterator TRECORDVECCONSTITER;
-
     virtual ~NFIRecord() {}
 
     virtual bool IsUsed(const int nRow) const  = 0;
@@ -65,6 +71,9 @@ public:
     virtual NFDATA_TYPE GetColType(const int nCol) const = 0;
     virtual const std::string& GetColTag(const int nCol) const = 0;
 
+    virtual bool SetIndex(const int nCol, const NF_RECORD_INDEX eIndex) = 0;
+    virtual NF_RECORD_INDEX GetIndex(const int nCol) const = 0;
+
     
     virtual int AddRow(const int nRow) = 0;
     virtual int AddRow(const int nRow, const NFDataList& var) = 0;
@@ -113,7 +122,7 @@ public:
 	virtual int FindVector2(const int nCol, const NFVector2& value, NFDataList& varResult) = 0;
 	virtual int FindVector3(const int nCol, const NFVector3& value, NFDataList& varResult) = 0;
 	
-	//return the row and only can used when the col is the primary key
+	//return the first row without any NFDataList, the only one when the col has an unique index
 	virtual int FindRowByColValue(const int nCol, const NFData& var) = 0;
 	virtual int FindInt(const int nCol, const NFINT64 value) = 0;
 	virtual int FindFloat(const int nCol, const double value) = 0;
@@ -130,7 +139,7 @@ public:
 	virtual int FindVector2(const std::string& strColTag, const NFVector2& value, NFDataList& varResult) = 0;
 	virtual int FindVector3(const std::string& strColTag, const NFVector3& value, NFDataList& varResult) = 0;
  
-	//return the row and only can used when the col is the primary key
+	//return the first row without any NFDataList, the only one when the col has an unique index
 	virtual int FindRowByColValue(const std::string& strColTag, const NFData& var) = 0;
 	virtual int FindInt(const std::string& strColTag, const NFINT64 value) = 0;
 	virtual int FindFloat(const std::string& strColTag, const double value) = 0;
@@ -154,6 +163,13 @@ public:
 
     virtual void AddRecordHook(const RECORD_EVENT_FUNCTOR_PTR& cb) = 0;
 
+    //every change sets the bit nSlot of the dirty set of the owner, NULL to stop
+    virtual void SetDirtySet(NFDirtySet* pDirtySet, const int nSlot) = 0;
+    //rows added, changed or removed since the last ClearDirty, a removed row is not used any more
+    virtual int GetDirtyRow(std::vector<int>& vRowList) const = 0;
+    virtual bool IsDirty() const = 0;
+    virtual void ClearDirty() = 0;
+
     virtual const bool GetSave() = 0;
     virtual const bool GetPublic() = 0;
     virtual const bool GetPrivate() = 0;
@@ -174,8 +190,6 @@ public:
     virtual void SetPublic(const bool bPublic) = 0;
     virtual void SetPrivate(const bool bPrivate) = 0;
     virtual void SetName(const std::string& strName) = 0;
-
-    virtual const TRECORDVEC& GetRecordVec() const = 0;
 };
 
 #endif
@@ -52,6 +52,21 @@ public:
 	virtual const NFVector3& GetRecordVector3(const std::string& strRecordName, const int nRow, const std::string& strColTag) = 0;
 
     //////////////////////////////////////////////////////////////////////////
+    //dense slots given by the class module, the same order as NFrame::xxx::RecordSlot
+    virtual bool SetRecordSlot(const int nSlot, NF_SHARE_PTR<NFIRecord> pRecord) = 0;
+    //-1 if the record has no slot
+    virtual int GetRecordSlot(const std::string& strRecordName) = 0;
+    virtual int GetRecordSlotCount() = 0;
+    virtual NF_SHARE_PTR<NFIRecord> GetRecordBySlot(const int nSlot) = 0;
+    //copy every record of the class manager into this empty one, with the same slots and flags
+    virtual bool CloneFrom(NF_SHARE_PTR<NFIRecordManager> pPrototype) = 0;
+
+    //slots of the records changed since the last ClearDirty, the rows are given by the record
+    virtual int GetDirtySlot(std::vector<int>& vSlotList) = 0;
+    virtual bool IsDirty(const int nSlot) = 0;
+    //the dirty rows of the records are cleared too
+    virtual void ClearDirty() = 0;
+    virtual void ClearDirty(const int nSlot) = 0;
 };
 
 
@@ -0,0 +1,186 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFPropertyIndex.hpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-26
+//    @Module           :    NFPropertyIndex
+//
+// -------------------------------------------------------------------------
+
+#ifndef NF_PROPERTY_INDEX_H
+#define NF_PROPERTY_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "NFHashMapEx.hpp"
+#include "NFDataList.hpp"
+#include "NFComm/NFPluginModule/NFPlatform.h"
+#include "NFComm/NFPluginModule/NFGUID.h"
+
+//the object handles of one scene group by the value of their indexed properties
+//only the int, string and object values, the handles of one value are in no order
+class NFPropertyIndex
+{
+public:
+    NFPropertyIndex()
+    {
+    }
+
+    virtual ~NFPropertyIndex()
+    {
+    }
+
+    //false if the handle is already there for that property or is 0, the caller logs the 0
+    bool AddObject(const std::string& strPropertyName, const NFUINT32 nHandle, const NFData& xValue)
+    {
+        if (nHandle == 0)
+        {
+            return false;
+        }
+
+        ValueIndex* pIndex = mxValueIndex.GetElementNude(strPropertyName);
+        if (!pIndex)
+        {
+            mxValueIndex.AddElement(strPropertyName, NF_SHARE_PTR<ValueIndex>(NF_NEW ValueIndex()));
+            pIndex = mxValueIndex.GetElementNude(strPropertyName);
+        }
+
+        if (pIndex->xPosition.find(nHandle) != pIndex->xPosition.end())
+        {
+            return false;
+        }
+
+        std::vector<NFUINT32>* pList = NULL;
+        switch (xValue.GetType())
+        {
+        case TDATA_INT:
+            pList = &pIndex->xIntList[xValue.GetInt()];
+            break;
+        case TDATA_STRING:
+            pList = &pIndex->xStringList[xValue.GetString()];
+            break;
+        case TDATA_OBJECT:
+            pList = &pIndex->xObjectList[xValue.GetObject()];
+            break;
+        default:
+            return false;
+        }
+
+        pIndex->xPosition[nHandle] = (int)pList->size();
+        pList->push_back(nHandle);
+
+        return true;
+    }
+
+    //false if the handle is not there with that value
+    bool RemoveObject(const std::string& strPropertyName, const NFUINT32 nHandle, const NFData& xValue)
+    {
+        ValueIndex* pIndex = mxValueIndex.GetElementNude(strPropertyName);
+        if (!pIndex)
+        {
+            return false;
+        }
+
+        switch (xValue.GetType())
+        {
+        case TDATA_INT:
+            return RemoveHandle(*pIndex, pIndex->xIntList, xValue.GetInt(), nHandle);
+        case TDATA_STRING:
+            return RemoveHandle(*pIndex, pIndex->xStringList, xValue.GetString(), nHandle);
+        case TDATA_OBJECT:
+            return RemoveHandle(*pIndex, pIndex->xObjectList, xValue.GetObject(), nHandle);
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    //NULL if no object has that value, the list is only good until the next add or remove
+    const std::vector<NFUINT32>* GetObjectList(const std::string& strPropertyName, const NFData& xValue)
+    {
+        ValueIndex* pIndex = mxValueIndex.GetElementNude(strPropertyName);
+        if (!pIndex)
+        {
+            return NULL;
+        }
+
+        switch (xValue.GetType())
+        {
+        case TDATA_INT:
+            return FindList(pIndex->xIntList, xValue.GetInt());
+        case TDATA_STRING:
+            return FindList(pIndex->xStringList, xValue.GetString());
+        case TDATA_OBJECT:
+            return FindList(pIndex->xObjectList, xValue.GetObject());
+        default:
+            break;
+        }
+
+        return NULL;
+    }
+
+    void ClearAll()
+    {
+        mxValueIndex.ClearAll();
+    }
+
+protected:
+    struct ValueIndex
+    {
+        std::unordered_map<NFINT64, std::vector<NFUINT32>> xIntList;
+        std::unordered_map<std::string, std::vector<NFUINT32>> xStringList;
+        std::unordered_map<NFGUID, std::vector<NFUINT32>> xObjectList;
+        //position of every handle in the list of its value
+        std::unordered_map<NFUINT32, int> xPosition;
+    };
+
+    template <typename TKey>
+    static const std::vector<NFUINT32>* FindList(const std::unordered_map<TKey, std::vector<NFUINT32>>& xList, const TKey& xKey)
+    {
+        typename std::unordered_map<TKey, std::vector<NFUINT32>>::const_iterator it = xList.find(xKey);
+        return it != xList.end() ? &it->second : NULL;
+    }
+
+    template <typename TKey>
+    static bool RemoveHandle(ValueIndex& xIndex, std::unordered_map<TKey, std::vector<NFUINT32>>& xList, const TKey& xKey, const NFUINT32 nHandle)
+    {
+        typename std::unordered_map<TKey, std::vector<NFUINT32>>::iterator it = xList.find(xKey);
+        std::unordered_map<NFUINT32, int>::iterator itPos = xIndex.xPosition.find(nHandle);
+        if (it == xList.end() || itPos == xIndex.xPosition.end())
+        {
+            return false;
+        }
+
+        std::vector<NFUINT32>& xHandleList = it->second;
+        const int nPos = itPos->second;
+        if (nPos >= (int)xHandleList.size() || xHandleList[nPos] != nHandle)
+        {
+            return false;
+        }
+
+        //swap with the last one, and fix the position of the one that is moved
+        const int nLast = (int)xHandleList.size() - 1;
+        if (nPos < nLast)
+        {
+            xHandleList[nPos] = xHandleList[nLast];
+            xIndex.xPosition[xHandleList[nPos]] = nPos;
+        }
+
+        xHandleList.pop_back();
+        xIndex.xPosition.erase(itPos);
+
+        //no empty lists left behind by the values that come and go
+        if (xHandleList.empty())
+        {
+            xList.erase(it);
+        }
+
+        return true;
+    }
+
+protected:
+    NFHashMapEx<std::string, ValueIndex> mxValueIndex;
+};
+
+#endif
@@ -10,6 +10,7 @@
 #define NF_QUEUE_H
 
 #include <list>
+#include <vector>
 #include <thread>
 #include <mutex>
 #include <atomic>
@@ -89,4 +90,65 @@ private:
     std::list<T> mList;
 };
 
+//lock free ring for exactly one producer thread and one consumer thread
+template<typename T>
+class NFSPSCQueue
+{
+public:
+    //nCapacity must be a power of 2
+    explicit NFSPSCQueue(const size_t nCapacity = 65536)
+        : mxData(nCapacity), mnMask(nCapacity - 1), mnHead(0), mnTail(0)
+    {
+    }
+
+    //called by the producer only
+    bool Push(T&& object)
+    {
+        const size_t nTail = mnTail.load(std::memory_order_relaxed);
+        if (nTail - mnHead.load(std::memory_order_acquire) > mnMask)
+        {
+            return false;
+        }
+
+        mxData[nTail & mnMask] = std::move(object);
+        mnTail.store(nTail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //called by the consumer only
+    bool Pop(T& object)
+    {
+        const size_t nHead = mnHead.load(std::memory_order_relaxed);
+        if (nHead == mnTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        object = std::move(mxData[nHead & mnMask]);
+        mnHead.store(nHead + 1, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    NFSPSCQueue(const NFSPSCQueue&);
+    NFSPSCQueue& operator=(const NFSPSCQueue&);
+
+    enum
+    {
+        CACHE_LINE_SIZE = 64,
+    };
+
+    std::vector<T> mxData;
+    const size_t mnMask;
+    //keep the two cursors on different cache lines, padded by hand and not alignas
+    //so that a plain new of the queue or of what holds it gets no over-aligned type
+    char mxHeadPad[CACHE_LINE_SIZE];
+    std::atomic<size_t> mnHead;
+    char mxTailPad[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> mnTail;
+    char mxEndPad[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,290 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFViewGrid.hpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-25
+//    @Module           :    NFViewGrid
+//
+// -------------------------------------------------------------------------
+
+#ifndef NF_VIEW_GRID_H
+#define NF_VIEW_GRID_H
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "NFHashMapEx.hpp"
+#include "NFDataList.hpp"
+#include "NFComm/NFPluginModule/NFPlatform.h"
+#include "NFComm/NFPluginModule/NFGUID.h"
+
+//a uniform grid on X and Z, an object sees the players and the others of the 3x3 cells around its own cell
+//the cell size is the view range, and two objects always see each other or neither does
+//so a move only has to look at the cells that come into or go out of the 3x3 block
+//a position outside of the scene counts as the nearest edge of it
+class NFViewGrid
+{
+public:
+    enum
+    {
+        //the +-1 around a cell never overflows
+        MAX_CELL_INDEX = 1 << 24,
+    };
+
+    NFViewGrid()
+    {
+        mnCellSize = 0;
+        mnWidth = 0;
+    }
+
+    virtual ~NFViewGrid()
+    {
+    }
+
+    //0 turns it off, the objects in it are dropped
+    //the scene is [0, nWidth] on X and Z, 0 for no bounds
+    void Init(const int nCellSize, const int nWidth)
+    {
+        mnCellSize = nCellSize > 0 ? nCellSize : 0;
+        mnWidth = nWidth > 0 ? nWidth : 0;
+        mxCell.clear();
+        mxObject.ClearAll();
+    }
+
+    bool Enable() const
+    {
+        return mnCellSize > 0;
+    }
+
+    int GetCellSize() const
+    {
+        return mnCellSize;
+    }
+
+    bool ExistObject(const NFGUID& self)
+    {
+        return mxObject.ExistElement(self);
+    }
+
+    bool AddObject(const NFGUID& self, const bool bPlayer, const NFVector3& vPos)
+    {
+        if (!Enable() || self.IsNull() || mxObject.ExistElement(self))
+        {
+            return false;
+        }
+
+        NF_SHARE_PTR<GridObject> xObject(NF_NEW GridObject());
+        xObject->bPlayer = bPlayer;
+        xObject->nCellX = CellIndex(vPos.X());
+        xObject->nCellZ = CellIndex(vPos.Z());
+        xObject->nIndex = -1;
+
+        mxObject.AddElement(self, xObject);
+        JoinCell(self, *xObject);
+
+        return true;
+    }
+
+    bool RemoveObject(const NFGUID& self)
+    {
+        GridObject* pObject = mxObject.GetElementNude(self);
+        if (!pObject)
+        {
+            return false;
+        }
+
+        LeaveCell(*pObject);
+
+        return mxObject.RemoveElement(self);
+    }
+
+    //false if self is not in the grid, the lists stay empty unless self changes its cell
+    //the enter lists are the objects that start to see self, the leave lists the ones that stop, self is never in them
+    bool MoveObject(const NFGUID& self, const NFVector3& vPos, NFDataList& xEnterPlayer, NFDataList& xEnterOther, NFDataList& xLeavePlayer, NFDataList& xLeaveOther)
+    {
+        GridObject* pObject = mxObject.GetElementNude(self);
+        if (!pObject)
+        {
+            return false;
+        }
+
+        const int nOldX = pObject->nCellX;
+        const int nOldZ = pObject->nCellZ;
+        const int nNewX = CellIndex(vPos.X());
+        const int nNewZ = CellIndex(vPos.Z());
+        if (nOldX == nNewX && nOldZ == nNewZ)
+        {
+            return true;
+        }
+
+        //out of the old cell first, it may be one of the cells that go out of the view
+        LeaveCell(*pObject);
+
+        for (int x = nOldX - 1; x <= nOldX + 1; ++x)
+        {
+            for (int z = nOldZ - 1; z <= nOldZ + 1; ++z)
+            {
+                if (std::abs(x - nNewX) > 1 || std::abs(z - nNewZ) > 1)
+                {
+                    AddCellObject(x, z, &xLeavePlayer, &xLeaveOther, NFGUID());
+                }
+            }
+        }
+
+        for (int x = nNewX - 1; x <= nNewX + 1; ++x)
+        {
+            for (int z = nNewZ - 1; z <= nNewZ + 1; ++z)
+            {
+                if (std::abs(x - nOldX) > 1 || std::abs(z - nOldZ) > 1)
+                {
+                    AddCellObject(x, z, &xEnterPlayer, &xEnterOther, NFGUID());
+                }
+            }
+        }
+
+        pObject->nCellX = nNewX;
+        pObject->nCellZ = nNewZ;
+        JoinCell(self, *pObject);
+
+        return true;
+    }
+
+    //the players or the others of the 3x3 cells around self, false if self is not in the grid
+    bool GetViewList(const NFGUID& self, NFDataList& list, const bool bPlayer, const NFGUID& noSelf)
+    {
+        GridObject* pObject = mxObject.GetElementNude(self);
+        if (!pObject)
+        {
+            return false;
+        }
+
+        for (int x = pObject->nCellX - 1; x <= pObject->nCellX + 1; ++x)
+        {
+            for (int z = pObject->nCellZ - 1; z <= pObject->nCellZ + 1; ++z)
+            {
+                AddCellObject(x, z, bPlayer ? &list : NULL, bPlayer ? NULL : &list, noSelf);
+            }
+        }
+
+        return true;
+    }
+
+protected:
+    struct GridCell
+    {
+        std::vector<NFGUID> xPlayerList;
+        std::vector<NFGUID> xOtherList;
+    };
+
+    struct GridObject
+    {
+        bool bPlayer;
+        int nCellX;
+        int nCellZ;
+        //index in the list of its cell
+        int nIndex;
+    };
+
+    //NaN counts as 0, the infinities as the edges
+    int CellIndex(const float fValue) const
+    {
+        double fPos = std::isnan(fValue) ? 0.0 : fValue;
+        if (mnWidth > 0)
+        {
+            fPos = std::min(std::max(fPos, 0.0), (double)mnWidth);
+        }
+
+        const double fCell = std::floor(fPos / mnCellSize);
+        if (fCell >= MAX_CELL_INDEX)
+        {
+            return MAX_CELL_INDEX;
+        }
+
+        if (fCell <= -MAX_CELL_INDEX)
+        {
+            return -MAX_CELL_INDEX;
+        }
+
+        return (int)fCell;
+    }
+
+    static NFINT64 CellKey(const int nCellX, const int nCellZ)
+    {
+        return (NFINT64)(((NFUINT64)(NFUINT32)nCellX << 32) | (NFUINT32)nCellZ);
+    }
+
+    void JoinCell(const NFGUID& self, GridObject& xObject)
+    {
+        GridCell& xCell = mxCell[CellKey(xObject.nCellX, xObject.nCellZ)];
+        std::vector<NFGUID>& xList = xObject.bPlayer ? xCell.xPlayerList : xCell.xOtherList;
+        xObject.nIndex = (int)xList.size();
+        xList.push_back(self);
+    }
+
+    void LeaveCell(GridObject& xObject)
+    {
+        std::unordered_map<NFINT64, GridCell>::iterator it = mxCell.find(CellKey(xObject.nCellX, xObject.nCellZ));
+        if (it == mxCell.end() || xObject.nIndex < 0)
+        {
+            return;
+        }
+
+        //swap with the last one, and fix the index of the one that is moved
+        std::vector<NFGUID>& xList = xObject.bPlayer ? it->second.xPlayerList : it->second.xOtherList;
+        const int nLast = (int)xList.size() - 1;
+        if (xObject.nIndex < nLast)
+        {
+            xList[xObject.nIndex] = xList[nLast];
+            GridObject* pMoved = mxObject.GetElementNude(xList[nLast]);
+            if (pMoved)
+            {
+                pMoved->nIndex = xObject.nIndex;
+            }
+        }
+
+        xList.pop_back();
+        xObject.nIndex = -1;
+
+        //only the cells somebody is in are kept
+        if (it->second.xPlayerList.empty() && it->second.xOtherList.empty())
+        {
+            mxCell.erase(it);
+        }
+    }
+
+    //NULL to skip the players or the others
+    void AddCellObject(const int nCellX, const int nCellZ, NFDataList* pPlayerList, NFDataList* pOtherList, const NFGUID& noSelf)
+    {
+        std::unordered_map<NFINT64, GridCell>::iterator it = mxCell.find(CellKey(nCellX, nCellZ));
+        if (it == mxCell.end())
+        {
+            return;
+        }
+
+        const GridCell* pCell = &it->second;
+
+        for (int i = 0; pPlayerList && i < (int)pCell->xPlayerList.size(); ++i)
+        {
+            if (pCell->xPlayerList[i] != noSelf)
+            {
+                pPlayerList->Add(pCell->xPlayerList[i]);
+            }
+        }
+
+        for (int i = 0; pOtherList && i < (int)pCell->xOtherList.size(); ++i)
+        {
+            if (pCell->xOtherList[i] != noSelf)
+            {
+                pOtherList->Add(pCell->xOtherList[i]);
+            }
+        }
+    }
+
+protected:
+    int mnCellSize;
+    int mnWidth;
+    std::unordered_map<NFINT64, GridCell> mxCell;
+    NFHashMapEx<NFGUID, GridObject> mxObject;
+};
+
+#endif
@@ -6,6 +6,7 @@
 //
 // -------------------------------------------------------------------------
 
+#include <algorithm>
 #include "NFCEventModule.h"
 
 bool NFCEventModule::Init()
@@ -61,26 +62,71 @@ bool NFCEventModule::Execute()
 		}
 	}
 
+	ProcessPostEvent();
+
     return true;
 
 }
 
+void NFCEventModule::ProcessPostEvent()
+{
+	if (mnPostCount <= 0)
+	{
+		return;
+	}
+
+	const int nCount = mnPostCount;
+	mxPostEventList.swap(mxDispatchEventList);
+	mnPostCount = 0;
+
+	//the slot breaks the ties, so the events of one ID stay in the order they were posted
+	mxDispatchOrder.clear();
+	for (int i = 0; i < nCount; ++i)
+	{
+		mxDispatchOrder.push_back(std::make_pair((int)mxDispatchEventList[i].nEventID, i));
+	}
+
+	std::sort(mxDispatchOrder.begin(), mxDispatchOrder.end());
+
+	int i = 0;
+	while (i < nCount)
+	{
+		const NFEventDefine nEventID = (NFEventDefine)mxDispatchOrder[i].first;
+
+		//one lookup for the module handlers of the whole run
+		NF_SHARE_PTR<std::vector<MODULE_EVENT_FUNCTOR_PTR>> xEventListPtr = mModuleEventInfoMapEx.GetElement(nEventID);
+		for (; i < nCount && mxDispatchOrder[i].first == nEventID; ++i)
+		{
+			const PostEventData& xEvent = mxDispatchEventList[mxDispatchOrder[i].second];
+			if (!xEvent.self.IsNull())
+			{
+				DoEvent(xEvent.self, nEventID, xEvent.xValueList);
+			}
+			else if (xEventListPtr)
+			{
+				DoModuleEvent(*xEventListPtr, nEventID, xEvent.xValueList);
+			}
+		}
+	}
+}
+
+void NFCEventModule::DoModuleEvent(const std::vector<MODULE_EVENT_FUNCTOR_PTR>& xEventList, const NFEventDefine nEventID, const NFDataList& valueList)
+{
+	for (int i = 0; i < (int)xEventList.size(); ++i)
+	{
+		MODULE_EVENT_FUNCTOR* pFunc = xEventList[i].get();
+		pFunc->operator()(nEventID, valueList);
+	}
+}
+
 bool NFCEventModule::DoEvent(const NFEventDefine nEventID, const NFDataList & valueList)
 {
 	bool bRet = false;
 
-	NF_SHARE_PTR<NFList<MODULE_EVENT_FUNCTOR_PTR>> xEventListPtr = mModuleEventInfoMapEx.GetElement(nEventID);
+	NF_SHARE_PTR<std::vector<MODULE_EVENT_FUNCTOR_PTR>> xEventListPtr = mModuleEventInfoMapEx.GetElement(nEventID);
 	if (xEventListPtr)
 	{
-		MODULE_EVENT_FUNCTOR_PTR pFunPtr;
-		bool bRet = xEventListPtr->First(pFunPtr);
-		while (bRet)
-		{
-			MODULE_EVENT_FUNCTOR* pFunc = pFunPtr.get();
-			pFunc->operator()(nEventID, valueList);
-
-			bRet = xEventListPtr->Next(pFunPtr);
-		}
+		DoModuleEvent(*xEventListPtr, nEventID, valueList);
 
 		bRet = true;
 	}
@@ -88,6 +134,11 @@ bool NFCEventModule::DoEvent(const NFEventDefine nEventID, const NFDataList & va
 	return bRet;
 }
 
+bool NFCEventModule::PostEvent(const NFEventDefine nEventID, const NFDataList & valueList)
+{
+	return PostEvent(NFGUID(), nEventID, valueList);
+}
+
 bool NFCEventModule::ExistEventCallBack(const NFEventDefine nEventID)
 {
 	return mModuleEventInfoMapEx.ExistElement(nEventID);
@@ -107,34 +158,46 @@ bool NFCEventModule::DoEvent(const NFGUID self, const NFEventDefine nEventID, co
 		return bRet;
 	}
 
-	NF_SHARE_PTR<NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
+	NF_SHARE_PTR<NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
 	if (!xEventMapPtr)
 	{
 		return bRet;
 	}
 
-	NF_SHARE_PTR<NFList<OBJECT_EVENT_FUNCTOR_PTR>> xEventListPtr = xEventMapPtr->GetElement(nEventID);
+	NF_SHARE_PTR<std::vector<OBJECT_EVENT_FUNCTOR_PTR>> xEventListPtr = xEventMapPtr->GetElement(nEventID);
 	if (!xEventListPtr)
 	{
 		return bRet;
 	}
 
-	OBJECT_EVENT_FUNCTOR_PTR pFunPtr;
-	bool bFunRet = xEventListPtr->First(pFunPtr);
-	while (bFunRet)
+	const std::vector<OBJECT_EVENT_FUNCTOR_PTR>& xEventList = *xEventListPtr;
+	for (int i = 0; i < (int)xEventList.size(); ++i)
 	{
-		OBJECT_EVENT_FUNCTOR* pFunc = pFunPtr.get();
+		OBJECT_EVENT_FUNCTOR* pFunc = xEventList[i].get();
 		pFunc->operator()(self, nEventID, valueList);
-
-		bFunRet = xEventListPtr->Next(pFunPtr);
 	}
 
 	return bRet;
 }
 
+bool NFCEventModule::PostEvent(const NFGUID self, const NFEventDefine nEventID, const NFDataList & valueList)
+{
+	if (mnPostCount >= (int)mxPostEventList.size())
+	{
+		mxPostEventList.push_back(PostEventData());
+	}
+
+	PostEventData& xEvent = mxPostEventList[mnPostCount++];
+	xEvent.self = self;
+	xEvent.nEventID = nEventID;
+	xEvent.xValueList = valueList;
+
+	return true;
+}
+
 bool NFCEventModule::ExistEventCallBack(const NFGUID self, const NFEventDefine nEventID)
 {
-	NF_SHARE_PTR<NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
+	NF_SHARE_PTR<NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
 	if (!xEventMapPtr)
 	{
 		return false;
@@ -145,7 +208,7 @@ bool NFCEventModule::ExistEventCallBack(const NFGUID self, const NFEventDefine n
 
 bool NFCEventModule::RemoveEventCallBack(const NFGUID self, const NFEventDefine nEventID)
 {
-	NF_SHARE_PTR<NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
+	NF_SHARE_PTR<NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
 	if (!xEventMapPtr)
 	{
 		return false;
@@ -161,14 +224,14 @@ bool NFCEventModule::RemoveEventCallBack(const NFGUID self)
 
 bool NFCEventModule::AddEventCallBack(const NFEventDefine nEventID, const MODULE_EVENT_FUNCTOR_PTR cb)
 {
-	NF_SHARE_PTR<NFList<MODULE_EVENT_FUNCTOR_PTR>> xEventListPtr = mModuleEventInfoMapEx.GetElement(nEventID);
+	NF_SHARE_PTR<std::vector<MODULE_EVENT_FUNCTOR_PTR>> xEventListPtr = mModuleEventInfoMapEx.GetElement(nEventID);
 	if (!xEventListPtr)
 	{
-		xEventListPtr = NF_SHARE_PTR<NFList<MODULE_EVENT_FUNCTOR_PTR>>(NF_NEW NFList<MODULE_EVENT_FUNCTOR_PTR>());
+		xEventListPtr = NF_SHARE_PTR<std::vector<MODULE_EVENT_FUNCTOR_PTR>>(NF_NEW std::vector<MODULE_EVENT_FUNCTOR_PTR>());
 		mModuleEventInfoMapEx.AddElement(nEventID, xEventListPtr);
 	}
 
-	xEventListPtr->Add(cb);
+	xEventListPtr->push_back(cb);
 
 	return false;
 }
@@ -180,21 +243,21 @@ bool NFCEventModule::AddEventCallBack(const NFGUID self, const NFEventDefine nEv
 		return false;
 	}
 	
-	NF_SHARE_PTR<NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
+	NF_SHARE_PTR<NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>> xEventMapPtr = mObjectEventInfoMapEx.GetElement(self);
 	if (!xEventMapPtr)
 	{
-		xEventMapPtr = NF_SHARE_PTR<NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>>(NF_NEW NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>());
+		xEventMapPtr = NF_SHARE_PTR<NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>>(NF_NEW NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>());
 		mObjectEventInfoMapEx.AddElement(self, xEventMapPtr);
 	}
 
-	NF_SHARE_PTR<NFList<OBJECT_EVENT_FUNCTOR_PTR>> xEventListPtr =  xEventMapPtr->GetElement(nEventID);
+	NF_SHARE_PTR<std::vector<OBJECT_EVENT_FUNCTOR_PTR>> xEventListPtr =  xEventMapPtr->GetElement(nEventID);
 	if (!xEventListPtr)
 	{
-		xEventListPtr = NF_SHARE_PTR<NFList<OBJECT_EVENT_FUNCTOR_PTR>>(NF_NEW NFList<OBJECT_EVENT_FUNCTOR_PTR>());
+		xEventListPtr = NF_SHARE_PTR<std::vector<OBJECT_EVENT_FUNCTOR_PTR>>(NF_NEW std::vector<OBJECT_EVENT_FUNCTOR_PTR>());
 		xEventMapPtr->AddElement(nEventID, xEventListPtr);
 	}
 
-	xEventListPtr->Add(cb);
+	xEventListPtr->push_back(cb);
 
 	return true;
 }
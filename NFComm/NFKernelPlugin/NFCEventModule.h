@@ -10,6 +10,7 @@
 #define NFC_EVENT_MODULE_H
 
 #include <iostream>
+#include <vector>
 #include "NFComm/NFCore/NFIObject.h"
 #include "NFComm/NFPluginModule/NFGUID.h"
 #include "NFComm/NFPluginModule/NFIEventModule.h"
@@ -22,6 +23,7 @@ public:
     NFCEventModule(NFIPluginManager* p)
     {
         pPluginManager = p;
+        mnPostCount = 0;
     }
 
 
@@ -36,6 +38,7 @@ public:
 	virtual bool Execute();
 
 	virtual bool DoEvent(const NFEventDefine nEventID, const NFDataList& valueList);
+	virtual bool PostEvent(const NFEventDefine nEventID, const NFDataList& valueList);
 
 	virtual bool ExistEventCallBack(const NFEventDefine nEventID);
 
@@ -43,6 +46,7 @@ public:
 
 	//////////////////////////////////////////////////////////
 	virtual bool DoEvent(const NFGUID self, const NFEventDefine nEventID, const NFDataList& valueList);
+	virtual bool PostEvent(const NFGUID self, const NFEventDefine nEventID, const NFDataList& valueList);
 
 	virtual bool ExistEventCallBack(const NFGUID self, const NFEventDefine nEventID);
 
@@ -54,6 +58,11 @@ protected:
 	virtual bool AddEventCallBack(const NFEventDefine nEventID, const MODULE_EVENT_FUNCTOR_PTR cb);
 	virtual bool AddEventCallBack(const NFGUID self, const NFEventDefine nEventID, const OBJECT_EVENT_FUNCTOR_PTR cb);
 
+	void ProcessPostEvent();
+
+	//by index and without copying the functors, a handler may add to the list it is called from
+	void DoModuleEvent(const std::vector<MODULE_EVENT_FUNCTOR_PTR>& xEventList, const NFEventDefine nEventID, const NFDataList& valueList);
+
 private:
 
 	NFIKernelModule* m_pKernelodule;
@@ -61,11 +70,28 @@ private:
 private:
 	// for module
 	NFList<NFEventDefine> mModuleRemoveListEx;
-	NFMapEx<NFEventDefine, NFList<MODULE_EVENT_FUNCTOR_PTR>> mModuleEventInfoMapEx;
+	NFMapEx<NFEventDefine, std::vector<MODULE_EVENT_FUNCTOR_PTR>> mModuleEventInfoMapEx;
 
 	//for object
 	NFList<NFGUID> mObjectRemoveListEx;
-	NFMapEx<NFGUID, NFMapEx<NFEventDefine, NFList<OBJECT_EVENT_FUNCTOR_PTR>>> mObjectEventInfoMapEx;
+	NFMapEx<NFGUID, NFMapEx<NFEventDefine, std::vector<OBJECT_EVENT_FUNCTOR_PTR>>> mObjectEventInfoMapEx;
+
+	//a null self for the module events
+	struct PostEventData
+	{
+		NFGUID self;
+		NFEventDefine nEventID;
+		NFDataList xValueList;
+	};
+
+	//the slots are kept from frame to frame and only the first mnPostCount are in use
+	//so after the first frames posting copies the args into a slot that is already there
+	std::vector<PostEventData> mxPostEventList;
+	int mnPostCount;
+	//the batch being dispatched, the handlers post into the other list for the next frame
+	std::vector<PostEventData> mxDispatchEventList;
+	//event ID and slot, sorted to group the batch by ID
+	std::vector<std::pair<int, int>> mxDispatchOrder;
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 //    @Desc             :
 // -------------------------------------------------------------------------
 
+#include <algorithm>
 #include "NFCKernelModule.h"
 #include "NFComm/NFCore/NFMemManager.hpp"
 #include "NFComm/NFCore/NFCObject.h"
@@ -18,9 +19,17 @@ NFCKernelModule::NFCKernelModule(NFIPluginManager* p)
     nGUIDIndex = 0;
     mnRandomPos = 0;
     nLastTime = 0;
+    mnCommonPropertyMask = 0;
+    mnPropertyBatchMask = 0;
 
     pPluginManager = p;
 
+    //one functor for all the objects instead of one per property and record
+    mxCommonPropertyEvent = PROPERTY_EVENT_FUNCTOR_PTR(NF_NEW PROPERTY_EVENT_FUNCTOR(std::bind(&NFCKernelModule::OnPropertyCommonEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)));
+    mxCommonRecordEvent = RECORD_EVENT_FUNCTOR_PTR(NF_NEW RECORD_EVENT_FUNCTOR(std::bind(&NFCKernelModule::OnRecordCommonEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)));
+    mxIndexPropertyEvent = PROPERTY_EVENT_FUNCTOR_PTR(NF_NEW PROPERTY_EVENT_FUNCTOR(std::bind(&NFCKernelModule::OnPropertyIndexEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)));
+    mxPropertyBatchEvent = PROPERTY_EVENT_FUNCTOR_PTR(NF_NEW PROPERTY_EVENT_FUNCTOR(std::bind(&NFCKernelModule::OnPropertyBatchEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)));
+
     nLastTime = pPluginManager->GetNowTime();
     InitRandom();
 }
@@ -84,16 +93,17 @@ bool NFCKernelModule::Execute()
 
     m_pSceneModule->Execute();
 
-    NF_SHARE_PTR<NFIObject> pObject = First();
-    while (pObject)
+    //no First/Next here, the objects may walk the kernel themselves while executing
+    for (Entry& xEntry : *this)
     {
+        NF_SHARE_PTR<NFIObject> pObject = xEntry.second;
         mnCurExeObject = pObject->Self();
         pObject->Execute();
         mnCurExeObject = NFGUID();
-
-        pObject = Next();
     }
 
+    ProcessPropertyBatch();
+
     return true;
 }
 
@@ -146,53 +156,73 @@ NF_SHARE_PTR<NFIObject> NFCKernelModule::CreateObject(const NFGUID& self, const
         NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pObject->GetPropertyManager();
         NF_SHARE_PTR<NFIRecordManager> pRecordManager = pObject->GetRecordManager();
 
+        NF_SHARE_PTR<NFIClassStore> xClassStore = m_pClassModule->GetClassStore(strClassName);
+        const int nStoreRow = xClassStore ? xClassStore->AddRow(ident) : -1;
+
+        int nPropertyEventMask = mnCommonPropertyMask;
+        std::map<std::string, int>::iterator itMask = mxClassPropertyMask.find(strClassName);
+        if (itMask != mxClassPropertyMask.end())
+        {
+            nPropertyEventMask |= itMask->second;
+        }
+
+        const bool bIndexClass = mxIndexClass.find(strClassName) != mxIndexClass.end();
         
-        NF_SHARE_PTR<NFIProperty> pStaticConfigPropertyInfo = pStaticClassPropertyManager->First();
-        while (pStaticConfigPropertyInfo)
+        //the class managers are the prototypes, their properties and records come over in bulk
+        pPropertyManager->CloneFrom(pStaticClassPropertyManager);
+        pRecordManager->CloneFrom(pStaticClassRecordManager);
+
+        for (int nSlot = 0; nSlot < pPropertyManager->GetPropertySlotCount(); ++nSlot)
         {
-            NF_SHARE_PTR<NFIProperty> xProperty = pPropertyManager->AddProperty(ident, pStaticConfigPropertyInfo->GetKey(), pStaticConfigPropertyInfo->GetType());
+            NF_SHARE_PTR<NFIProperty> xProperty = pPropertyManager->GetPropertyBySlot(nSlot);
+            if (!xProperty)
+            {
+                continue;
+            }
 
-            xProperty->SetPublic(pStaticConfigPropertyInfo->GetPublic());
-            xProperty->SetPrivate(pStaticConfigPropertyInfo->GetPrivate());
-            xProperty->SetSave(pStaticConfigPropertyInfo->GetSave());
-            xProperty->SetCache(pStaticConfigPropertyInfo->GetCache());
-            xProperty->SetRef(pStaticConfigPropertyInfo->GetRef());
-			xProperty->SetUpload(pStaticConfigPropertyInfo->GetUpload());
+            if (nStoreRow >= 0)
+            {
+                xProperty->SetStore(xClassStore, nSlot, nStoreRow);
+            }
 
-            
-            pObject->AddPropertyCallBack(pStaticConfigPropertyInfo->GetKey(), this, &NFCKernelModule::OnPropertyCommonEvent);
+            //before the common event, so that its listeners already find the object by the new value
+            if (bIndexClass
+                && (nSlot == NFrame::IObject::PropertySlot::SceneID
+                    || nSlot == NFrame::IObject::PropertySlot::GroupID
+                    || (xProperty->GetIndex() && mxIndexProperty.find(xProperty->GetKey()) != mxIndexProperty.end())))
+            {
+                xProperty->RegisterCallback(mxIndexPropertyEvent);
+            }
 
-            pStaticConfigPropertyInfo = pStaticClassPropertyManager->Next();
+            //nobody listens to the other ones, their sets skip the dispatch
+            if (xProperty->GetMask() & nPropertyEventMask)
+            {
+                xProperty->RegisterCallback(mxCommonPropertyEvent);
+            }
+
+            if (xProperty->GetMask() & mnPropertyBatchMask)
+            {
+                xProperty->RegisterCallback(mxPropertyBatchEvent);
+            }
         }
 
-        NF_SHARE_PTR<NFIRecord> pConfigRecordInfo = pStaticClassRecordManager->First();
-        while (pConfigRecordInfo)
+        for (int nSlot = 0; nSlot < pRecordManager->GetRecordSlotCount(); ++nSlot)
         {
-            NF_SHARE_PTR<NFIRecord> xRecord =  pRecordManager->AddRecord(ident,
-                                      pConfigRecordInfo->GetName(),
-                                      pConfigRecordInfo->GetInitData(),
-                                      pConfigRecordInfo->GetTag(),
-                                      pConfigRecordInfo->GetRows());
-
-             xRecord->SetPublic(pConfigRecordInfo->GetPublic());
-             xRecord->SetPrivate(pConfigRecordInfo->GetPrivate());
-             xRecord->SetSave(pConfigRecordInfo->GetSave());
-             xRecord->SetCache(pConfigRecordInfo->GetCache());
-			 xRecord->SetUpload(pConfigRecordInfo->GetUpload());
-            
-            pObject->AddRecordCallBack(pConfigRecordInfo->GetName(), this, &NFCKernelModule::OnRecordCommonEvent);
-
-            pConfigRecordInfo = pStaticClassRecordManager->Next();
+            NF_SHARE_PTR<NFIRecord> xRecord = pRecordManager->GetRecordBySlot(nSlot);
+            if (xRecord)
+            {
+                xRecord->AddRecordHook(mxCommonRecordEvent);
+            }
         }
 
 		NFVector3 vRelivePos = m_pSceneModule->GetRelivePosition(nSceneID, 0);
 
-		pObject->SetPropertyObject(NFrame::IObject::ID(), self);
-		pObject->SetPropertyString(NFrame::IObject::ConfigID(), strConfigIndex);
-		pObject->SetPropertyString(NFrame::IObject::ClassName(), strClassName);
-		pObject->SetPropertyInt(NFrame::IObject::SceneID(), nSceneID);
-		pObject->SetPropertyInt(NFrame::IObject::GroupID(), nGroupID);
-		pObject->SetPropertyVector3(NFrame::IObject::Position(), vRelivePos);
+		pObject->SetPropertyObject(NFrame::IObject::PropertySlot::ID, self);
+		pObject->SetPropertyString(NFrame::IObject::PropertySlot::ConfigID, strConfigIndex);
+		pObject->SetPropertyString(NFrame::IObject::PropertySlot::ClassName, strClassName);
+		pObject->SetPropertyInt(NFrame::IObject::PropertySlot::SceneID, nSceneID);
+		pObject->SetPropertyInt(NFrame::IObject::PropertySlot::GroupID, nGroupID);
+		pObject->SetPropertyVector3(NFrame::IObject::PropertySlot::Position, vRelivePos);
 
 		//no data
 		DoEvent(ident, strClassName, pObject->GetState(), arg);
@@ -255,6 +285,11 @@ NF_SHARE_PTR<NFIObject> NFCKernelModule::CreateObject(const NFGUID& self, const
             }
         }
 
+        //the values set so far go in at once, the hook only follows the changes from here on
+        if (bIndexClass)
+        {
+            AddPropertyIndex(ident, nSceneID, nGroupID);
+        }
 
 		pObject->SetState(COE_CREATE_BEFORE_ATTACHDATA);
 		DoEvent(ident, strClassName, pObject->GetState(), arg);
@@ -302,11 +337,29 @@ bool NFCKernelModule::DestroyObject(const NFGUID& self)
     {
         const std::string& strClassName = GetPropertyString(self, NFrame::IObject::ClassName());
 
+        RemovePropertyIndex(self, nSceneID, nGroupID);
         pContainerInfo->RemoveObjectFromGroup(nGroupID, self, strClassName == NFrame::Player::ThisName() ? true : false);
 
         DoEvent(self, strClassName, COE_BEFOREDESTROY, NFDataList());
         DoEvent(self, strClassName, COE_DESTROY, NFDataList());
 
+        NF_SHARE_PTR<NFIClassStore> xClassStore = m_pClassModule->GetClassStore(strClassName);
+        if (xClassStore)
+        {
+            //someone may still hold the object, its values must not stay in a row that will be reused
+            NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+            if (pObject)
+            {
+                NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pObject->GetPropertyManager();
+                for (NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->First(); pProperty; pProperty = pPropertyManager->Next())
+                {
+                    pProperty->SetStore(nullptr, -1, -1);
+                }
+            }
+
+            xClassStore->RemoveRow(self);
+        }
+
         RemoveElement(self);
 
 		m_pEventModule->RemoveEventCallBack(self);
@@ -464,7 +517,7 @@ const std::string& NFCKernelModule::GetPropertyString(const NFGUID& self, const
     return NULL_STR;
 }
 
-const NFGUID& NFCKernelModule::GetPropertyObject(const NFGUID& self, const std::string& strPropertyName)
+NFGUID NFCKernelModule::GetPropertyObject(const NFGUID& self, const std::string& strPropertyName)
 {
     NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
     if (pObject)
@@ -477,7 +530,7 @@ const NFGUID& NFCKernelModule::GetPropertyObject(const NFGUID& self, const std::
     return NULL_OBJECT;
 }
 
-const NFVector2& NFCKernelModule::GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName)
+NFVector2 NFCKernelModule::GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
 	if (pObject)
@@ -490,7 +543,7 @@ const NFVector2& NFCKernelModule::GetPropertyVector2(const NFGUID& self, const s
 	return NULL_VECTOR2;
 }
 
-const NFVector3& NFCKernelModule::GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName)
+NFVector3 NFCKernelModule::GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName)
 {
 	NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
 	if (pObject)
@@ -503,6 +556,344 @@ const NFVector3& NFCKernelModule::GetPropertyVector3(const NFGUID& self, const s
 	return NULL_VECTOR3;
 }
 
+bool NFCKernelModule::SetPropertyInt(const NFGUID& self, const int nSlot, const NFINT64 nValue)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyInt(nSlot, nValue);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyFloat(const NFGUID& self, const int nSlot, const double dValue)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyFloat(nSlot, dValue);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyString(const NFGUID& self, const int nSlot, const std::string& strValue)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyString(nSlot, strValue);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyObject(const NFGUID& self, const int nSlot, const NFGUID& objectValue)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyObject(nSlot, objectValue);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyVector2(const NFGUID& self, const int nSlot, const NFVector2& value)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyVector2(nSlot, value);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyVector3(const NFGUID& self, const int nSlot, const NFVector3& value)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->SetPropertyVector3(nSlot, value);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+NFINT64 NFCKernelModule::GetPropertyInt(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyInt(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_INT;
+}
+
+int NFCKernelModule::GetPropertyInt32(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyInt32(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return (int)NULL_INT;
+}
+
+double NFCKernelModule::GetPropertyFloat(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyFloat(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_FLOAT;
+}
+
+const std::string& NFCKernelModule::GetPropertyString(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyString(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_STR;
+}
+
+NFGUID NFCKernelModule::GetPropertyObject(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyObject(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_OBJECT;
+}
+
+NFVector2 NFCKernelModule::GetPropertyVector2(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyVector2(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_VECTOR2;
+}
+
+NFVector3 NFCKernelModule::GetPropertyVector3(const NFGUID& self, const int nSlot)
+{
+    NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
+    if (pObject)
+    {
+        return pObject->GetPropertyVector3(nSlot);
+    }
+
+    m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "slot " + std::to_string(nSlot) + "| There is no object", __FUNCTION__, __LINE__);
+
+    return NULL_VECTOR3;
+}
+
+bool NFCKernelModule::SetPropertyInt(const NFUINT32 nHandle, const int nSlot, const NFINT64 nValue)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyInt(nSlot, nValue);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyFloat(const NFUINT32 nHandle, const int nSlot, const double dValue)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyFloat(nSlot, dValue);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyString(const NFUINT32 nHandle, const int nSlot, const std::string& strValue)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyString(nSlot, strValue);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyObject(const NFUINT32 nHandle, const int nSlot, const NFGUID& objectValue)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyObject(nSlot, objectValue);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyVector2(const NFUINT32 nHandle, const int nSlot, const NFVector2& value)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyVector2(nSlot, value);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+bool NFCKernelModule::SetPropertyVector3(const NFUINT32 nHandle, const int nSlot, const NFVector3& value)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->SetPropertyVector3(nSlot, value);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return false;
+}
+
+NFINT64 NFCKernelModule::GetPropertyInt(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyInt(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_INT;
+}
+
+int NFCKernelModule::GetPropertyInt32(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyInt32(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return (int)NULL_INT;
+}
+
+double NFCKernelModule::GetPropertyFloat(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyFloat(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_FLOAT;
+}
+
+const std::string& NFCKernelModule::GetPropertyString(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyString(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_STR;
+}
+
+NFGUID NFCKernelModule::GetPropertyObject(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyObject(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_OBJECT;
+}
+
+NFVector2 NFCKernelModule::GetPropertyVector2(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyVector2(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_VECTOR2;
+}
+
+NFVector3 NFCKernelModule::GetPropertyVector3(const NFUINT32 nHandle, const int nSlot)
+{
+    NFIObject* pObject = GetElementNudeByHandle(nHandle);
+    if (pObject)
+    {
+        return pObject->GetPropertyVector3(nSlot);
+    }
+
+    m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "slot " + std::to_string(nSlot) + "| There is no object, handle", nHandle, __FUNCTION__, __LINE__);
+
+    return NULL_VECTOR3;
+}
+
 NF_SHARE_PTR<NFIRecord> NFCKernelModule::FindRecord(const NFGUID& self, const std::string& strRecordName)
 {
     NF_SHARE_PTR<NFIObject> pObject = GetElement(self);
@@ -1023,7 +1414,7 @@ int NFCKernelModule::RequestGroupScene(const int nSceneID)
         {
             if (!pSceneInfo->GetElement(nNewGroupID))
             {
-                NF_SHARE_PTR<NFCSceneGroupInfo> pGroupInfo(NF_NEW NFCSceneGroupInfo(nSceneID, nNewGroupID, pSceneInfo->GetWidth()));
+                NF_SHARE_PTR<NFCSceneGroupInfo> pGroupInfo(NF_NEW NFCSceneGroupInfo(nSceneID, nNewGroupID, pSceneInfo->GetWidth(), pSceneInfo->GetViewRange()));
                 if (pGroupInfo)
                 {
                     pSceneInfo->AddElement(nNewGroupID, pGroupInfo);
@@ -1076,30 +1467,20 @@ bool NFCKernelModule::GetGroupObjectList(const int nSceneID, const int nGroupID,
 		NF_SHARE_PTR<NFCSceneGroupInfo> pGroupInfo = pSceneInfo->GetElement(nGroupID);
 		if (pGroupInfo)
 		{
-			NFGUID ident = NFGUID();
-			NF_SHARE_PTR<int> pRet = pGroupInfo->mxPlayerList.First(ident);
-			while (!ident.IsNull())
+			for (auto& xEntry : pGroupInfo->mxPlayerList)
 			{
-				if (ident != noSelf)
+				if (xEntry.first != noSelf)
 				{
-					list.Add(ident);
+					list.Add(xEntry.first);
 				}
-
-				ident = NFGUID();
-				pRet = pGroupInfo->mxPlayerList.Next(ident);
 			}
 
-			ident = NFGUID();
-			pRet = pGroupInfo->mxOtherList.First(ident);
-			while (!ident.IsNull())
+			for (auto& xEntry : pGroupInfo->mxOtherList)
 			{
-				if (ident != noSelf)
+				if (xEntry.first != noSelf)
 				{
-					list.Add(ident);
+					list.Add(xEntry.first);
 				}
-
-				ident = NFGUID();
-				pRet = pGroupInfo->mxOtherList.Next(ident);
 			}
 
 			return true;
@@ -1125,31 +1506,22 @@ bool NFCKernelModule::GetGroupObjectList(const int nSceneID, const int nGroupID,
 		{
 			if (bPlayer)
 			{
-				NFGUID ident = NFGUID();
-				NF_SHARE_PTR<int> pRet = pGroupInfo->mxPlayerList.First(ident);
-				while (!ident.IsNull())
+				for (auto& xEntry : pGroupInfo->mxPlayerList)
 				{
-					if (ident != noSelf)
+					if (xEntry.first != noSelf)
 					{
-						list.Add(ident);
+						list.Add(xEntry.first);
 					}
-
-					ident = NFGUID();
-					pRet = pGroupInfo->mxPlayerList.Next(ident);
 				}
 			}
 			else
 			{
-				NFGUID ident = NFGUID();
-				NF_SHARE_PTR<int> pRet = pGroupInfo->mxOtherList.First(ident);
-				while (!ident.IsNull())
+				for (auto& xEntry : pGroupInfo->mxOtherList)
 				{
-					if (ident != noSelf)
+					if (xEntry.first != noSelf)
 					{
-						list.Add(ident);
+						list.Add(xEntry.first);
 					}
-					ident = NFGUID();
-					pRet = pGroupInfo->mxOtherList.Next(ident);
 				}
 			}
 
@@ -1272,13 +1644,219 @@ int NFCKernelModule::OnPropertyCommonEvent(const NFGUID& self, const std::string
     return 0;
 }
 
+int NFCKernelModule::OnPropertyBatchEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar)
+{
+	NF_SHARE_PTR<NFIObject> xObject = GetElement(self);
+	if (!xObject || xObject->GetState() < CLASS_OBJECT_EVENT::COE_CREATE_HASDATA)
+	{
+		return 0;
+	}
+
+	const int nSlot = xObject->GetPropertyManager()->GetPropertySlot(strPropertyName);
+	if (nSlot >= 0)
+	{
+		mxPropertyBatch.push_back(std::make_pair(self, nSlot));
+	}
+
+	return 0;
+}
+
+void NFCKernelModule::ProcessPropertyBatch()
+{
+	if (mxPropertyBatch.empty())
+	{
+		return;
+	}
+
+	//the slots of one object together, a property set many times only once
+	mxPropertyBatchRun.swap(mxPropertyBatch);
+	std::sort(mxPropertyBatchRun.begin(), mxPropertyBatchRun.end());
+	mxPropertyBatchRun.erase(std::unique(mxPropertyBatchRun.begin(), mxPropertyBatchRun.end()), mxPropertyBatchRun.end());
+
+	size_t nIndex = 0;
+	while (nIndex < mxPropertyBatchRun.size())
+	{
+		const NFGUID self = mxPropertyBatchRun[nIndex].first;
+
+		mxPropertyBatchSlot.clear();
+		for (; nIndex < mxPropertyBatchRun.size() && mxPropertyBatchRun[nIndex].first == self; ++nIndex)
+		{
+			mxPropertyBatchSlot.push_back(mxPropertyBatchRun[nIndex].second);
+		}
+
+		//an object destroyed during the frame has no changes to give
+		if (!GetElement(self))
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < mxPropertyBatchCallBackList.size(); ++i)
+		{
+			PROPERTY_BATCH_EVENT_FUNCTOR* pFun = mxPropertyBatchCallBackList[i].get();
+			pFun->operator()(self, mxPropertyBatchSlot);
+		}
+	}
+
+	mxPropertyBatchRun.clear();
+}
+
+int NFCKernelModule::OnPropertyIndexEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar)
+{
+	NF_SHARE_PTR<NFIObject> xObject = GetElement(self);
+	if (!xObject)
+	{
+		return 0;
+	}
+
+	const int nSceneID = xObject->GetPropertyInt32(NFrame::IObject::PropertySlot::SceneID);
+	const int nGroupID = xObject->GetPropertyInt32(NFrame::IObject::PropertySlot::GroupID);
+
+	//nothing is removed before CreateObject adds the object or after DestroyObject removes it, then nothing is added either
+	if (NFrame::IObject::SceneID() == strPropertyName)
+	{
+		if (RemovePropertyIndex(self, (int)oldVar.GetInt(), nGroupID))
+		{
+			AddPropertyIndex(self, nSceneID, nGroupID);
+		}
+
+		return 0;
+	}
+
+	if (NFrame::IObject::GroupID() == strPropertyName)
+	{
+		if (RemovePropertyIndex(self, nSceneID, (int)oldVar.GetInt()))
+		{
+			AddPropertyIndex(self, nSceneID, nGroupID);
+		}
+
+		return 0;
+	}
+
+	NFPropertyIndex* pIndex = GetPropertyIndex(nSceneID, nGroupID);
+	const NFUINT32 nHandle = GetHandle(self);
+	if (0 == nHandle)
+	{
+		m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, strPropertyName + "| no handle, the property index misses the object", __FUNCTION__, __LINE__);
+		return 0;
+	}
+
+	if (pIndex && pIndex->RemoveObject(strPropertyName, nHandle, oldVar))
+	{
+		pIndex->AddObject(strPropertyName, nHandle, newVar);
+	}
+
+	return 0;
+}
+
+NFPropertyIndex* NFCKernelModule::GetPropertyIndex(const int nSceneID, const int nGroupID)
+{
+	NF_SHARE_PTR<NFCSceneInfo> pSceneInfo = m_pSceneModule->GetElement(nSceneID);
+	if (pSceneInfo)
+	{
+		NF_SHARE_PTR<NFCSceneGroupInfo> pGroupInfo = pSceneInfo->GetElement(nGroupID);
+		if (pGroupInfo)
+		{
+			return &pGroupInfo->mxPropertyIndex;
+		}
+	}
+
+	return NULL;
+}
+
+bool NFCKernelModule::AddPropertyIndex(const NFGUID& self, const int nSceneID, const int nGroupID)
+{
+	NF_SHARE_PTR<NFIObject> xObject = GetElement(self);
+	NFPropertyIndex* pIndex = GetPropertyIndex(nSceneID, nGroupID);
+	if (!xObject || !pIndex || mxIndexProperty.empty())
+	{
+		return false;
+	}
+
+	//the handles run out after 2^20 objects, the queries of the index would not find this one
+	const NFUINT32 nHandle = GetHandle(self);
+	if (0 == nHandle)
+	{
+		m_pLogModule->LogObject(NFILogModule::NLL_ERROR_NORMAL, self, "no handle, the property index misses the object", __FUNCTION__, __LINE__);
+		return false;
+	}
+
+	bool bAdd = false;
+	NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = xObject->GetPropertyManager();
+	for (int nSlot = 0; nSlot < pPropertyManager->GetPropertySlotCount(); ++nSlot)
+	{
+		NF_SHARE_PTR<NFIProperty> xProperty = pPropertyManager->GetPropertyBySlot(nSlot);
+		if (xProperty && xProperty->GetIndex() && mxIndexProperty.find(xProperty->GetKey()) != mxIndexProperty.end())
+		{
+			bAdd = pIndex->AddObject(xProperty->GetKey(), nHandle, xProperty->GetValue()) || bAdd;
+		}
+	}
+
+	return bAdd;
+}
+
+bool NFCKernelModule::RemovePropertyIndex(const NFGUID& self, const int nSceneID, const int nGroupID)
+{
+	NF_SHARE_PTR<NFIObject> xObject = GetElement(self);
+	NFPropertyIndex* pIndex = GetPropertyIndex(nSceneID, nGroupID);
+	if (!xObject || !pIndex || mxIndexProperty.empty())
+	{
+		return false;
+	}
+
+	bool bRemove = false;
+	const NFUINT32 nHandle = GetHandle(self);
+	NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = xObject->GetPropertyManager();
+	for (int nSlot = 0; nSlot < pPropertyManager->GetPropertySlotCount(); ++nSlot)
+	{
+		NF_SHARE_PTR<NFIProperty> xProperty = pPropertyManager->GetPropertyBySlot(nSlot);
+		if (xProperty && xProperty->GetIndex() && mxIndexProperty.find(xProperty->GetKey()) != mxIndexProperty.end())
+		{
+			bRemove = pIndex->RemoveObject(xProperty->GetKey(), nHandle, xProperty->GetValue()) || bRemove;
+		}
+	}
+
+	return bRemove;
+}
+
 NF_SHARE_PTR<NFIObject> NFCKernelModule::GetObject(const NFGUID& ident)
 {
     return GetElement(ident);
 }
 
+NFUINT32 NFCKernelModule::GetObjectHandle(const NFGUID& ident)
+{
+    return GetHandle(ident);
+}
+
+NF_SHARE_PTR<NFIObject> NFCKernelModule::GetObject(const NFUINT32 nHandle)
+{
+    return GetElementByHandle(nHandle);
+}
+
 int NFCKernelModule::GetObjectByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFDataList& valueArg, NFDataList& list)
 {
+    const NFData* pValue = valueArg.GetStack(0);
+    if (!pValue)
+    {
+        return list.GetCount();
+    }
+
+    //an indexed property never needs the scan, no handle there means no object has that value
+    if (mxIndexProperty.find(strPropertyName) != mxIndexProperty.end())
+    {
+        const std::vector<NFUINT32>* pHandleList = GetObjectHandleByProperty(nSceneID, nGroupID, strPropertyName, *pValue);
+        for (int i = 0; pHandleList && i < (int)pHandleList->size(); ++i)
+        {
+            const NFGUID* pIdent = GetKeyByHandle((*pHandleList)[i]);
+            if (pIdent)
+            {
+                list.Add(*pIdent);
+            }
+        }
+
+        return list.GetCount();
+    }
+
     NFDataList varObjectList;
 	GetGroupObjectList(nSceneID, nGroupID, varObjectList);
 
@@ -1302,9 +1880,8 @@ int NFCKernelModule::GetObjectByProperty(const int nSceneID, const int nGroupID,
                 break;
                 case TDATA_STRING:
                 {
-                    std::string strValue = GetPropertyString(ident, strPropertyName.c_str());
-                    std::string strCompareValue = valueArg.String(0);
-                    if (strValue == strCompareValue)
+                    const std::string& strValue = GetPropertyString(ident, strPropertyName);
+                    if (strValue == valueArg.String(0))
                     {
                         list.Add(ident);
                     }
@@ -1328,6 +1905,22 @@ int NFCKernelModule::GetObjectByProperty(const int nSceneID, const int nGroupID,
     return list.GetCount();
 }
 
+const std::vector<NFUINT32>* NFCKernelModule::GetObjectHandleByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFData& xValue)
+{
+    if (mxIndexProperty.find(strPropertyName) == mxIndexProperty.end())
+    {
+        return NULL;
+    }
+
+    NFPropertyIndex* pIndex = GetPropertyIndex(nSceneID, nGroupID);
+    if (!pIndex)
+    {
+        return NULL;
+    }
+
+    return pIndex->GetObjectList(strPropertyName, xValue);
+}
+
 bool NFCKernelModule::ExistScene(const int nSceneID)
 {
     NF_SHARE_PTR<NFCSceneInfo> pSceneInfo = m_pSceneModule->GetElement(nSceneID);
@@ -1414,9 +2007,17 @@ bool NFCKernelModule::RegisterCommonClassEvent(const CLASS_EVENT_FUNCTOR_PTR& cb
     return true;
 }
 
-bool NFCKernelModule::RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb)
+bool NFCKernelModule::RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb, const int nMask)
 {
     mtCommonPropertyCallBackList.push_back(cb);
+    mnCommonPropertyMask |= nMask;
+    return true;
+}
+
+bool NFCKernelModule::RegisterCommonPropertyBatchEvent(const PROPERTY_BATCH_EVENT_FUNCTOR_PTR& cb, const int nMask)
+{
+    mxPropertyBatchCallBackList.push_back(cb);
+    mnPropertyBatchMask |= nMask;
     return true;
 }
 
@@ -1426,8 +2027,10 @@ bool NFCKernelModule::RegisterCommonRecordEvent(const RECORD_EVENT_FUNCTOR_PTR&
     return true;
 }
 
-bool NFCKernelModule::RegisterClassPropertyEvent(const std::string & strClassName, const PROPERTY_EVENT_FUNCTOR_PTR & cb)
+bool NFCKernelModule::RegisterClassPropertyEvent(const std::string & strClassName, const PROPERTY_EVENT_FUNCTOR_PTR & cb, const int nMask)
 {
+	mxClassPropertyMask[strClassName] |= nMask;
+
 	if (mtClassPropertyCallBackList.find(strClassName) == mtClassPropertyCallBackList.end())
 	{
 		std::list<PROPERTY_EVENT_FUNCTOR_PTR> xList;
@@ -1481,17 +2084,55 @@ bool NFCKernelModule::AfterInit()
         pClass = m_pClassModule->Next();
     }
 
+    //a property some class does not index can not be looked up, the index would miss the objects of that class
+    std::map<std::string, bool> xIndexProperty;
+    for (pClass = m_pClassModule->First(); pClass; pClass = m_pClassModule->Next())
+    {
+        NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pClass->GetPropertyManager();
+        for (NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->First(); pProperty; pProperty = pPropertyManager->Next())
+        {
+            std::map<std::string, bool>::iterator it = xIndexProperty.find(pProperty->GetKey());
+            if (it == xIndexProperty.end())
+            {
+                xIndexProperty[pProperty->GetKey()] = pProperty->GetIndex();
+            }
+            else if (it->second != pProperty->GetIndex())
+            {
+                m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "not indexed in every class", pProperty->GetKey(), __FUNCTION__, __LINE__);
+                it->second = false;
+            }
+        }
+    }
+
+    for (std::map<std::string, bool>::iterator it = xIndexProperty.begin(); it != xIndexProperty.end(); ++it)
+    {
+        if (it->second)
+        {
+            mxIndexProperty.insert(it->first);
+        }
+    }
+
+    for (pClass = m_pClassModule->First(); pClass; pClass = m_pClassModule->Next())
+    {
+        NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pClass->GetPropertyManager();
+        for (NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->First(); pProperty; pProperty = pPropertyManager->Next())
+        {
+            if (mxIndexProperty.find(pProperty->GetKey()) != mxIndexProperty.end())
+            {
+                mxIndexClass.insert(pClass->GetClassName());
+                break;
+            }
+        }
+    }
+
     return true;
 }
 
 bool NFCKernelModule::DestroyAll()
 {
-    NF_SHARE_PTR<NFIObject> pObject = First();
-    while (pObject)
+    for (Entry& xEntry : *this)
     {
-        mtDeleteSelfList.push_back(pObject->Self());
-
-        pObject = Next();
+        mtDeleteSelfList.push_back(xEntry.first);
     }
 
     
@@ -1514,12 +2155,19 @@ bool NFCKernelModule::BeforeShut()
 	mtClassPropertyCallBackList.clear();
 	mtClassRecordCallBackList.clear();
 
+	mnCommonPropertyMask = 0;
+	mxClassPropertyMask.clear();
+
+	mxPropertyBatchCallBackList.clear();
+	mnPropertyBatchMask = 0;
+	mxPropertyBatch.clear();
+
     return true;
 }
 
 void NFCKernelModule::Random(int nStart, int nEnd, int nCount, NFDataList& valueList)
 {
-    if (mnRandomPos + nCount >= mvRandom.size())
+    if (mnRandomPos + nCount >= (int)mvRandom.size())
     {
         mnRandomPos = 0;
     }
@@ -1536,7 +2184,7 @@ void NFCKernelModule::Random(int nStart, int nEnd, int nCount, NFDataList& value
 
 int NFCKernelModule::Random(int nStart, int nEnd)
 {
-	if (mnRandomPos + 1 >= mvRandom.size())
+	if (mnRandomPos + 1 >= (int)mvRandom.size())
 	{
 		mnRandomPos = 0;
 	}
@@ -1552,7 +2200,7 @@ float NFCKernelModule::Random()
 {
 	mnRandomPos++;
 
-	if (mnRandomPos + 1 >= mvRandom.size())
+	if (mnRandomPos + 1 >= (int)mvRandom.size())
 	{
 		mnRandomPos = 0;
 	}
@@ -14,9 +14,11 @@
 #include <string>
 #include <random>
 #include <chrono>
+#include <set>
 #include "NFComm/NFCore/NFIObject.h"
 #include "NFComm/NFCore/NFDataList.hpp"
 #include "NFComm/NFCore/NFIRecord.h"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
 #include "NFComm/NFPluginModule/NFGUID.h"
 #include "NFComm/NFPluginModule/NFILogModule.h"
 #include "NFComm/NFPluginModule/NFIKernelModule.h"
@@ -29,7 +31,7 @@
 
 class NFCKernelModule
     : public NFIKernelModule,
-  public NFMapEx<NFGUID, NFIObject>
+  public NFHashMapEx<NFGUID, NFIObject>
 {
 public:
     NFCKernelModule(NFIPluginManager* p);
@@ -51,6 +53,8 @@ public:
 	virtual bool ExistObject(const NFGUID& ident, const int nSceneID, const int nGroupID);
 
     virtual NF_SHARE_PTR<NFIObject> GetObject(const NFGUID& ident);
+    virtual NFUINT32 GetObjectHandle(const NFGUID& ident);
+    virtual NF_SHARE_PTR<NFIObject> GetObject(const NFUINT32 nHandle);
     virtual NF_SHARE_PTR<NFIObject> CreateObject(const NFGUID& self, const int nSceneID, const int nGroupID, const std::string& strClassName, const std::string& strConfigIndex, const NFDataList& arg);
 
     virtual bool DestroyAll();
@@ -71,9 +75,39 @@ public:
 	virtual int GetPropertyInt32(const NFGUID& self, const std::string& strPropertyName);	//equal to (int)GetPropertyInt(...), to remove C4244 warning
     virtual double GetPropertyFloat(const NFGUID& self, const std::string& strPropertyName);
     virtual const std::string& GetPropertyString(const NFGUID& self, const std::string& strPropertyName);
-    virtual const NFGUID& GetPropertyObject(const NFGUID& self, const std::string& strPropertyName);
-	virtual const NFVector2& GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName);
-	virtual const NFVector3& GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName);
+    virtual NFGUID GetPropertyObject(const NFGUID& self, const std::string& strPropertyName);
+	virtual NFVector2 GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName);
+	virtual NFVector3 GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName);
+
+    virtual bool SetPropertyInt(const NFGUID& self, const int nSlot, const NFINT64 nValue);
+    virtual bool SetPropertyFloat(const NFGUID& self, const int nSlot, const double dValue);
+    virtual bool SetPropertyString(const NFGUID& self, const int nSlot, const std::string& strValue);
+    virtual bool SetPropertyObject(const NFGUID& self, const int nSlot, const NFGUID& objectValue);
+    virtual bool SetPropertyVector2(const NFGUID& self, const int nSlot, const NFVector2& value);
+    virtual bool SetPropertyVector3(const NFGUID& self, const int nSlot, const NFVector3& value);
+
+    virtual NFINT64 GetPropertyInt(const NFGUID& self, const int nSlot);
+    virtual int GetPropertyInt32(const NFGUID& self, const int nSlot);
+    virtual double GetPropertyFloat(const NFGUID& self, const int nSlot);
+    virtual const std::string& GetPropertyString(const NFGUID& self, const int nSlot);
+    virtual NFGUID GetPropertyObject(const NFGUID& self, const int nSlot);
+    virtual NFVector2 GetPropertyVector2(const NFGUID& self, const int nSlot);
+    virtual NFVector3 GetPropertyVector3(const NFGUID& self, const int nSlot);
+
+    virtual bool SetPropertyInt(const NFUINT32 nHandle, const int nSlot, const NFINT64 nValue);
+    virtual bool SetPropertyFloat(const NFUINT32 nHandle, const int nSlot, const double dValue);
+    virtual bool SetPropertyString(const NFUINT32 nHandle, const int nSlot, const std::string& strValue);
+    virtual bool SetPropertyObject(const NFUINT32 nHandle, const int nSlot, const NFGUID& objectValue);
+    virtual bool SetPropertyVector2(const NFUINT32 nHandle, const int nSlot, const NFVector2& value);
+    virtual bool SetPropertyVector3(const NFUINT32 nHandle, const int nSlot, const NFVector3& value);
+
+    virtual NFINT64 GetPropertyInt(const NFUINT32 nHandle, const int nSlot);
+    virtual int GetPropertyInt32(const NFUINT32 nHandle, const int nSlot);
+    virtual double GetPropertyFloat(const NFUINT32 nHandle, const int nSlot);
+    virtual const std::string& GetPropertyString(const NFUINT32 nHandle, const int nSlot);
+    virtual NFGUID GetPropertyObject(const NFUINT32 nHandle, const int nSlot);
+    virtual NFVector2 GetPropertyVector2(const NFUINT32 nHandle, const int nSlot);
+    virtual NFVector3 GetPropertyVector3(const NFUINT32 nHandle, const int nSlot);
 
     //////////////////////////////////////////////////////////////////////////
     virtual NF_SHARE_PTR<NFIRecord> FindRecord(const NFGUID& self, const std::string& strRecordName);
@@ -128,6 +162,7 @@ public:
 	virtual bool GetGroupObjectList(const int nSceneID, const int nGroupID, const std::string& strClassName, NFDataList& list, const NFGUID& noSelf);
 	
 	virtual int GetObjectByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFDataList& valueArgArg, NFDataList& list);
+	virtual const std::vector<NFUINT32>* GetObjectHandleByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFData& xValue);
 
 	virtual void Random(int nStart, int nEnd, int nCount, NFDataList& valueList);		//return [nStart, nEnd)
 	virtual int Random(int nStart, int nEnd);											//return [nStart, nEnd)
@@ -146,10 +181,11 @@ protected:
 
     
     virtual bool RegisterCommonClassEvent(const CLASS_EVENT_FUNCTOR_PTR& cb);
-    virtual bool RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb);
+    virtual bool RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb, const int nMask);
+    virtual bool RegisterCommonPropertyBatchEvent(const PROPERTY_BATCH_EVENT_FUNCTOR_PTR& cb, const int nMask);
     virtual bool RegisterCommonRecordEvent(const RECORD_EVENT_FUNCTOR_PTR& cb);
 
-	virtual bool RegisterClassPropertyEvent(const std::string& strClassName, const PROPERTY_EVENT_FUNCTOR_PTR& cb);
+	virtual bool RegisterClassPropertyEvent(const std::string& strClassName, const PROPERTY_EVENT_FUNCTOR_PTR& cb, const int nMask);
 	virtual bool RegisterClassRecordEvent(const std::string& strClassName, const RECORD_EVENT_FUNCTOR_PTR& cb);
 protected:
 
@@ -160,6 +196,15 @@ protected:
     int OnClassCommonEvent(const NFGUID& self, const std::string& strClassName, const CLASS_OBJECT_EVENT eClassEvent, const NFDataList& var);
     int OnPropertyCommonEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar);
     int OnRecordCommonEvent(const NFGUID& self, const RECORD_EVENT_DATA& xEventData, const NFData& oldVar, const NFData& newVar);
+    int OnPropertyIndexEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar);
+    int OnPropertyBatchEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar);
+
+    void ProcessPropertyBatch();
+
+    NFPropertyIndex* GetPropertyIndex(const int nSceneID, const int nGroupID);
+    //all the indexed values of self into or out of the index of a group, false if nothing was added or removed
+    bool AddPropertyIndex(const NFGUID& self, const int nSceneID, const int nGroupID);
+    bool RemovePropertyIndex(const NFGUID& self, const int nSceneID, const int nGroupID);
 
     void ProcessMemFree();
 
@@ -176,6 +221,29 @@ protected:
 	std::map<std::string, std::list<PROPERTY_EVENT_FUNCTOR_PTR>> mtClassPropertyCallBackList;
 	std::map<std::string, std::list<RECORD_EVENT_FUNCTOR_PTR>> mtClassRecordCallBackList;
 
+	//the property flags the listeners above want, the other properties never raise OnPropertyCommonEvent
+	int mnCommonPropertyMask;
+
+	//what every object hooks to raise the common events above
+	PROPERTY_EVENT_FUNCTOR_PTR mxCommonPropertyEvent;
+	RECORD_EVENT_FUNCTOR_PTR mxCommonRecordEvent;
+	std::map<std::string, int> mxClassPropertyMask;
+
+	//the properties indexed in every class that has them, and the classes that have one of them
+	//the SceneID and GroupID of those classes are hooked as well, to move the values between the groups
+	std::set<std::string> mxIndexProperty;
+	std::set<std::string> mxIndexClass;
+	PROPERTY_EVENT_FUNCTOR_PTR mxIndexPropertyEvent;
+
+	//the changes of the properties the batch listeners want, delivered at the end of Execute
+	//the changes made while delivering wait for the next frame
+	std::vector<PROPERTY_BATCH_EVENT_FUNCTOR_PTR> mxPropertyBatchCallBackList;
+	int mnPropertyBatchMask;
+	PROPERTY_EVENT_FUNCTOR_PTR mxPropertyBatchEvent;
+	std::vector<std::pair<NFGUID, int>> mxPropertyBatch;
+	std::vector<std::pair<NFGUID, int>> mxPropertyBatchRun;
+	std::vector<int> mxPropertyBatchSlot;
+
 private:
     std::vector<float> mvRandom;
 	int nGUIDIndex;
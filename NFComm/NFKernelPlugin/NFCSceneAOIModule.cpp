@@ -18,7 +18,8 @@ bool NFCSceneAOIModule::Init()
 	m_pEventModule = pPluginManager->FindModule<NFIEventModule>();
 
 	m_pKernelModule->RegisterCommonClassEvent(this, &NFCSceneAOIModule::OnClassCommonEvent);
-	m_pKernelModule->RegisterCommonPropertyEvent(this, &NFCSceneAOIModule::OnPropertyCommonEvent);
+	//GroupID and SceneID are private, the rest is only broadcast when public or private
+	m_pKernelModule->RegisterCommonPropertyEvent(this, &NFCSceneAOIModule::OnPropertyCommonEvent, NF_PROPERTY_MASK_PUBLIC | NF_PROPERTY_MASK_PRIVATE);
 	m_pKernelModule->RegisterCommonRecordEvent(this, &NFCSceneAOIModule::OnRecordCommonEvent);
 
 	//init all scene
@@ -41,7 +42,26 @@ bool NFCSceneAOIModule::Init()
 
 bool NFCSceneAOIModule::AfterInit()
 {
-	
+	//the scenes with a view range only broadcast to the 3x3 cells of that size around an object
+	NF_SHARE_PTR<NFCSceneInfo> pSceneInfo = First();
+	while (pSceneInfo)
+	{
+		const std::string strSceneID = std::to_string(pSceneInfo->mnSceneID);
+		const int nWidth = m_pElementModule->GetPropertyInt32(strSceneID, NFrame::Scene::Width());
+		if (nWidth > 0)
+		{
+			pSceneInfo->SetWidth(nWidth);
+		}
+
+		const int nViewRange = m_pElementModule->GetPropertyInt32(strSceneID, NFrame::Scene::ViewRange());
+		if (nViewRange > 0)
+		{
+			pSceneInfo->SetViewRange(nViewRange);
+		}
+
+		pSceneInfo = Next();
+	}
+
     return true;
 }
 
@@ -313,6 +333,14 @@ bool NFCSceneAOIModule::DestroySceneNPC(const int nSceneID, const int nGroupID)
 	return false;
 }
 
+bool NFCSceneAOIModule::GetViewObjectList(const NFGUID & self, NFDataList & list, const bool bPlayer, const NFGUID & noSelf)
+{
+	const int nSceneID = m_pKernelModule->GetPropertyInt32(self, NFrame::IObject::SceneID());
+	const int nGroupID = m_pKernelModule->GetPropertyInt32(self, NFrame::IObject::GroupID());
+
+	return GetViewObjectList(nSceneID, nGroupID, self, list, bPlayer, noSelf);
+}
+
 bool NFCSceneAOIModule::RemoveSwapSceneEventCallBack()
 {
 	mtOnSwapSceneCallback.clear();
@@ -401,6 +429,11 @@ int NFCSceneAOIModule::OnPropertyCommonEvent(const NFGUID & self, const std::str
 		}
 	}
 
+	if (NFrame::IObject::Position() == strPropertyName)
+	{
+		OnObjectPositionEvent(self, strClassName == NFrame::Player::ThisName(), newVar.GetVector3());
+	}
+
 	NFDataList valueBroadCaseList;
 	if (GetBroadCastObject(self, strPropertyName, false, valueBroadCaseList) <= 0)
 	{
@@ -444,7 +477,13 @@ int NFCSceneAOIModule::OnClassCommonEvent(const NFGUID & self, const std::string
 		}
 
 		NFDataList valueAllPlayrNoSelfList;
-		m_pKernelModule->GetGroupObjectList(nObjectSceneID, nObjectGroupID, valueAllPlayrNoSelfList, true, self);
+		GetViewObjectList(nObjectSceneID, nObjectGroupID, self, valueAllPlayrNoSelfList, true, self);
+
+		NFViewGrid* pViewGrid = GetViewGrid(nObjectSceneID, nObjectGroupID);
+		if (pViewGrid)
+		{
+			pViewGrid->RemoveObject(self);
+		}
 
 		//tell other people that you want to leave from this scene or this group
 		//every one want to know you want to leave notmater you are a monster maybe you are a player
@@ -481,15 +520,17 @@ int NFCSceneAOIModule::OnClassCommonEvent(const NFGUID & self, const std::string
 				return 0;
 			}
 
+			NFViewGrid* pViewGrid = GetViewGrid(nObjectSceneID, nObjectGroupID);
+			if (pViewGrid)
+			{
+				pViewGrid->AddObject(self, false, m_pKernelModule->GetPropertyVector3(self, NFrame::IObject::Position()));
+			}
+
 			NFDataList valueAllPlayrObjectList;
-			m_pKernelModule->GetGroupObjectList(nObjectSceneID, nObjectGroupID, valueAllPlayrObjectList, true);
+			GetViewObjectList(nObjectSceneID, nObjectGroupID, self, valueAllPlayrObjectList, true, NFGUID());
 
 			//monster or others need to tell all player
-			OnObjectListEnter(valueAllPlayrObjectList, NFDataList() << self);
-			OnPropertyEnter(valueAllPlayrObjectList, self);
-			OnRecordEnter(valueAllPlayrObjectList, self);
-
-			OnObjectListEnterFinished(valueAllPlayrObjectList, NFDataList() << self);
+			OnObjectViewEnter(self, false, valueAllPlayrObjectList, NFDataList());
 
 		}
 	}
@@ -511,81 +552,42 @@ int NFCSceneAOIModule::OnPlayerGroupEvent(const NFGUID & self, const std::string
 	//example1: 0 -> 1 ==> new_group > 0 && old_group <= 0
 	//example2: 1 -> 2 ==> new_group > 0 && old_group > 0
 	//example3: 5 -> 0 ==> new_group <= 0 && old_group > 0
-	if (nNewGroupID > 0)
+	if (nOldGroupID > 0)
 	{
-		if (nOldGroupID > 0)
+		//example2 and example3
+		//step1: leave
+		NFDataList valueAllOldNPCListNoSelf;
+		NFDataList valueAllOldPlayerListNoSelf;
+		GetViewObjectList(nSceneID, nOldGroupID, self, valueAllOldNPCListNoSelf, false, self);
+		GetViewObjectList(nSceneID, nOldGroupID, self, valueAllOldPlayerListNoSelf, true, self);
+
+		NFViewGrid* pOldViewGrid = GetViewGrid(nSceneID, nOldGroupID);
+		if (pOldViewGrid)
 		{
-			//example2: 1 -> 2 ==> new_group > 0 && old_group > 0
-			//step1: leave
-			NFDataList valueAllOldNPCListNoSelf;
-			NFDataList valueAllOldPlayerListNoSelf;
-			m_pKernelModule->GetGroupObjectList(nSceneID, nOldGroupID, valueAllOldNPCListNoSelf, false, self);
-			m_pKernelModule->GetGroupObjectList(nSceneID, nOldGroupID, valueAllOldPlayerListNoSelf, true, self);
-
-			OnObjectListLeave(valueAllOldPlayerListNoSelf, NFDataList() << self);
-			OnObjectListLeave(NFDataList() << self, valueAllOldPlayerListNoSelf);
-			OnObjectListLeave(NFDataList() << self, valueAllOldNPCListNoSelf);
+			pOldViewGrid->RemoveObject(self);
 		}
-		else
+
+		OnObjectViewLeave(self, true, valueAllOldPlayerListNoSelf, valueAllOldNPCListNoSelf);
+	}
+
+	if (nNewGroupID > 0)
+	{
+		//example1: 0 -> 1 == > new_group > 0 && old_group <= 0
+		//only use step2 that enough
+		NFViewGrid* pNewViewGrid = GetViewGrid(nSceneID, nNewGroupID);
+		if (pNewViewGrid)
 		{
-			//example1: 0 -> 1 == > new_group > 0 && old_group <= 0
-			//only use step2 that enough
+			pNewViewGrid->AddObject(self, true, m_pKernelModule->GetPropertyVector3(self, NFrame::IObject::Position()));
 		}
 
 		//step2: enter
 		NFDataList valueAllNewNPCListNoSelf;
 		NFDataList valueAllNewPlayerListNoSelf;
 
-		m_pKernelModule->GetGroupObjectList(nSceneID, nNewGroupID, valueAllNewNPCListNoSelf, false, self);
-		m_pKernelModule->GetGroupObjectList(nSceneID, nNewGroupID, valueAllNewPlayerListNoSelf, true, self);
+		GetViewObjectList(nSceneID, nNewGroupID, self, valueAllNewNPCListNoSelf, false, self);
+		GetViewObjectList(nSceneID, nNewGroupID, self, valueAllNewPlayerListNoSelf, true, self);
 
-		OnObjectListEnter(valueAllNewPlayerListNoSelf, NFDataList() << self);
-		OnObjectListEnter(NFDataList() << self, valueAllNewPlayerListNoSelf);
-		OnObjectListEnter(NFDataList() << self, valueAllNewNPCListNoSelf);
-
-		//bc others data to u
-		for (int i = 0; i < valueAllNewNPCListNoSelf.GetCount(); i++)
-		{
-			NFGUID identOld = valueAllNewNPCListNoSelf.Object(i);
-
-			OnPropertyEnter(NFDataList() << self, identOld);
-			OnRecordEnter(NFDataList() << self, identOld);
-
-			OnObjectListEnterFinished(NFDataList() << self, NFDataList() << identOld);
-		}
-
-		//bc others data to u
-		for (int i = 0; i < valueAllNewPlayerListNoSelf.GetCount(); i++)
-		{
-			NFGUID identOld = valueAllNewPlayerListNoSelf.Object(i);
-
-			OnPropertyEnter(NFDataList() << self, identOld);
-			OnRecordEnter(NFDataList() << self, identOld);
-
-			OnObjectListEnterFinished(NFDataList() << self, NFDataList() << identOld);
-		}
-
-		//bc u data to others
-		OnPropertyEnter(valueAllNewPlayerListNoSelf, self);
-		OnRecordEnter(valueAllNewPlayerListNoSelf, self);
-
-		OnObjectListEnterFinished(valueAllNewPlayerListNoSelf, NFDataList() << self);
-	}
-	else
-	{
-		if (nOldGroupID > 0)
-		{
-			//example3: 5 -> 0 ==> new_group <= 0 && old_group > 0
-			//step1: leave
-			NFDataList valueAllOldNPCListNoSelf;
-			NFDataList valueAllOldPlayerListNoSelf;
-			m_pKernelModule->GetGroupObjectList(nSceneID, nOldGroupID, valueAllOldNPCListNoSelf, false, self);
-			m_pKernelModule->GetGroupObjectList(nSceneID, nOldGroupID, valueAllOldPlayerListNoSelf, true, self);
-
-			OnObjectListLeave(valueAllOldPlayerListNoSelf, NFDataList() << self);
-			OnObjectListLeave(NFDataList() << self, valueAllOldPlayerListNoSelf);
-			OnObjectListLeave(NFDataList() << self, valueAllOldNPCListNoSelf);
-		}
+		OnObjectViewEnter(self, true, valueAllNewPlayerListNoSelf, valueAllNewNPCListNoSelf);
 	}
 
 	return 0;
@@ -603,6 +605,40 @@ int NFCSceneAOIModule::OnPlayerSceneEvent(const NFGUID & self, const std::string
 	return 0;
 }
 
+int NFCSceneAOIModule::OnObjectPositionEvent(const NFGUID & self, const bool bPlayer, const NFVector3 & vPos)
+{
+	const int nSceneID = m_pKernelModule->GetPropertyInt32(self, NFrame::IObject::SceneID());
+	const int nGroupID = m_pKernelModule->GetPropertyInt32(self, NFrame::IObject::GroupID());
+
+	NFViewGrid* pViewGrid = GetViewGrid(nSceneID, nGroupID);
+	if (!pViewGrid)
+	{
+		return 0;
+	}
+
+	//only the objects of the cells that come into or go out of the view
+	NFDataList valueEnterPlayerList;
+	NFDataList valueEnterOtherList;
+	NFDataList valueLeavePlayerList;
+	NFDataList valueLeaveOtherList;
+	if (!pViewGrid->MoveObject(self, vPos, valueEnterPlayerList, valueEnterOtherList, valueLeavePlayerList, valueLeaveOtherList))
+	{
+		return 0;
+	}
+
+	if (valueLeavePlayerList.GetCount() > 0 || valueLeaveOtherList.GetCount() > 0)
+	{
+		OnObjectViewLeave(self, bPlayer, valueLeavePlayerList, valueLeaveOtherList);
+	}
+
+	if (valueEnterPlayerList.GetCount() > 0 || valueEnterOtherList.GetCount() > 0)
+	{
+		OnObjectViewEnter(self, bPlayer, valueEnterPlayerList, valueEnterOtherList);
+	}
+
+	return 0;
+}
+
 int NFCSceneAOIModule::GetBroadCastObject(const NFGUID & self, const std::string & strPropertyName, const bool bTable, NFDataList & valueObject)
 {
 	int nObjectContainerID = m_pKernelModule->GetPropertyInt32(self, NFrame::IObject::SceneID());
@@ -647,7 +683,7 @@ int NFCSceneAOIModule::GetBroadCastObject(const NFGUID & self, const std::string
 		{
 			if (pRecord->GetPublic())
 			{
-				m_pKernelModule->GetGroupObjectList(nObjectContainerID, nObjectGroupID, valueObject, true, self);
+				GetViewObjectList(nObjectContainerID, nObjectGroupID, self, valueObject, true, self);
 			}
 
 			if (pRecord->GetPrivate())
@@ -663,7 +699,7 @@ int NFCSceneAOIModule::GetBroadCastObject(const NFGUID & self, const std::string
 		{
 			if (pProperty->GetPublic())
 			{
-				m_pKernelModule->GetGroupObjectList(nObjectContainerID, nObjectGroupID, valueObject, true, self);
+				GetViewObjectList(nObjectContainerID, nObjectGroupID, self, valueObject, true, self);
 			}
 
 			if (pProperty->GetPrivate())
@@ -676,6 +712,34 @@ int NFCSceneAOIModule::GetBroadCastObject(const NFGUID & self, const std::string
 	return valueObject.GetCount();
 }
 
+NFViewGrid* NFCSceneAOIModule::GetViewGrid(const int nSceneID, const int nGroupID)
+{
+	NFCSceneInfo* pSceneInfo = GetElementNude(nSceneID);
+	if (pSceneInfo)
+	{
+		NFCSceneGroupInfo* pGroupInfo = pSceneInfo->GetElementNude(nGroupID);
+		if (pGroupInfo && pGroupInfo->mxViewGrid.Enable())
+		{
+			return &pGroupInfo->mxViewGrid;
+		}
+	}
+
+	return NULL;
+}
+
+bool NFCSceneAOIModule::GetViewObjectList(const int nSceneID, const int nGroupID, const NFGUID & self, NFDataList & list, const bool bPlayer, const NFGUID & noSelf)
+{
+	NFViewGrid* pViewGrid = GetViewGrid(nSceneID, nGroupID);
+	if (pViewGrid)
+	{
+		//nobody sees an object that is not in the grid yet
+		pViewGrid->GetViewList(self, list, bPlayer, noSelf);
+		return true;
+	}
+
+	return m_pKernelModule->GetGroupObjectList(nSceneID, nGroupID, list, bPlayer, noSelf);
+}
+
 int NFCSceneAOIModule::EnterSceneCondition(const NFGUID & self, const int nSceneID, const int nGroupID, const int nType, const NFDataList & argList)
 {
 	std::vector<SCENE_EVENT_FUNCTOR_PTR>::iterator it = mtEnterSceneConditionCallback.begin();
@@ -794,6 +858,60 @@ int NFCSceneAOIModule::OnObjectListLeave(const NFDataList & self, const NFDataLi
 	return 0;
 }
 
+int NFCSceneAOIModule::OnObjectViewEnter(const NFGUID & self, const bool bPlayer, const NFDataList & xPlayerList, const NFDataList & xOtherList)
+{
+	OnObjectListEnter(xPlayerList, NFDataList() << self);
+
+	if (bPlayer)
+	{
+		OnObjectListEnter(NFDataList() << self, xPlayerList);
+		OnObjectListEnter(NFDataList() << self, xOtherList);
+
+		//bc others data to u
+		for (int i = 0; i < xOtherList.GetCount(); i++)
+		{
+			NFGUID identOld = xOtherList.Object(i);
+
+			OnPropertyEnter(NFDataList() << self, identOld);
+			OnRecordEnter(NFDataList() << self, identOld);
+
+			OnObjectListEnterFinished(NFDataList() << self, NFDataList() << identOld);
+		}
+
+		//bc others data to u
+		for (int i = 0; i < xPlayerList.GetCount(); i++)
+		{
+			NFGUID identOld = xPlayerList.Object(i);
+
+			OnPropertyEnter(NFDataList() << self, identOld);
+			OnRecordEnter(NFDataList() << self, identOld);
+
+			OnObjectListEnterFinished(NFDataList() << self, NFDataList() << identOld);
+		}
+	}
+
+	//bc u data to others
+	OnPropertyEnter(xPlayerList, self);
+	OnRecordEnter(xPlayerList, self);
+
+	OnObjectListEnterFinished(xPlayerList, NFDataList() << self);
+
+	return 0;
+}
+
+int NFCSceneAOIModule::OnObjectViewLeave(const NFGUID & self, const bool bPlayer, const NFDataList & xPlayerList, const NFDataList & xOtherList)
+{
+	OnObjectListLeave(xPlayerList, NFDataList() << self);
+
+	if (bPlayer)
+	{
+		OnObjectListLeave(NFDataList() << self, xPlayerList);
+		OnObjectListLeave(NFDataList() << self, xOtherList);
+	}
+
+	return 0;
+}
+
 int NFCSceneAOIModule::OnPropertyEnter(const NFDataList & argVar, const NFGUID & self)
 {
 	std::vector<PROPERTY_ENTER_EVENT_FUNCTOR_PTR>::iterator it = mtPropertyEnterCallback.begin();
@@ -51,6 +51,8 @@ public:
 	virtual bool CreateSceneNPC(const int nSceneID, const int nGroupID, const NFDataList& argList);
 	virtual bool DestroySceneNPC(const int nSceneID, const int nGroupID);
 
+	virtual bool GetViewObjectList(const NFGUID& self, NFDataList& list, const bool bPlayer, const NFGUID& noSelf = NFGUID());
+
 	virtual bool RemoveSwapSceneEventCallBack();
 
 protected:
@@ -82,8 +84,14 @@ protected:
 	int OnPlayerGroupEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar);
 	int OnPlayerSceneEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar);
 	
+	int OnObjectPositionEvent(const NFGUID& self, const bool bPlayer, const NFVector3& vPos);
+
 	int GetBroadCastObject(const NFGUID& self, const std::string& strPropertyName, const bool bTable, NFDataList& valueObject);
 
+	//NULL if the scene of the group has no view range
+	NFViewGrid* GetViewGrid(const int nSceneID, const int nGroupID);
+	bool GetViewObjectList(const int nSceneID, const int nGroupID, const NFGUID& self, NFDataList& list, const bool bPlayer, const NFGUID& noSelf);
+
 	int EnterSceneCondition(const NFGUID& self, const int nSceneID, const int nGroupID, const int nType, const NFDataList& argList);
 
 	int BeforeLeaveSceneGroup(const NFGUID& self, const int nSceneID, const int nGroupID, const int nType, const NFDataList& argList);
@@ -100,6 +108,10 @@ protected:
 
 	int OnObjectListLeave(const NFDataList& self, const NFDataList& argVar);
 
+	//self and the players and the others that start or stop seeing it, self only sees them if it is a player
+	int OnObjectViewEnter(const NFGUID& self, const bool bPlayer, const NFDataList& xPlayerList, const NFDataList& xOtherList);
+	int OnObjectViewLeave(const NFGUID& self, const bool bPlayer, const NFDataList& xPlayerList, const NFDataList& xOtherList);
+
 	//broad the data of self to argvar 
 	int OnPropertyEnter(const NFDataList& argVar, const NFGUID& self);
 	int OnRecordEnter(const NFDataList& argVar, const NFGUID& self);
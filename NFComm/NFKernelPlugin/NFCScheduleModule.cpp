@@ -6,6 +6,7 @@
 //
 // -------------------------------------------------------------------------
 
+#include <algorithm>
 #include "NFCScheduleModule.h"
 
 void NFCScheduleElement::DoHeartBeatEvent()
@@ -35,147 +36,183 @@ void NFCScheduleElement::DoHeartBeatEvent()
 NFCScheduleModule::NFCScheduleModule(NFIPluginManager* p)
 {
 	pPluginManager = p;
+	mnScheduleCount = 0;
 }
 
 NFCScheduleModule::~NFCScheduleModule()
 {
 	mObjectScheduleMap.ClearAll();
+	mModuleScheduleMap.clear();
+	mxScheduleSlot.clear();
+	mxTriggerHeap.clear();
 }
 
 bool NFCScheduleModule::Init()
 {
 	return true;
 }
+
 bool NFCScheduleModule::Execute()
 {
-	//execute every schedule
-	NF_SHARE_PTR<NFMapEx <std::string, NFCScheduleElement >> xObjectSchedule = mObjectScheduleMap.First();
-	while (xObjectSchedule)
+	//execute the schedules that are due
+	const NFINT64 nNow = NFFrameTimeMS();
+	while (!mxTriggerHeap.empty() && nNow > mxTriggerHeap.front().nTriggerTime)
 	{
-		std::string str;
-		NF_SHARE_PTR<NFCScheduleElement> pSchedule = xObjectSchedule->First();
-		while (pSchedule)
+		ScheduleTrigger xTrigger = mxTriggerHeap.front();
+		std::pop_heap(mxTriggerHeap.begin(), mxTriggerHeap.end());
+		mxTriggerHeap.pop_back();
+
+		if (mxScheduleSlot[xTrigger.nIndex].nGeneration != xTrigger.nGeneration)
+		{
+			continue;
+		}
+
+		//the callback may remove it
+		NF_SHARE_PTR<NFCScheduleElement> pSchedule = mxScheduleSlot[xTrigger.nIndex].xElement;
+		if (pSchedule->mnRemainCount > 0 || pSchedule->mbForever == true)
 		{
-			NFINT64 nNow = NFGetTimeMS();
-			if (nNow > pSchedule->mnNextTriggerTime)
+			pSchedule->mnRemainCount--;
+			pSchedule->DoHeartBeatEvent();
+
+			if (mxScheduleSlot[xTrigger.nIndex].nGeneration != xTrigger.nGeneration)
 			{
-				if (pSchedule->mnRemainCount > 0 || pSchedule->mbForever == true)
-				{
-					pSchedule->mnRemainCount--;
-					pSchedule->DoHeartBeatEvent();
-
-					if (pSchedule->mnRemainCount <= 0 && pSchedule->mbForever == false)
-					{
-						mObjectRemoveList.insert(std::map<NFGUID, std::string>::value_type(pSchedule->self, pSchedule->mstrScheduleName));
-					}
-					else
-					{
-						NFINT64 nNextCostTime = NFINT64(pSchedule->mfIntervalTime * 1000) * (pSchedule->mnAllCount - pSchedule->mnRemainCount + 1);
-						pSchedule->mnNextTriggerTime = pSchedule->mnStartTime + nNextCostTime;
-					}
-				}
+				continue;
 			}
 
-			pSchedule = xObjectSchedule->Next();
+			if (pSchedule->mnRemainCount <= 0 && pSchedule->mbForever == false)
+			{
+				RemoveScheduleSlot(xTrigger.nIndex);
+			}
+			else
+			{
+				NFINT64 nNextCostTime = NFINT64(pSchedule->mfIntervalTime * 1000) * (pSchedule->mnAllCount - pSchedule->mnRemainCount + 1);
+				pSchedule->mnNextTriggerTime = pSchedule->mnStartTime + nNextCostTime;
+
+				xTrigger.nTriggerTime = pSchedule->mnNextTriggerTime;
+				mxFiredList.push_back(xTrigger);
+			}
 		}
+	}
 
-		xObjectSchedule = mObjectScheduleMap.Next();
+	for (size_t i = 0; i < mxFiredList.size(); ++i)
+	{
+		mxTriggerHeap.push_back(mxFiredList[i]);
+		std::push_heap(mxTriggerHeap.begin(), mxTriggerHeap.end());
 	}
+	mxFiredList.clear();
 
-	//remove schedule
-	for (std::map<NFGUID, std::string>::iterator it = mObjectRemoveList.begin(); it != mObjectRemoveList.end(); ++it)
+	//the stale triggers of removed schedules pile up if they are far from due, drop them
+	if (mxTriggerHeap.size() > (size_t)mnScheduleCount * 2 + 64)
 	{
-		NFGUID self = it->first;
-		std::string scheduleName = it->second;
-		auto findIter = mObjectScheduleMap.GetElement(self);
-		if (NULL != findIter)
+		std::vector<ScheduleTrigger> xTriggerList;
+		xTriggerList.reserve(mnScheduleCount);
+		for (size_t i = 0; i < mxTriggerHeap.size(); ++i)
 		{
-			findIter->RemoveElement(scheduleName);
-			if (findIter->Count() == 0)
+			if (mxScheduleSlot[mxTriggerHeap[i].nIndex].nGeneration == mxTriggerHeap[i].nGeneration)
 			{
-				mObjectScheduleMap.RemoveElement(self);
+				xTriggerList.push_back(mxTriggerHeap[i]);
 			}
 		}
+
+		std::make_heap(xTriggerList.begin(), xTriggerList.end());
+		mxTriggerHeap.swap(xTriggerList);
 	}
-	mObjectRemoveList.clear();
 
 	//add schedule
 	for (std::list<NFCScheduleElement>::iterator iter = mObjectAddList.begin(); iter != mObjectAddList.end(); ++iter)
 	{
-		NF_SHARE_PTR< NFMapEx <std::string, NFCScheduleElement >> xObjectScheduleMap = mObjectScheduleMap.GetElement(iter->self);
+		NF_SHARE_PTR<std::map<std::string, int>> xObjectScheduleMap = mObjectScheduleMap.GetElement(iter->self);
 		if (NULL == xObjectScheduleMap)
 		{
-			xObjectScheduleMap = NF_SHARE_PTR< NFMapEx <std::string, NFCScheduleElement >>(NF_NEW NFMapEx <std::string, NFCScheduleElement >());
+			xObjectScheduleMap = NF_SHARE_PTR<std::map<std::string, int>>(NF_NEW std::map<std::string, int>());
 			mObjectScheduleMap.AddElement(iter->self, xObjectScheduleMap);
 		}
 
-		NF_SHARE_PTR<NFCScheduleElement> xScheduleElement = xObjectScheduleMap->GetElement(iter->mstrScheduleName);
-		if (NULL == xScheduleElement)
+		if (xObjectScheduleMap->find(iter->mstrScheduleName) == xObjectScheduleMap->end())
 		{
-			xScheduleElement = NF_SHARE_PTR<NFCScheduleElement>(NF_NEW NFCScheduleElement());
-			*xScheduleElement = *iter;
-
-			xObjectScheduleMap->AddElement(iter->mstrScheduleName, xScheduleElement);
+			const int nIndex = AddScheduleSlot(*iter);
+			xObjectScheduleMap->insert(std::map<std::string, int>::value_type(iter->mstrScheduleName, nIndex));
 		}
 	}
 
 	mObjectAddList.clear();
 
-	////////////////////////////////////////////
-	//execute every schedule
-	NF_SHARE_PTR< NFCScheduleElement > xModuleSchedule = mModuleScheduleMap.First();
-	while (xModuleSchedule)
+	for (std::list<NFCScheduleElement>::iterator iter = mModuleAddList.begin(); iter != mModuleAddList.end(); ++iter)
 	{
-		NFINT64 nNow = NFGetTimeMS();
-		if (nNow > xModuleSchedule->mnNextTriggerTime)
+		std::map<std::string, int>::iterator it = mModuleScheduleMap.find(iter->mstrScheduleName);
+		if (it != mModuleScheduleMap.end())
 		{
-			if (xModuleSchedule->mnRemainCount > 0 || xModuleSchedule->mbForever == true)
-			{
-				xModuleSchedule->mnRemainCount--;
-				xModuleSchedule->DoHeartBeatEvent();
-
-				if (xModuleSchedule->mnRemainCount <= 0 && xModuleSchedule->mbForever == false)
-				{
-					mModuleRemoveList.push_back(xModuleSchedule->mstrScheduleName);
-				}
-				else
-				{
-					NFINT64 nNextCostTime = NFINT64(xModuleSchedule->mfIntervalTime * 1000) * (xModuleSchedule->mnAllCount - xModuleSchedule->mnRemainCount + 1);
-					xModuleSchedule->mnNextTriggerTime = xModuleSchedule->mnStartTime + nNextCostTime;
-				}
-			}
+			RemoveScheduleSlot(it->second);
 		}
 
-		xModuleSchedule = mModuleScheduleMap.Next();
+		mModuleScheduleMap[iter->mstrScheduleName] = AddScheduleSlot(*iter);
 	}
 
-	//remove schedule
-	for (std::list<std::string>::iterator it = mModuleRemoveList.begin(); it != mModuleRemoveList.end(); ++it)
+	mModuleAddList.clear();
+	return true;
+}
+
+int NFCScheduleModule::AddScheduleSlot(const NFCScheduleElement& xSchedule)
+{
+	int nIndex = 0;
+	if (!mxFreeSlot.empty())
 	{
-		const std::string& strSheduleName = *it;;
-		auto findIter = mModuleScheduleMap.GetElement(strSheduleName);
-		if (NULL != findIter)
-		{
-			mModuleScheduleMap.RemoveElement(strSheduleName);
-		}
+		nIndex = mxFreeSlot.back();
+		mxFreeSlot.pop_back();
+	}
+	else
+	{
+		nIndex = (int)mxScheduleSlot.size();
+		mxScheduleSlot.push_back(ScheduleSlot());
+		mxScheduleSlot[nIndex].nGeneration = 0;
 	}
-	mModuleRemoveList.clear();
 
-	//add schedule
-	for (std::list<NFCScheduleElement>::iterator iter = mModuleAddList.begin(); iter != mModuleAddList.end(); ++iter)
+	mxScheduleSlot[nIndex].xElement = NF_SHARE_PTR<NFCScheduleElement>(NF_NEW NFCScheduleElement());
+	*mxScheduleSlot[nIndex].xElement = xSchedule;
+	mnScheduleCount++;
+
+	PushTrigger(nIndex);
+
+	return nIndex;
+}
+
+void NFCScheduleModule::RemoveScheduleSlot(const int nIndex)
+{
+	ScheduleSlot& xSlot = mxScheduleSlot[nIndex];
+	const NFCScheduleElement& xSchedule = *xSlot.xElement;
+	if (xSchedule.self.IsNull())
+	{
+		mModuleScheduleMap.erase(xSchedule.mstrScheduleName);
+	}
+	else
 	{
-		NF_SHARE_PTR< NFCScheduleElement > xModuleScheduleMap = mModuleScheduleMap.GetElement(iter->mstrScheduleName);
-		if (NULL == xModuleScheduleMap)
+		std::map<std::string, int>* pObjectScheduleMap = mObjectScheduleMap.GetElementNude(xSchedule.self);
+		if (pObjectScheduleMap)
 		{
-			xModuleScheduleMap = NF_SHARE_PTR< NFCScheduleElement >(NF_NEW NFCScheduleElement());
-			mModuleScheduleMap.AddElement(iter->mstrScheduleName, xModuleScheduleMap);
+			pObjectScheduleMap->erase(xSchedule.mstrScheduleName);
+			if (pObjectScheduleMap->empty())
+			{
+				mObjectScheduleMap.RemoveElement(xSchedule.self);
+			}
 		}
-
-		*xModuleScheduleMap = *iter;
 	}
 
-	mModuleAddList.clear();
-	return true;
+	//the trigger in the heap goes stale with the generation
+	xSlot.xElement.reset();
+	xSlot.nGeneration++;
+	mxFreeSlot.push_back(nIndex);
+	mnScheduleCount--;
+}
+
+void NFCScheduleModule::PushTrigger(const int nIndex)
+{
+	ScheduleTrigger xTrigger;
+	xTrigger.nTriggerTime = mxScheduleSlot[nIndex].xElement->mnNextTriggerTime;
+	xTrigger.nIndex = nIndex;
+	xTrigger.nGeneration = mxScheduleSlot[nIndex].nGeneration;
+
+	mxTriggerHeap.push_back(xTrigger);
+	std::push_heap(mxTriggerHeap.begin(), mxTriggerHeap.end());
 }
 
 bool NFCScheduleModule::AddSchedule(const std::string & strScheduleName, const MODULE_SCHEDULE_FUNCTOR_PTR & cb, const float fTime, const int nCount)
@@ -183,8 +220,8 @@ bool NFCScheduleModule::AddSchedule(const std::string & strScheduleName, const M
 	NFCScheduleElement xSchedule;
 	xSchedule.mstrScheduleName = strScheduleName;
 	xSchedule.mfIntervalTime = fTime;
-	xSchedule.mnNextTriggerTime = NFGetTimeMS() + (NFINT64)(fTime * 1000);
-	xSchedule.mnStartTime = NFGetTimeMS();
+	xSchedule.mnNextTriggerTime = NFFrameTimeMS() + (NFINT64)(fTime * 1000);
+	xSchedule.mnStartTime = NFFrameTimeMS();
 	xSchedule.mnRemainCount = nCount;
 	xSchedule.mnAllCount = nCount;
 	xSchedule.self = NFGUID();
@@ -207,14 +244,31 @@ bool NFCScheduleModule::AddSchedule(const std::string & strScheduleName, const M
 
 bool NFCScheduleModule::RemoveSchedule(const std::string & strScheduleName)
 {
-	mModuleRemoveList.push_back(strScheduleName);
+	//one not added yet is dropped too
+	for (std::list<NFCScheduleElement>::iterator iter = mModuleAddList.begin(); iter != mModuleAddList.end();)
+	{
+		if (iter->mstrScheduleName == strScheduleName)
+		{
+			iter = mModuleAddList.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	std::map<std::string, int>::iterator it = mModuleScheduleMap.find(strScheduleName);
+	if (it != mModuleScheduleMap.end())
+	{
+		RemoveScheduleSlot(it->second);
+	}
 
 	return true;
 }
 
 bool NFCScheduleModule::ExistSchedule(const std::string & strScheduleName)
 {
-	return mModuleScheduleMap.ExistElement(strScheduleName);
+	return mModuleScheduleMap.find(strScheduleName) != mModuleScheduleMap.end();
 }
 
 bool NFCScheduleModule::AddSchedule(const NFGUID self, const std::string& strScheduleName, const OBJECT_SCHEDULE_FUNCTOR_PTR& cb, const float fTime, const int nCount)
@@ -222,8 +276,8 @@ bool NFCScheduleModule::AddSchedule(const NFGUID self, const std::string& strSch
 	NFCScheduleElement xSchedule;
 	xSchedule.mstrScheduleName = strScheduleName;
 	xSchedule.mfIntervalTime = fTime;
-	xSchedule.mnNextTriggerTime = NFGetTimeMS() + (NFINT64)(fTime * 1000);
-	xSchedule.mnStartTime = NFGetTimeMS();
+	xSchedule.mnNextTriggerTime = NFFrameTimeMS() + (NFINT64)(fTime * 1000);
+	xSchedule.mnStartTime = NFFrameTimeMS();
 	xSchedule.mnRemainCount = nCount;
 	xSchedule.mnAllCount = nCount;
 	xSchedule.self = self;
@@ -246,22 +300,68 @@ bool NFCScheduleModule::AddSchedule(const NFGUID self, const std::string & strSc
 
 bool NFCScheduleModule::RemoveSchedule(const NFGUID self)
 {
-	return mObjectScheduleMap.RemoveElement(self);
+	for (std::list<NFCScheduleElement>::iterator iter = mObjectAddList.begin(); iter != mObjectAddList.end();)
+	{
+		if (iter->self == self)
+		{
+			iter = mObjectAddList.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	NF_SHARE_PTR<std::map<std::string, int>> xObjectScheduleMap = mObjectScheduleMap.GetElement(self);
+	if (NULL == xObjectScheduleMap)
+	{
+		return false;
+	}
+
+	//out of the map first, so that RemoveScheduleSlot leaves the list we walk alone
+	mObjectScheduleMap.RemoveElement(self);
+	for (std::map<std::string, int>::iterator it = xObjectScheduleMap->begin(); it != xObjectScheduleMap->end(); ++it)
+	{
+		RemoveScheduleSlot(it->second);
+	}
+
+	return true;
 }
 
 bool NFCScheduleModule::RemoveSchedule(const NFGUID self, const std::string& strScheduleName)
 {
-	mObjectRemoveList.insert(std::map<NFGUID, std::string>::value_type(self, strScheduleName));
+	for (std::list<NFCScheduleElement>::iterator iter = mObjectAddList.begin(); iter != mObjectAddList.end();)
+	{
+		if (iter->self == self && iter->mstrScheduleName == strScheduleName)
+		{
+			iter = mObjectAddList.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	std::map<std::string, int>* pObjectScheduleMap = mObjectScheduleMap.GetElementNude(self);
+	if (pObjectScheduleMap)
+	{
+		std::map<std::string, int>::iterator it = pObjectScheduleMap->find(strScheduleName);
+		if (it != pObjectScheduleMap->end())
+		{
+			RemoveScheduleSlot(it->second);
+		}
+	}
+
 	return true;
 }
 
 bool NFCScheduleModule::ExistSchedule(const NFGUID self, const std::string& strScheduleName)
 {
-	NF_SHARE_PTR< NFMapEx <std::string, NFCScheduleElement >> xObjectScheduleMap = mObjectScheduleMap.GetElement(self);
-	if (NULL == xObjectScheduleMap)
+	std::map<std::string, int>* pObjectScheduleMap = mObjectScheduleMap.GetElementNude(self);
+	if (NULL == pObjectScheduleMap)
 	{
 		return false;
 	}
 
-	return xObjectScheduleMap->ExistElement(strScheduleName);
+	return pObjectScheduleMap->find(strScheduleName) != pObjectScheduleMap->end();
 }
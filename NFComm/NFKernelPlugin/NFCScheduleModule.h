@@ -9,8 +9,12 @@
 #ifndef NFC_SCHEDULE_MODULE_H
 #define NFC_SCHEDULE_MODULE_H
 
+#include <map>
+#include <list>
+#include <vector>
 #include "NFComm/NFCore/NFMap.hpp"
 #include "NFComm/NFCore/NFList.hpp"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
 #include "NFComm/NFCore/NFDataList.hpp"
 #include "NFComm/NFCore/NFDateTime.hpp"
 #include "NFComm/NFPluginModule/NFIScheduleModule.h"
@@ -74,14 +78,45 @@ public:
 
 
 protected:
-	NFMapEx<NFGUID, NFMapEx <std::string, NFCScheduleElement >> mObjectScheduleMap;//guid_scheduleName_element
+	struct ScheduleTrigger
+	{
+		NFINT64 nTriggerTime;
+		int nIndex;
+		//the generation of the slot when it was queued, a removed schedule leaves a stale one behind
+		NFUINT32 nGeneration;
+
+		//std heap is a max heap, the earliest trigger must be on top
+		bool operator<(const ScheduleTrigger& xOther) const
+		{
+			return nTriggerTime > xOther.nTriggerTime;
+		}
+	};
+
+	struct ScheduleSlot
+	{
+		NF_SHARE_PTR<NFCScheduleElement> xElement;
+		NFUINT32 nGeneration;
+	};
+
+	int AddScheduleSlot(const NFCScheduleElement& xSchedule);
+	void RemoveScheduleSlot(const int nIndex);
+	void PushTrigger(const int nIndex);
+
+protected:
+	std::vector<ScheduleSlot> mxScheduleSlot;
+	std::vector<int> mxFreeSlot;
+	int mnScheduleCount;
+
+	//min heap on the trigger time, only the schedules that are due are visited
+	std::vector<ScheduleTrigger> mxTriggerHeap;
+	//fired in this frame, queued again after the pass so that nothing fires twice in one frame
+	std::vector<ScheduleTrigger> mxFiredList;
+
+	NFHashMapEx<NFGUID, std::map<std::string, int>> mObjectScheduleMap;//guid_scheduleName_slot
 	std::list<NFCScheduleElement> mObjectAddList;
-	std::map<NFGUID, std::string> mObjectRemoveList;
 
-	NFMapEx <std::string, NFCScheduleElement > mModuleScheduleMap;//guid_scheduleName_element
+	std::map<std::string, int> mModuleScheduleMap;//scheduleName_slot
 	std::list<NFCScheduleElement> mModuleAddList;
-	std::list<std::string> mModuleRemoveList;
-	
 };
 
 #endif
\ No newline at end of file
@@ -32,6 +32,31 @@ namespace NFrame
 		static const std::string& ReverseReferType(){ static std::string x = "ReverseReferType"; return x; };// int
 		static const std::string& WashGroupID(){ static std::string x = "WashGroupID"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				DownSaveType = 6,
+				EffectClearOnDead = 7,
+				EffectTimeInterval = 8,
+				EffectTimeValue = 9,
+				EffectType = 10,
+				EffectValueReferType = 11,
+				EffectValueType = 12,
+				ReverseReferType = 13,
+				WashGroupID = 14,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class ConsumeData
@@ -54,6 +79,29 @@ namespace NFrame
 		static const std::string& SP(){ static std::string x = "SP"; return x; };// int
 		static const std::string& VIPEXP(){ static std::string x = "VIPEXP"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Diamond = 6,
+				EXP = 7,
+				Gold = 8,
+				HP = 9,
+				MP = 10,
+				SP = 11,
+				VIPEXP = 12,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class DescData
@@ -76,6 +124,29 @@ namespace NFrame
 		static const std::string& PrefabPath(){ static std::string x = "PrefabPath"; return x; };// string
 		static const std::string& ShowName(){ static std::string x = "ShowName"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Atlas = 6,
+				DescText = 7,
+				Icon = 8,
+				PerformanceEffect = 9,
+				PerformanceSound = 10,
+				PrefabPath = 11,
+				ShowName = 12,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class EffectData
@@ -123,6 +194,54 @@ namespace NFrame
 		static const std::string& SPREGEN(){ static std::string x = "SPREGEN"; return x; };// int
 		static const std::string& SUCKBLOOD(){ static std::string x = "SUCKBLOOD"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				ATK_DARK = 6,
+				ATK_FIRE = 7,
+				ATK_ICE = 8,
+				ATK_LIGHT = 9,
+				ATK_POISON = 10,
+				ATK_SPEED = 11,
+				ATK_VALUE = 12,
+				ATK_WIND = 13,
+				BUFF_GATE = 14,
+				CRITICAL = 15,
+				DEF_DARK = 16,
+				DEF_ICE = 17,
+				DEF_LIGHT = 18,
+				DEF_POISON = 19,
+				DEF_VALUE = 20,
+				DEF_WIND = 21,
+				HP = 22,
+				HPREGEN = 23,
+				MAGIC_GATE = 24,
+				MAXHP = 25,
+				MAXMP = 26,
+				MAXSP = 27,
+				MOVE_GATE = 28,
+				MOVE_SPEED = 29,
+				MP = 30,
+				MPREGEN = 31,
+				PHYSICAL_GATE = 32,
+				REFLECTDAMAGE = 33,
+				SKILL_GATE = 34,
+				SP = 35,
+				SPREGEN = 36,
+				SUCKBLOOD = 37,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Equip
@@ -156,6 +275,40 @@ namespace NFrame
 		static const std::string& SuitBuffID(){ static std::string x = "SuitBuffID"; return x; };// string
 		static const std::string& SuitID(){ static std::string x = "SuitID"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				BuyPrice = 6,
+				Desc = 7,
+				DropPrePath = 8,
+				EffectData = 9,
+				EnchantmentBuffList = 10,
+				Icon = 11,
+				IntensiveBuffList = 12,
+				ItemSubType = 13,
+				ItemType = 14,
+				Job = 15,
+				Level = 16,
+				PrefabPath = 17,
+				Quality = 18,
+				SalePrice = 19,
+				Sex = 20,
+				ShowName = 21,
+				SuitBuffID = 22,
+				SuitID = 23,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class GM
@@ -172,6 +325,23 @@ namespace NFrame
 		// Property
 		static const std::string& Level(){ static std::string x = "Level"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Level = 6,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Guild
@@ -260,6 +430,50 @@ namespace NFrame
 			static const int Level = 1;//int
 
 		};
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Guild_AD = 6,
+				Guild_ContinueDay = 7,
+				Guild_CreateTime = 8,
+				Guild_Desc = 9,
+				Guild_EctypID = 10,
+				Guild_EctypIDGroup = 11,
+				Guild_EctypServer = 12,
+				Guild_Exp = 13,
+				Guild_Gold = 14,
+				Guild_Honor = 15,
+				Guild_ID = 16,
+				Guild_Icon = 17,
+				Guild_KingWarResource = 18,
+				Guild_Level = 19,
+				Guild_MemeberCount = 20,
+				Guild_MemeberMaxCount = 21,
+				Guild_Name = 22,
+				Guild_PresidentID = 23,
+				Guild_PresidentName = 24,
+				Guild_Rank = 25,
+				Guild_Status = 26,
+			};
+		};
+		struct RecordSlot
+		{
+			enum
+			{
+				Guild_AppyList = 0,
+				Guild_Building = 1,
+				Guild_MemberList = 2,
+				Guild_WarList = 3,
+			};
+		};
 
 	};
 	class GuildConfig
@@ -282,6 +496,29 @@ namespace NFrame
 		static const std::string& SkillNum(){ static std::string x = "SkillNum"; return x; };// int
 		static const std::string& VIP(){ static std::string x = "VIP"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				DismissTime = 6,
+				GuildLevel = 7,
+				Level = 8,
+				MaxMember = 9,
+				Money = 10,
+				SkillNum = 11,
+				VIP = 12,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class GuildJob
@@ -312,6 +549,37 @@ namespace NFrame
 		static const std::string& SetRecruit(){ static std::string x = "SetRecruit"; return x; };// object
 		static const std::string& StopDismiss(){ static std::string x = "StopDismiss"; return x; };// object
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				AcceptApply = 6,
+				ApplyDismiss = 7,
+				Appoint = 8,
+				Demise = 9,
+				DenyApply = 10,
+				EditAD = 11,
+				Fire = 12,
+				Job = 13,
+				JobCount = 14,
+				Kickout = 15,
+				Leave = 16,
+				LevelUp = 17,
+				PublishRecruit = 18,
+				SetRecruit = 19,
+				StopDismiss = 20,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class HttpServer
@@ -330,6 +598,25 @@ namespace NFrame
 		static const std::string& WebPort(){ static std::string x = "WebPort"; return x; };// int
 		static const std::string& WebRootPath(){ static std::string x = "WebRootPath"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				ServerID = 6,
+				WebPort = 7,
+				WebRootPath = 8,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class IObject
@@ -344,6 +631,22 @@ namespace NFrame
 		static const std::string& Position(){ static std::string x = "Position"; return x; };// vector3
 		static const std::string& SceneID(){ static std::string x = "SceneID"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class InitProperty
@@ -364,6 +667,27 @@ namespace NFrame
 		static const std::string& ModelPtah(){ static std::string x = "ModelPtah"; return x; };// string
 		static const std::string& SkillIDRef(){ static std::string x = "SkillIDRef"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				EffectData = 6,
+				Job = 7,
+				Level = 8,
+				ModelPtah = 9,
+				SkillIDRef = 10,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Item
@@ -400,6 +724,43 @@ namespace NFrame
 		static const std::string& ShowName(){ static std::string x = "ShowName"; return x; };// string
 		static const std::string& SpriteFile(){ static std::string x = "SpriteFile"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				AwardData = 6,
+				AwardProperty = 7,
+				BuyPrice = 8,
+				ConsumeData = 9,
+				CoolDownTime = 10,
+				DescID = 11,
+				EffectData = 12,
+				ExpiredType = 13,
+				Extend = 14,
+				HeroType = 15,
+				Icon = 16,
+				ItemSubType = 17,
+				ItemType = 18,
+				Job = 19,
+				Level = 20,
+				OverlayCount = 21,
+				Quality = 22,
+				SalePrice = 23,
+				Script = 24,
+				ShowName = 25,
+				SpriteFile = 26,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Language
@@ -417,6 +778,24 @@ namespace NFrame
 		static const std::string& Chinese(){ static std::string x = "Chinese"; return x; };// string
 		static const std::string& English(){ static std::string x = "English"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Chinese = 6,
+				English = 7,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Map
@@ -453,6 +832,31 @@ namespace NFrame
 			static const int WinCount = 8;//int
 
 		};
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				InComeDiamond = 6,
+				InComeGold = 7,
+				InComeOil = 8,
+				MapLevel = 9,
+				MaxCount = 10,
+			};
+		};
+		struct RecordSlot
+		{
+			enum
+			{
+				Station = 0,
+			};
+		};
 
 	};
 	class NPC
@@ -542,6 +946,91 @@ namespace NFrame
 			static const int Time = 1;//int
 
 		};
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				AIOwnerID = 6,
+				ATK_DARK = 7,
+				ATK_FIRE = 8,
+				ATK_ICE = 9,
+				ATK_LIGHT = 10,
+				ATK_POISON = 11,
+				ATK_SPEED = 12,
+				ATK_VALUE = 13,
+				ATK_WIND = 14,
+				AtkDis = 15,
+				BUFF_GATE = 16,
+				CRITICAL = 17,
+				Camp = 18,
+				Climb = 19,
+				ConsumeData = 20,
+				DEF_DARK = 21,
+				DEF_FIRE = 22,
+				DEF_ICE = 23,
+				DEF_LIGHT = 24,
+				DEF_POISON = 25,
+				DEF_VALUE = 26,
+				DEF_WIND = 27,
+				DIZZY_GATE = 28,
+				DescID = 29,
+				Diamond = 30,
+				DropPackList = 31,
+				DropProbability = 32,
+				EXP = 33,
+				EffectData = 34,
+				Gold = 35,
+				HP = 36,
+				HPREGEN = 37,
+				Height = 38,
+				HeroStar = 39,
+				Icon = 40,
+				LastAttacker = 41,
+				Level = 42,
+				MAGIC_GATE = 43,
+				MAXHP = 44,
+				MAXMP = 45,
+				MAXSP = 46,
+				MOVE_GATE = 47,
+				MOVE_SPEED = 48,
+				MP = 49,
+				MPREGEN = 50,
+				MasterID = 51,
+				NPCType = 52,
+				PHYSICAL_GATE = 53,
+				Prefab = 54,
+				REFLECTDAMAGE = 55,
+				SKILL_GATE = 56,
+				SP = 57,
+				SPREGEN = 58,
+				SUCKBLOOD = 59,
+				SeedID = 60,
+				ShowCard = 61,
+				ShowName = 62,
+				SkillAttack = 63,
+				SkillNormal = 64,
+				SkillTHUMP = 65,
+				SpriteFile = 66,
+				TargetX = 67,
+				TargetY = 68,
+				VIPEXP = 69,
+				Width = 70,
+			};
+		};
+		struct RecordSlot
+		{
+			enum
+			{
+				Cooldown = 0,
+			};
+		};
 
 	};
 	class NoSqlServer
@@ -561,6 +1050,26 @@ namespace NFrame
 		static const std::string& Port(){ static std::string x = "Port"; return x; };// int
 		static const std::string& ServerID(){ static std::string x = "ServerID"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Auth = 6,
+				IP = 7,
+				Port = 8,
+				ServerID = 9,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Player
@@ -1083,6 +1592,187 @@ namespace NFrame
 			static const int ItemCount = 1;//int
 
 		};
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				ATK_DARK = 6,
+				ATK_FIRE = 7,
+				ATK_ICE = 8,
+				ATK_LIGHT = 9,
+				ATK_POISON = 10,
+				ATK_PVP = 11,
+				ATK_SPEED = 12,
+				ATK_VALUE = 13,
+				ATK_WIND = 14,
+				Account = 15,
+				BUFF_GATE = 16,
+				CRITICAL = 17,
+				Camp = 18,
+				ConnectKey = 19,
+				Cup = 20,
+				DEF_DARK = 21,
+				DEF_FIRE = 22,
+				DEF_ICE = 23,
+				DEF_LIGHT = 24,
+				DEF_POISON = 25,
+				DEF_PVP = 26,
+				DEF_VALUE = 27,
+				DEF_WIND = 28,
+				DIZZY_GATE = 29,
+				Diamond = 30,
+				EXP = 31,
+				FightHero = 32,
+				FightHeroCnfID = 33,
+				FightingOpponent = 34,
+				FightingStar = 35,
+				FirstTarget = 36,
+				GMLevel = 37,
+				GambleDiamond = 38,
+				GambleGold = 39,
+				GameID = 40,
+				GateID = 41,
+				Gold = 42,
+				GuildID = 43,
+				Guild_AD = 44,
+				Guild_ContinueDay = 45,
+				Guild_CreateTime = 46,
+				Guild_Desc = 47,
+				Guild_EctypID = 48,
+				Guild_EctypIDGroup = 49,
+				Guild_EctypServer = 50,
+				Guild_Exp = 51,
+				Guild_Gold = 52,
+				Guild_Honor = 53,
+				Guild_ID = 54,
+				Guild_Icon = 55,
+				Guild_KingWarResource = 56,
+				Guild_Level = 57,
+				Guild_MemeberCount = 58,
+				Guild_MemeberMaxCount = 59,
+				Guild_Name = 60,
+				Guild_PresidentID = 61,
+				Guild_PresidentName = 62,
+				Guild_Rank = 63,
+				Guild_Status = 64,
+				HP = 65,
+				HPREGEN = 66,
+				Head = 67,
+				Hero1BornPos = 68,
+				Hero1HP = 69,
+				Hero2BornPos = 70,
+				Hero2HP = 71,
+				Hero3BornPos = 72,
+				Hero3HP = 73,
+				HeroID1 = 74,
+				HeroID2 = 75,
+				HeroID3 = 76,
+				HeroLevel = 77,
+				HeroPos1CnfID = 78,
+				HeroPos1Star = 79,
+				HeroPos2CnfID = 80,
+				HeroPos2Star = 81,
+				HeroPos3CnfID = 82,
+				HeroPos3Star = 83,
+				HomeSceneID = 84,
+				Item1 = 85,
+				Item1Count = 86,
+				Item1UsedCount = 87,
+				Item2 = 88,
+				Item2Count = 89,
+				Item2UsedCount = 90,
+				Item3 = 91,
+				Item3Count = 92,
+				Item3UsedCount = 93,
+				Job = 94,
+				LastOfflineTime = 95,
+				Level = 96,
+				MAGIC_GATE = 97,
+				MAXEXP = 98,
+				MAXHP = 99,
+				MAXMP = 100,
+				MAXSP = 101,
+				MOVE_GATE = 102,
+				MOVE_SPEED = 103,
+				MP = 104,
+				MPREGEN = 105,
+				Name = 106,
+				OnlineCount = 107,
+				OnlineTime = 108,
+				OpponentCup = 109,
+				OpponentDiamond = 110,
+				OpponentGold = 111,
+				OpponentHead = 112,
+				OpponentHero1 = 113,
+				OpponentHero1BornPos = 114,
+				OpponentHero1Star = 115,
+				OpponentHero2 = 116,
+				OpponentHero2BornPos = 117,
+				OpponentHero2Star = 118,
+				OpponentHero3 = 119,
+				OpponentHero3BornPos = 120,
+				OpponentHero3Star = 121,
+				OpponentLevel = 122,
+				OpponentName = 123,
+				PHYSICAL_GATE = 124,
+				PVPType = 125,
+				PrefabPath = 126,
+				REFLECTDAMAGE = 127,
+				RELIVE_SOUL = 128,
+				Race = 129,
+				SKILL_GATE = 130,
+				SP = 131,
+				SPREGEN = 132,
+				SUCKBLOOD = 133,
+				Sex = 134,
+				ShowName = 135,
+				Skill1 = 136,
+				Skill2 = 137,
+				Skill3 = 138,
+				TeamID = 139,
+				TotalLineTime = 140,
+				TotalTime = 141,
+				VIPEXP = 142,
+				VIPLevel = 143,
+				ViewOpponent = 144,
+				WarEventTime = 145,
+				WarID = 146,
+				WonCup = 147,
+				WonDiamond = 148,
+				WonGold = 149,
+			};
+		};
+		struct RecordSlot
+		{
+			enum
+			{
+				AttackList = 0,
+				BagEquipList = 1,
+				BagItemList = 2,
+				BeAccackList = 3,
+				BuildingList = 4,
+				BuildingListProduce = 5,
+				CommValue = 6,
+				Cooldown = 7,
+				DropItemList = 8,
+				Guild_AppyList = 9,
+				Guild_Building = 10,
+				Guild_MemberList = 11,
+				Guild_WarList = 12,
+				HeroValue = 13,
+				PlayerHero = 14,
+				TaskList = 15,
+				TaskMonsterList = 16,
+				TempItemList = 17,
+			};
+		};
 
 	};
 	class Scene
@@ -1114,8 +1804,44 @@ namespace NFrame
 		static const std::string& TagPos(){ static std::string x = "TagPos"; return x; };// string
 		static const std::string& Tile(){ static std::string x = "Tile"; return x; };// int
 		static const std::string& Type(){ static std::string x = "Type"; return x; };// int
+		static const std::string& ViewRange(){ static std::string x = "ViewRange"; return x; };// int
 		static const std::string& Width(){ static std::string x = "Width"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				ActorID = 6,
+				BossSoundList = 7,
+				CamOffestPos = 8,
+				CamOffestRot = 9,
+				FilePath = 10,
+				LoadingUI = 11,
+				MaxGroup = 12,
+				MaxGroupPlayers = 13,
+				NavigationResPath = 14,
+				RelivePos = 15,
+				ResPath = 16,
+				SceneName = 17,
+				SceneShowName = 18,
+				SoundList = 19,
+				TagPos = 20,
+				Tile = 21,
+				Type = 22,
+				ViewRange = 23,
+				Width = 24,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Security
@@ -1132,6 +1858,23 @@ namespace NFrame
 		// Property
 		static const std::string& SecurityData(){ static std::string x = "SecurityData"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				SecurityData = 6,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Server
@@ -1155,6 +1898,30 @@ namespace NFrame
 		static const std::string& ServerID(){ static std::string x = "ServerID"; return x; };// int
 		static const std::string& Type(){ static std::string x = "Type"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Area = 6,
+				CpuCount = 7,
+				IP = 8,
+				MaxOnline = 9,
+				Name = 10,
+				Port = 11,
+				ServerID = 12,
+				Type = 13,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Shop
@@ -1178,6 +1945,30 @@ namespace NFrame
 		static const std::string& Stone(){ static std::string x = "Stone"; return x; };// int
 		static const std::string& Type(){ static std::string x = "Type"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Count = 6,
+				Diamond = 7,
+				Gold = 8,
+				ItemID = 9,
+				Level = 10,
+				Steel = 11,
+				Stone = 12,
+				Type = 13,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Skill
@@ -1218,6 +2009,47 @@ namespace NFrame
 		static const std::string& SpriteFile(){ static std::string x = "SpriteFile"; return x; };// string
 		static const std::string& TargetType(){ static std::string x = "TargetType"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				AnimaState = 6,
+				AtkDis = 7,
+				ConsumeProperty = 8,
+				ConsumeType = 9,
+				ConsumeValue = 10,
+				CoolDownTime = 11,
+				DamageCount = 12,
+				DamageDistance = 13,
+				DamageIntervalTime = 14,
+				DamageProperty = 15,
+				DamageType = 16,
+				DamageValue = 17,
+				DefaultHitTime = 18,
+				Desc = 19,
+				GetBuffList = 20,
+				Icon = 21,
+				NewObject = 22,
+				NextID = 23,
+				PlayerSkill = 24,
+				RequireDistance = 25,
+				SendBuffList = 26,
+				ShowName = 27,
+				SkillType = 28,
+				SpriteFile = 29,
+				TargetType = 30,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class SqlServer
@@ -1241,6 +2073,30 @@ namespace NFrame
 		static const std::string& SqlPwd(){ static std::string x = "SqlPwd"; return x; };// string
 		static const std::string& SqlUser(){ static std::string x = "SqlUser"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				IP = 6,
+				Port = 7,
+				ServerID = 8,
+				SqlIP = 9,
+				SqlName = 10,
+				SqlPort = 11,
+				SqlPwd = 12,
+				SqlUser = 13,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Talent
@@ -1262,6 +2118,28 @@ namespace NFrame
 		static const std::string& ShowName(){ static std::string x = "ShowName"; return x; };// string
 		static const std::string& SpriteFile(){ static std::string x = "SpriteFile"; return x; };// string
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Desc = 6,
+				EffectData = 7,
+				Icon = 8,
+				NextID = 9,
+				ShowName = 10,
+				SpriteFile = 11,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Task
@@ -1286,6 +2164,31 @@ namespace NFrame
 		static const std::string& NextTaskID(){ static std::string x = "NextTaskID"; return x; };// string
 		static const std::string& Type(){ static std::string x = "Type"; return x; };// int
 		// Record
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				AwardExp = 6,
+				AwardGold = 7,
+				AwardPack = 8,
+				Desc = 9,
+				KillCount = 10,
+				KillMonsterName = 11,
+				LevelReq = 12,
+				NextTaskID = 13,
+				Type = 14,
+			};
+		};
+		struct RecordSlot
+		{
+		};
 
 	};
 	class Team
@@ -1334,6 +2237,29 @@ namespace NFrame
 			static const int GameID = 9;//int
 
 		};
+		// Slot
+		struct PropertySlot
+		{
+			enum
+			{
+				ClassName = 0,
+				ConfigID = 1,
+				GroupID = 2,
+				ID = 3,
+				Position = 4,
+				SceneID = 5,
+				Captain = 6,
+				PresidentName = 7,
+			};
+		};
+		struct RecordSlot
+		{
+			enum
+			{
+				ApplyList = 0,
+				MemberList = 1,
+			};
+		};
 
 	};
 
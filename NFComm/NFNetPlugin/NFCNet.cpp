@@ -23,6 +23,7 @@
 #include "event2/bufferevent_struct.h"
 #include "event2/event.h"
 #include <atomic>
+#include <algorithm>
 
 /*
 if any one upgurade the networking library(libevent), the evbuffer size must be changed
@@ -32,8 +33,33 @@ TO
 #define EVBUFFER_MAX_READ	65536
 */
 
-//1048576 = 1024 * 1024
-#define NF_BUFFER_MAX_READ	1048576
+//smaller frames are cheaper to copy into every evbuffer than to be referenced
+#define NF_SHARED_FRAME_MIN_SIZE	512
+
+//a socket flushes its batched data before the end of frame once it holds this much
+#define NF_SEND_BATCH_HIGH_WATER	(64 * 1024)
+
+//[ Caps(1) | DictionaryID(4) ]
+#define NF_NET_HELLO_LENGTH			5
+//a broken or hostile package can not make us allocate more than this
+#define NF_NET_MAX_UNPACK_LENGTH	(16 * 1024 * 1024)
+
+//one encoded frame referenced by the output evbuffers of many connections, the last one releases it
+struct NFSharedFrame
+{
+    //released by io threads too in multi-reactor mode
+    std::atomic<int> nRefCount;
+    std::string strData;
+};
+
+void NFCNet::shared_frame_cleanup(const void* data, size_t datalen, void* extra)
+{
+    NFSharedFrame* pFrame = (NFSharedFrame*)extra;
+    if (pFrame->nRefCount.fetch_sub(1) <= 1)
+    {
+        delete pFrame;
+    }
+}
 
 void NFCNet::conn_writecb(struct bufferevent* bev, void* user_data)
 {
@@ -52,6 +78,12 @@ void NFCNet::conn_eventcb(struct bufferevent* bev, short events, void* user_data
     {
         //must to set it's state before the "EventCB" functional be called[maybe user will send msg in the callback function]
         pNet->mbWorking = true;
+
+        if (!pNet->mbServer && pNet->mnCompressThreshold > 0 && pNet->mbCompressHello)
+        {
+            //goes out before anything the callback sends
+            pNet->SendNetHello(pObject, NF_NET_CAPS_LZ4);
+        }
     }
     else
     {
@@ -93,15 +125,25 @@ void NFCNet::listener_cb(struct evconnlistener* listener, evutil_socket_t fd, st
         return;
     }
 
-    if (pNet->mmObject.size() >= pNet->mnMaxConnect)
+    if (pNet->mxObject.Count() >= pNet->mnMaxConnect)
     {
         
         return;
     }
 
     struct event_base* mxBase = pNet->mxBase;
+    int nOption = BEV_OPT_CLOSE_ON_FREE;
+    if (pNet->mxIOThreads.size() > 0)
+    {
+        //spread the sockets over the io threads, the logic thread still writes into them so they need locks
+        NFNetIOThread* pIOThread = pNet->mxIOThreads[pNet->mnNextIOThread % pNet->mxIOThreads.size()];
+        pNet->mnNextIOThread++;
+
+        mxBase = pIOThread->mxBase;
+        nOption |= BEV_OPT_THREADSAFE;
+    }
     
-    struct bufferevent* bev = bufferevent_socket_new(mxBase, fd, BEV_OPT_CLOSE_ON_FREE);
+    struct bufferevent* bev = bufferevent_socket_new(mxBase, fd, nOption);
     if (!bev)
     {
         
@@ -112,11 +154,18 @@ void NFCNet::listener_cb(struct evconnlistener* listener, evutil_socket_t fd, st
 
     struct sockaddr_in* pSin = (sockaddr_in*)sa;
 
-    NetObject* pObject = new NetObject(pNet, fd, *pSin, bev);
+    NetObject* pObject = pNet->mxObject.NewObject(pNet, fd, *pSin, bev);
     pObject->GetNet()->AddNetObject(fd, pObject);
 
     
-    bufferevent_setcb(bev, conn_readcb, conn_writecb, conn_eventcb, (void*)pObject);
+    if (nOption & BEV_OPT_THREADSAFE)
+    {
+        bufferevent_setcb(bev, io_readcb, conn_writecb, io_eventcb, (void*)pObject);
+    }
+    else
+    {
+        bufferevent_setcb(bev, conn_readcb, conn_writecb, conn_eventcb, (void*)pObject);
+    }
 
     
     bufferevent_enable(bev, EV_READ | EV_WRITE | EV_CLOSED | EV_TIMEOUT);
@@ -151,34 +200,52 @@ void NFCNet::conn_readcb(struct bufferevent* bev, void* user_data)
         return;
     }
 
-    size_t len = evbuffer_get_length(input);
-
-    //////////////////////////////////////////////////////////////////////////
+    //frame messages straight out of the evbuffer chain, no staging copy
+    while (!pObject->NeedRemove())
+    {
+        if (!pNet->Dismantle(pObject, input))
+        {
+            break;
+        }
+    }
+}
 
-	static char* mstrTempBuffData = nullptr;
-	if (mstrTempBuffData == nullptr)
-	{
-		mstrTempBuffData = new char[NF_BUFFER_MAX_READ];
-	}
+void NFCNet::io_readcb(struct bufferevent* bev, void* user_data)
+{
+    //runs on the io thread which owns this bufferevent
+    NetObject* pObject = (NetObject*)user_data;
+    NFCNet* pNet = (NFCNet*)pObject->GetNet();
 
-	int nDataLen = len;
-	if (len > NF_BUFFER_MAX_READ)
-	{
-		nDataLen = NF_BUFFER_MAX_READ;
-	}
+    NFNetIOThread* pIOThread = pNet->GetIOThread(bufferevent_get_base(bev));
+    struct evbuffer* input = bufferevent_get_input(bev);
+    if (!pIOThread || !input)
+    {
+        return;
+    }
 
-    if (evbuffer_remove(input, mstrTempBuffData, nDataLen) > 0)
+    while (pNet->Dismantle(pObject, input, pIOThread))
     {
-        pObject->AddBuff(mstrTempBuffData, nDataLen);
     }
+}
+
+void NFCNet::io_eventcb(struct bufferevent* bev, short events, void* user_data)
+{
+    //runs on the io thread, the logic thread will close it and call the event callbacks
+    NetObject* pObject = (NetObject*)user_data;
+    NFCNet* pNet = (NFCNet*)pObject->GetNet();
 
-    while (1)
+    NFNetIOThread* pIOThread = pNet->GetIOThread(bufferevent_get_base(bev));
+    if (!pIOThread)
     {
-        if (!pNet->Dismantle(pObject))
-        {
-            break;
-        }
+        return;
     }
+
+    bufferevent_disable(bev, EV_READ | EV_WRITE);
+
+    NFNetIOMsg xMsg;
+    xMsg.nFD = pObject->GetRealFD();
+    xMsg.nEvent = events;
+    PushIOEvent(pIOThread, xMsg);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -187,6 +254,20 @@ bool NFCNet::Execute()
 {
     ExecuteClose();
 
+    //libevent only writes inside event_base_loop, so the batched data goes out as early as it did before
+    ExecuteSend();
+
+    if (mvThrottled.size() > 0)
+    {
+        ExecuteThrottle();
+    }
+
+    if (mxIOThreads.size() > 0)
+    {
+        //must be done before the listener accepts again, a closed fd may be reused by a new connection
+        ExecuteIOQueue();
+    }
+
     if (mxBase)
     {
         event_base_loop(mxBase, EVLOOP_ONCE | EVLOOP_NONBLOCK);
@@ -213,6 +294,35 @@ int NFCNet::Initialization(const unsigned int nMaxClient, const unsigned short n
     return InitServerNet();
 }
 
+int NFCNet::SetIOThreadCount(const unsigned int nCount)
+{
+    //only works before the server started
+    if (NULL == mxBase)
+    {
+        mnIOThreadCount = nCount;
+    }
+
+    return mnIOThreadCount;
+}
+
+void NFCNet::SetSendBatching(const bool bBatching, const unsigned int nHighWater)
+{
+    if (!bBatching)
+    {
+        ExecuteSend();
+    }
+
+    mbSendBatching = bBatching;
+    mnSendHighWater = nHighWater > 0 ? nHighWater : NF_SEND_BATCH_HIGH_WATER;
+}
+
+void NFCNet::GetSendBatchingStat(int64_t& nFlush, int64_t& nBytes, int64_t& nMsg)
+{
+    nFlush = mnSendFlushTotal;
+    nBytes = mnSendFlushBytes;
+    nMsg = mnSendBatchMsgTotal;
+}
+
 int NFCNet::ExpandBufferSize(const unsigned int size)
 {
 	if (size > 0)
@@ -227,6 +337,8 @@ bool NFCNet::Final()
 
     CloseSocketAll();
 
+    StopIOThreads();
+
     if (listener)
     {
         evconnlistener_free(listener);
@@ -243,24 +355,36 @@ bool NFCNet::Final()
 }
 
 bool NFCNet::SendMsgToAllClient(const char* msg, const size_t nLen)
+{
+    return SendFrameToAllClient(msg, nLen, NULL);
+}
+
+bool NFCNet::SendFrameToAllClient(const char* msg, const size_t nLen, const std::string* pPackData)
 {
     if (nLen <= 0)
     {
         return false;
     }
 
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.begin();
-    for (; it != mmObject.end(); ++it)
+    for (int i = 0; i < mxObject.Count(); ++i)
     {
-        NetObject* pNetObject = (NetObject*)it->second;
+        NetObject* pNetObject = mxObject.At(i);
         if (pNetObject && !pNetObject->NeedRemove())
         {
             bufferevent* bev = pNetObject->GetBuffEvent();
             if (NULL != bev && mbWorking )
             {
-                bufferevent_write(bev, msg, nLen);
+                const bool bPack = pPackData && (pNetObject->GetNetCaps() & NF_NET_CAPS_LZ4);
+                const char* pFrame = bPack ? pPackData->data() : msg;
+                const size_t nFrameLen = bPack ? pPackData->length() : nLen;
+                if (Throttle(pNetObject, pFrame, nFrameLen))
+                {
+                    continue;
+                }
+
+                evbuffer_add(GetSendBuffer(pNetObject), pFrame, nFrameLen);
 
-                mnSendMsgTotal++;
+                AfterSend(pNetObject);
             }
         }
     }
@@ -276,29 +400,30 @@ bool NFCNet::SendMsg(const char* msg, const size_t nLen, const NFSOCK nSockIndex
         return false;
     }
 
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.find(nSockIndex);
-    if (it != mmObject.end())
+    NetObject* pNetObject = mxObject.Find(nSockIndex);
+    if (pNetObject)
     {
-        NetObject* pNetObject = (NetObject*)it->second;
-        if (pNetObject)
+        bufferevent* bev = pNetObject->GetBuffEvent();
+        if (NULL != bev && mbWorking)
         {
-            bufferevent* bev = pNetObject->GetBuffEvent();
-            if (NULL != bev && mbWorking)
+            if (Throttle(pNetObject, msg, nLen))
             {
-                bufferevent_write(bev, msg, nLen);
-
-                mnSendMsgTotal++;
                 return true;
             }
+
+            evbuffer_add(GetSendBuffer(pNetObject), msg, nLen);
+
+            AfterSend(pNetObject);
+            return true;
         }
     }
 
     return false;
 }
 
-bool NFCNet::SendMsg(const char* msg, const size_t nLen, const std::list<NFSOCK>& fdList)
+bool NFCNet::SendMsg(const char* msg, const size_t nLen, const std::vector<NFSOCK>& fdList)
 {
-    std::list<NFSOCK>::const_iterator it = fdList.begin();
+    std::vector<NFSOCK>::const_iterator it = fdList.begin();
     for (; it != fdList.end(); ++it)
     {
         SendMsg(msg, nLen, *it);
@@ -307,176 +432,670 @@ bool NFCNet::SendMsg(const char* msg, const size_t nLen, const std::list<NFSOCK>
     return true;
 }
 
-bool NFCNet::CloseNetObject(const NFSOCK nSockIndex)
+bool NFCNet::SendSharedMsg(std::string& strFrame, const std::vector<NFSOCK>& fdList)
 {
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.find(nSockIndex);
-    if (it != mmObject.end())
+    NFSharedFrame* pFrame = new NFSharedFrame();
+    //held by this function until all evbuffers got their reference
+    pFrame->nRefCount = 1;
+    pFrame->strData.swap(strFrame);
+
+    std::vector<NFSOCK>::const_iterator it = fdList.begin();
+    for (; it != fdList.end(); ++it)
     {
-        NetObject* pObject = it->second;
+        NetObject* pNetObject = mxObject.Find(*it);
+        if (NULL == pNetObject || !mbWorking)
+        {
+            continue;
+        }
 
-        pObject->SetNeedRemove(true);
-        mvRemoveObject.push_back(nSockIndex);
+        if (NULL == pNetObject->GetBuffEvent())
+        {
+            continue;
+        }
 
-        return true;
+        if (Throttle(pNetObject, pFrame->strData.data(), pFrame->strData.length()))
+        {
+            continue;
+        }
+
+        pFrame->nRefCount++;
+        if (0 != evbuffer_add_reference(GetSendBuffer(pNetObject), pFrame->strData.data(), pFrame->strData.length(), shared_frame_cleanup, pFrame))
+        {
+            pFrame->nRefCount--;
+            continue;
+        }
+
+        AfterSend(pNetObject);
     }
 
-    return false;
+    shared_frame_cleanup(NULL, 0, pFrame);
+
+    return true;
 }
 
-bool NFCNet::Dismantle(NetObject* pObject)
+NFSOCK NFCNet::GetNetObjectKey(NetObject* pObject)
 {
-    bool bNeedDismantle = false;
+    return mbServer ? pObject->GetRealFD() : 0;
+}
 
-    int len = pObject->GetBuffLen();
-    if (len > NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
+struct evbuffer* NFCNet::GetSendBuffer(NetObject* pObject)
+{
+    if (!mbSendBatching)
     {
-        NFCMsgHead xHead;
-        int nMsgBodyLength = DeCode(pObject->GetBuff(), len, xHead);
-        if (nMsgBodyLength > 0 && xHead.GetMsgID() > 0)
-        {
-            if (mRecvCB)
-            {
-                mRecvCB(pObject->GetRealFD(), xHead.GetMsgID(), pObject->GetBuff() + NFIMsgHead::NF_Head::NF_HEAD_LENGTH, nMsgBodyLength);
+        return bufferevent_get_output(pObject->GetBuffEvent());
+    }
 
-                mnReceiveMsgTotal++;
-            }
+    //only touched by this thread, so it needs no lock even in multi-reactor mode
+    struct evbuffer* pBuff = pObject->GetSendBuff();
+    if (NULL == pBuff)
+    {
+        pBuff = evbuffer_new();
+        pObject->SetSendBuff(pBuff);
+    }
 
-			pObject->RemoveBuff(0, nMsgBodyLength + NFIMsgHead::NF_Head::NF_HEAD_LENGTH);
+    if (evbuffer_get_length(pBuff) <= 0)
+    {
+        mvSendPending.push_back(GetNetObjectKey(pObject));
+    }
 
-            bNeedDismantle = true;
-        }
-        else if (0 == nMsgBodyLength)
-        {
-            
+    return pBuff;
+}
 
-            bNeedDismantle = false;
-        }
-        else
-        {
-            
-            //pObject->IncreaseError();
+void NFCNet::AfterSend(NetObject* pObject)
+{
+    mnSendMsgTotal++;
 
-            bNeedDismantle = false;
+    if (mbSendBatching)
+    {
+        mnSendBatchMsgTotal++;
 
+        if (evbuffer_get_length(pObject->GetSendBuff()) >= mnSendHighWater)
+        {
+            FlushSend(pObject);
         }
     }
-
-    return bNeedDismantle;
 }
 
-bool NFCNet::AddNetObject(const NFSOCK nSockIndex, NetObject* pObject)
+void NFCNet::FlushSend(NetObject* pObject)
 {
-    //lock
-    return mmObject.insert(std::map<NFSOCK, NetObject*>::value_type(nSockIndex, pObject)).second;
+    struct evbuffer* pBuff = pObject->GetSendBuff();
+    bufferevent* bev = pObject->GetBuffEvent();
+    if (NULL == pBuff || NULL == bev)
+    {
+        return;
+    }
+
+    const size_t nLen = evbuffer_get_length(pBuff);
+    if (nLen > 0)
+    {
+        //moves the chains(shared frames included) into the output buffer, nothing is copied
+        bufferevent_write_buffer(bev, pBuff);
+
+        mnSendFlushTotal++;
+        mnSendFlushBytes += nLen;
+    }
 }
 
-int NFCNet::InitClientNet()
+void NFCNet::ExecuteSend()
 {
-    std::string strIP = mstrIP;
-    int nPort = mnPort;
+    for (size_t i = 0; i < mvSendPending.size(); ++i)
+    {
+        NetObject* pObject = mxObject.Find(mvSendPending[i]);
+        if (pObject && !pObject->NeedRemove())
+        {
+            FlushSend(pObject);
+        }
+    }
 
-    struct sockaddr_in addr;
-    struct bufferevent* bev = NULL;
+    mvSendPending.clear();
+}
 
-#ifdef _MSC_VER
-    WSADATA wsa_data;
-    WSAStartup(0x0201, &wsa_data);
-#endif
+bool NFCNet::CloseNetObject(const NFSOCK nSockIndex)
+{
+    NetObject* pObject = mxObject.Find(nSockIndex);
+    if (pObject)
+    {
+        pObject->SetNeedRemove(true);
+        mvRemoveObject.push_back(nSockIndex);
 
-    memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(nPort);
+        return true;
+    }
 
-    if (evutil_inet_pton(AF_INET, strIP.c_str(), &addr.sin_addr) <= 0)
+    return false;
+}
+
+bool NFCNet::Dismantle(NetObject* pObject, struct evbuffer* input, NFNetIOThread* pIOThread)
+{
+    const size_t len = evbuffer_get_length(input);
+    if (len <= NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
     {
-        printf("inet_pton");
-        return -1;
+        return false;
     }
 
-    mxBase = event_base_new();
-    if (mxBase == NULL)
+    //peek the head only, the body stays where libevent put it(len > NF_HEAD_LENGTH, the extended head always fits)
+    char szHead[NFIMsgHead::NF_Head::NF_HEAD_LENGTH_EX] = { 0 };
+    if (evbuffer_copyout(input, szHead, NFIMsgHead::NF_Head::NF_HEAD_LENGTH_EX) != NFIMsgHead::NF_Head::NF_HEAD_LENGTH_EX)
     {
-        printf("event_base_new ");
-        return -1;
+        return false;
     }
 
-    bev = bufferevent_socket_new(mxBase, -1, BEV_OPT_CLOSE_ON_FREE);
-    if (bev == NULL)
+    NFCMsgHead xHead;
+    int nMsgBodyLength = DeCode(szHead, (uint32_t)len, xHead);
+    if (nMsgBodyLength <= 0)
     {
-        printf("bufferevent_socket_new ");
-        return -1;
+        //incomplete package, wait for more data
+        return false;
     }
 
-    int bRet = bufferevent_socket_connect(bev, (struct sockaddr*)&addr, sizeof(addr));
-    if (0 != bRet)
+    const size_t nPackLength = nMsgBodyLength + xHead.GetHeadLength();
+
+    //only copies when the package straddles two chunks of the chain
+    const unsigned char* pPackData = evbuffer_pullup(input, nPackLength);
+    if (NULL == pPackData)
     {
-        //int nError = GetLastError();
-        printf("bufferevent_socket_connect error");
-        return -1;
+        return false;
     }
 
-    NFSOCK sockfd = bufferevent_getfd(bev);
-    NetObject* pObject = new NetObject(this, sockfd, addr, bev);
-    if (!AddNetObject(0, pObject))
+    const char* pMsgData = (const char*)pPackData + xHead.GetHeadLength();
+    uint32_t nMsgDataLength = nMsgBodyLength;
+
+    NFNetIOMsg xMsg;
+    if (pIOThread)
     {
-        assert(0);
-        return -1;
+        //the logic thread owns the callbacks and the caps, the package must be copied out of this thread
+        xMsg.nFD = pObject->GetRealFD();
+        xMsg.nMsgID = xHead.GetMsgID();
+        xMsg.bPack = (xHead.GetFlags() & NFIMsgHead::NF_HEAD_FLAG_LZ4) != 0;
+        xMsg.strMsg.assign(pMsgData, nMsgDataLength);
+
+        if (!pIOThread->mxQueue.Push(std::move(xMsg)))
+        {
+            //the package stays in the input, it is read again once the logic thread drained the queue
+            PauseIORead(pIOThread, pObject);
+            return false;
+        }
+
+        evbuffer_drain(input, nPackLength);
+
+        return true;
     }
 
-    mbServer = false;
+    if (xHead.GetFlags() & NFIMsgHead::NF_HEAD_FLAG_LZ4)
+    {
+        if (!UnPackRecv(pObject, pMsgData, nMsgDataLength, mstrUnPackBuff))
+        {
+            evbuffer_drain(input, nPackLength);
 
-    bufferevent_setcb(bev, conn_readcb, conn_writecb, conn_eventcb, (void*)pObject);
-    bufferevent_enable(bev, EV_READ | EV_WRITE);
+            conn_eventcb(pObject->GetBuffEvent(), BEV_EVENT_ERROR, (void*)pObject);
 
-    event_set_log_callback(&NFCNet::log_cb);
+            return false;
+        }
 
-	int nSizeRead = (int)bufferevent_get_max_to_read(bev);
-	int nSizeWrite = (int)bufferevent_get_max_to_write(bev);
+        pMsgData = mstrUnPackBuff.data();
+        nMsgDataLength = (uint32_t)mstrUnPackBuff.length();
+    }
 
-	std::cout << "want to connect " << mstrIP << " SizeRead: " << nSizeRead << std::endl;
-	std::cout << "SizeWrite: " << nSizeWrite << std::endl;
+    if (xHead.GetMsgID() <= 0)
+    {
+        OnNetHello(pObject, pMsgData, nMsgDataLength);
+    }
+    else if (mRecvCB)
+    {
+        mRecvCB(pObject->GetRealFD(), xHead.GetMsgID(), pMsgData, nMsgDataLength);
 
-	//bufferevent_set_max_single_read(bev, 0);
-	//bufferevent_set_max_single_write(bev, 0);
+        mnReceiveMsgTotal++;
+    }
 
-    return sockfd;
+    evbuffer_drain(input, nPackLength);
+
+    return true;
 }
 
-int NFCNet::InitServerNet()
+void NFCNet::SetCompress(const unsigned int nThreshold, const std::string& strDictionary, const bool bHello)
 {
-    int nCpuCount = mnCpuCount;
-    int nPort = mnPort;
-
-    struct sockaddr_in sin;
+    //the peers which agreed have checked the dictionary id already
+    if (NULL == mxBase)
+    {
+        mnCompressThreshold = nThreshold;
+        mbCompressHello = bHello;
+        mxCompress.SetDictionary(strDictionary);
+    }
+}
 
-#if NF_PLATFORM == NF_PLATFORM_WIN
-    WSADATA wsa_data;
-    WSAStartup(0x0201, &wsa_data);
+void NFCNet::SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater)
+{
+    mnThrottleHighWater = nHighWater;
+    mnThrottleLowWater = nLowWater < nHighWater ? nLowWater : nHighWater / 2;
+    mnThrottleCloseWater = nCloseWater;
+}
 
-#endif
-    //////////////////////////////////////////////////////////////////////////
+void NFCNet::SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor)
+{
+    if (NF_NET_THROTTLE_NONE == eThrottle)
+    {
+        mxThrottleMsg.erase(nMsgID);
+        return;
+    }
 
-    struct event_config* cfg = event_config_new();
+    NFNetThrottleMsg& xThrottleMsg = mxThrottleMsg[nMsgID];
+    xThrottleMsg.eThrottle = eThrottle;
+    xThrottleMsg.xKeyFunctor = xKeyFunctor;
+}
 
-#if NF_PLATFORM == NF_PLATFORM_WIN
+void NFCNet::GetThrottleStat(int& nThrottled, int64_t& nThrottleTotal, int64_t& nDrop, int64_t& nCoalesce, int64_t& nClose)
+{
+    nThrottled = (int)mvThrottled.size();
+    nThrottleTotal = mnThrottleTotal;
+    nDrop = mnThrottleDropTotal;
+    nCoalesce = mnThrottleCoalesceTotal;
+    nClose = mnThrottleCloseTotal;
+}
 
-    mxBase = event_base_new_with_config(cfg);
+size_t NFCNet::GetPendingLength(NetObject* pObject)
+{
+    //what the socket did not take yet, and what this frame batched for it
+    size_t nLen = evbuffer_get_length(bufferevent_get_output(pObject->GetBuffEvent()));
+    if (pObject->GetSendBuff())
+    {
+        nLen += evbuffer_get_length(pObject->GetSendBuff());
+    }
 
-#else
+    return nLen;
+}
 
-    //event_config_avoid_method(cfg, "epoll");
-    if (event_config_set_flag(cfg, EVENT_BASE_FLAG_EPOLL_USE_CHANGELIST) < 0)
+bool NFCNet::UpdateThrottle(NetObject* pObject)
+{
+    const size_t nPending = GetPendingLength(pObject);
+    if (mnThrottleCloseWater > 0 && nPending >= mnThrottleCloseWater)
     {
-        
-        return -1;
+        //it would never catch up, give the memory back
+        if (!pObject->NeedRemove())
+        {
+            mnThrottleCloseTotal++;
+            CloseNetObject(GetNetObjectKey(pObject));
+        }
+
+        return false;
     }
 
-    if (event_config_set_num_cpus_hint(cfg, nCpuCount) < 0)
+    if (!pObject->GetThrottled() && nPending >= mnThrottleHighWater)
     {
-        return -1;
+        pObject->SetThrottled(true);
+        mvThrottled.push_back(GetNetObjectKey(pObject));
+
+        mnThrottleTotal++;
     }
 
-    mxBase = event_base_new_with_config(cfg);//event_base_new()
+    return true;
+}
+
+bool NFCNet::Throttle(NetObject* pObject, const char* msg, const size_t nLen)
+{
+    if (mnThrottleHighWater <= 0)
+    {
+        return false;
+    }
+
+    if (!UpdateThrottle(pObject))
+    {
+        return true;
+    }
+
+    if (!pObject->GetThrottled())
+    {
+        return false;
+    }
+
+    NFCMsgHead xHead;
+    const int nHeadLength = xHead.DeCode(msg);
+    std::map<int, NFNetThrottleMsg>::iterator it = mxThrottleMsg.find(xHead.GetMsgID());
+    if (it == mxThrottleMsg.end())
+    {
+        //it goes out now, the kept frames were sent before it
+        FlushThrottleFrame(pObject);
+        return false;
+    }
+
+    if (NF_NET_THROTTLE_DROP == it->second.eThrottle)
+    {
+        mnThrottleDropTotal++;
+        return true;
+    }
+
+    std::pair<int, std::string> xKey(xHead.GetMsgID(), std::string());
+    if (it->second.xKeyFunctor)
+    {
+        const char* pMsgData = msg + nHeadLength;
+        uint32_t nMsgDataLength = (uint32_t)nLen - nHeadLength;
+        if (xHead.GetFlags() & NFIMsgHead::NF_HEAD_FLAG_LZ4)
+        {
+            if (!UnPack(pMsgData, nMsgDataLength, mstrThrottleBuff))
+            {
+                FlushThrottleFrame(pObject);
+                return false;
+            }
+
+            pMsgData = mstrThrottleBuff.data();
+            nMsgDataLength = (uint32_t)mstrThrottleBuff.length();
+        }
+
+        if (!it->second.xKeyFunctor(xHead.GetMsgID(), pMsgData, nMsgDataLength, xKey.second))
+        {
+            FlushThrottleFrame(pObject);
+            return false;
+        }
+    }
+
+    //the older one is replaced, it is not up to date any more, the newer one takes the place of the latest send
+    NFNetThrottleFrame& xFrame = mxThrottleFrame[GetNetObjectKey(pObject)];
+    std::map<std::pair<int, std::string>, int>::iterator itIndex = xFrame.xFrameIndex.find(xKey);
+    if (itIndex != xFrame.xFrameIndex.end())
+    {
+        std::string().swap(xFrame.xFrameList[itIndex->second]);
+        itIndex->second = (int)xFrame.xFrameList.size();
+    }
+    else
+    {
+        xFrame.xFrameIndex[xKey] = (int)xFrame.xFrameList.size();
+    }
+
+    xFrame.xFrameList.push_back(std::string(msg, nLen));
+    mnThrottleCoalesceTotal++;
+
+    return true;
+}
+
+void NFCNet::FlushThrottleFrame(NetObject* pObject)
+{
+    std::map<NFSOCK, NFNetThrottleFrame>::iterator it = mxThrottleFrame.find(GetNetObjectKey(pObject));
+    if (it == mxThrottleFrame.end())
+    {
+        return;
+    }
+
+    std::vector<std::string>& xFrameList = it->second.xFrameList;
+    for (size_t i = 0; i < xFrameList.size(); ++i)
+    {
+        if (!xFrameList[i].empty())
+        {
+            evbuffer_add(GetSendBuffer(pObject), xFrameList[i].data(), xFrameList[i].length());
+
+            AfterSend(pObject);
+        }
+    }
+
+    mxThrottleFrame.erase(it);
+}
+
+void NFCNet::ExecuteThrottle()
+{
+    for (size_t i = 0; i < mvThrottled.size();)
+    {
+        NetObject* pObject = mxObject.Find(mvThrottled[i]);
+        if (NULL == pObject || pObject->NeedRemove())
+        {
+            //CloseObject clears it
+            ++i;
+            continue;
+        }
+
+        if (GetPendingLength(pObject) > mnThrottleLowWater)
+        {
+            ++i;
+            continue;
+        }
+
+        pObject->SetThrottled(false);
+
+        FlushThrottleFrame(pObject);
+
+        mvThrottled[i] = mvThrottled.back();
+        mvThrottled.pop_back();
+    }
+}
+
+void NFCNet::SendNetHello(NetObject* pObject, const int nCaps)
+{
+    if (NULL == pObject->GetBuffEvent())
+    {
+        return;
+    }
+
+    //[ Caps(1) | DictionaryID(4) ]
+    char szHello[NF_NET_HELLO_LENGTH] = { 0 };
+    szHello[0] = (char)nCaps;
+
+    NFCMsgHead xHead;
+    uint32_t nDictionaryID = xHead.NF_HTONL(mxCompress.GetDictionaryID());
+    memcpy(szHello + 1, &nDictionaryID, sizeof(nDictionaryID));
+
+    std::string strOutData;
+    EnCode(0, szHello, NF_NET_HELLO_LENGTH, strOutData);
+
+    evbuffer_add(GetSendBuffer(pObject), strOutData.data(), strOutData.length());
+    AfterSend(pObject);
+}
+
+void NFCNet::OnNetHello(NetObject* pObject, const char* msg, const uint32_t nLen)
+{
+    if (nLen < NF_NET_HELLO_LENGTH)
+    {
+        return;
+    }
+
+    NFCMsgHead xHead;
+    uint32_t nDictionaryID = 0;
+    memcpy(&nDictionaryID, msg + 1, sizeof(nDictionaryID));
+    nDictionaryID = xHead.NF_NTOHL(nDictionaryID);
+
+    int nCaps = 0;
+    if (mnCompressThreshold > 0 && (msg[0] & NF_NET_CAPS_LZ4) && nDictionaryID == mxCompress.GetDictionaryID())
+    {
+        nCaps |= NF_NET_CAPS_LZ4;
+    }
+
+    if ((nCaps & NF_NET_CAPS_LZ4) != (pObject->GetNetCaps() & NF_NET_CAPS_LZ4))
+    {
+        mnPackPeerCount += (nCaps & NF_NET_CAPS_LZ4) ? 1 : -1;
+    }
+
+    pObject->SetNetCaps(nCaps);
+
+    if (mbServer)
+    {
+        //the client only starts to compress after this answer
+        SendNetHello(pObject, nCaps);
+    }
+}
+
+bool NFCNet::UnPackRecv(NetObject* pObject, const char* strData, const uint32_t unLen, std::string& strOutData)
+{
+    //nobody may make us unpack what this connection never agreed to
+    if (!(pObject->GetNetCaps() & NF_NET_CAPS_LZ4))
+    {
+        return false;
+    }
+
+    return UnPack(strData, unLen, strOutData);
+}
+
+bool NFCNet::EnCodePack(const uint16_t unMsgID, const char* strData, const uint32_t unDataLen, std::string& strOutData)
+{
+    if (mnCompressThreshold <= 0 || unDataLen < mnCompressThreshold)
+    {
+        return false;
+    }
+
+    //[ Head(7) | RawLength(4) | lz4 block ]
+    const int nOffset = NFIMsgHead::NF_Head::NF_HEAD_LENGTH_EX + sizeof(uint32_t);
+    const int nBound = NFCNetCompress::CompressBound(unDataLen);
+    strOutData.resize(nOffset + nBound);
+
+    const int nPackLength = mxCompress.Compress(strData, unDataLen, &strOutData[nOffset], nBound);
+    if (nPackLength <= 0 || nPackLength + sizeof(uint32_t) >= unDataLen)
+    {
+        //does not shrink, the plain package is cheaper for the receiver
+        return false;
+    }
+
+    NFCMsgHead xHead;
+    xHead.SetMsgID(unMsgID);
+    xHead.SetFlags(NFIMsgHead::NF_HEAD_VERSION_1 | NFIMsgHead::NF_HEAD_FLAG_LZ4);
+    xHead.SetBodyLength(nPackLength + sizeof(uint32_t));
+    xHead.EnCode(&strOutData[0]);
+
+    uint32_t nRawLength = xHead.NF_HTONL(unDataLen);
+    memcpy(&strOutData[NFIMsgHead::NF_Head::NF_HEAD_LENGTH_EX], &nRawLength, sizeof(nRawLength));
+
+    strOutData.resize(nOffset + nPackLength);
+
+    return true;
+}
+
+bool NFCNet::UnPack(const char* strData, const uint32_t unLen, std::string& strOutData) const
+{
+    if (unLen <= sizeof(uint32_t))
+    {
+        return false;
+    }
+
+    NFCMsgHead xHead;
+    uint32_t nRawLength = 0;
+    memcpy(&nRawLength, strData, sizeof(nRawLength));
+    nRawLength = xHead.NF_NTOHL(nRawLength);
+    if (nRawLength <= 0 || nRawLength > NF_NET_MAX_UNPACK_LENGTH)
+    {
+        return false;
+    }
+
+    strOutData.resize(nRawLength);
+
+    return mxCompress.DeCompress(strData + sizeof(uint32_t), unLen - sizeof(uint32_t), &strOutData[0], nRawLength);
+}
+
+bool NFCNet::AddNetObject(const NFSOCK nSockIndex, NetObject* pObject)
+{
+    //lock
+    return mxObject.Add(nSockIndex, pObject);
+}
+
+int NFCNet::InitClientNet()
+{
+    std::string strIP = mstrIP;
+    int nPort = mnPort;
+
+    struct sockaddr_in addr;
+    struct bufferevent* bev = NULL;
+
+#ifdef _MSC_VER
+    WSADATA wsa_data;
+    WSAStartup(0x0201, &wsa_data);
+#endif
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(nPort);
+
+    if (evutil_inet_pton(AF_INET, strIP.c_str(), &addr.sin_addr) <= 0)
+    {
+        printf("inet_pton");
+        return -1;
+    }
+
+    mxBase = event_base_new();
+    if (mxBase == NULL)
+    {
+        printf("event_base_new ");
+        return -1;
+    }
+
+    bev = bufferevent_socket_new(mxBase, -1, BEV_OPT_CLOSE_ON_FREE);
+    if (bev == NULL)
+    {
+        printf("bufferevent_socket_new ");
+        return -1;
+    }
+
+    int bRet = bufferevent_socket_connect(bev, (struct sockaddr*)&addr, sizeof(addr));
+    if (0 != bRet)
+    {
+        //int nError = GetLastError();
+        printf("bufferevent_socket_connect error");
+        return -1;
+    }
+
+    NFSOCK sockfd = bufferevent_getfd(bev);
+    NetObject* pObject = mxObject.NewObject(this, sockfd, addr, bev);
+    if (!AddNetObject(0, pObject))
+    {
+        assert(0);
+        return -1;
+    }
+
+    mbServer = false;
+
+    bufferevent_setcb(bev, conn_readcb, conn_writecb, conn_eventcb, (void*)pObject);
+    bufferevent_enable(bev, EV_READ | EV_WRITE);
+
+    event_set_log_callback(&NFCNet::log_cb);
+
+	int nSizeRead = (int)bufferevent_get_max_to_read(bev);
+	int nSizeWrite = (int)bufferevent_get_max_to_write(bev);
+
+	std::cout << "want to connect " << mstrIP << " SizeRead: " << nSizeRead << std::endl;
+	std::cout << "SizeWrite: " << nSizeWrite << std::endl;
+
+	//bufferevent_set_max_single_read(bev, 0);
+	//bufferevent_set_max_single_write(bev, 0);
+
+    return sockfd;
+}
+
+int NFCNet::InitServerNet()
+{
+    int nCpuCount = mnCpuCount;
+    int nPort = mnPort;
+
+    struct sockaddr_in sin;
+
+#if NF_PLATFORM == NF_PLATFORM_WIN
+    WSADATA wsa_data;
+    WSAStartup(0x0201, &wsa_data);
+
+#endif
+    //////////////////////////////////////////////////////////////////////////
+
+    if (mnIOThreadCount > 0)
+    {
+        //the locks must be enabled before any event_base is created
+#if NF_PLATFORM == NF_PLATFORM_WIN
+        evthread_use_windows_threads();
+#else
+        evthread_use_pthreads();
+#endif
+    }
+
+    struct event_config* cfg = event_config_new();
+
+#if NF_PLATFORM == NF_PLATFORM_WIN
+
+    mxBase = event_base_new_with_config(cfg);
+
+#else
+
+    //event_config_avoid_method(cfg, "epoll");
+    if (event_config_set_flag(cfg, EVENT_BASE_FLAG_EPOLL_USE_CHANGELIST) < 0)
+    {
+        
+        return -1;
+    }
+
+    if (event_config_set_num_cpus_hint(cfg, nCpuCount) < 0)
+    {
+        return -1;
+    }
+
+    mxBase = event_base_new_with_config(cfg);//event_base_new()
 
 #endif
     event_config_free(cfg);
@@ -497,6 +1116,14 @@ int NFCNet::InitServerNet()
 
     printf("server started with %d\n", nPort);
 
+    if (!StartIOThreads())
+    {
+        fprintf(stderr, "Could not start the io threads!\n");
+        Final();
+
+        return -1;
+    }
+
     listener = evconnlistener_new_bind(mxBase, listener_cb, (void*)this,
                                        LEV_OPT_REUSEABLE | LEV_OPT_CLOSE_ON_FREE, -1,
                                        (struct sockaddr*)&sin,
@@ -519,52 +1146,62 @@ int NFCNet::InitServerNet()
 
 bool NFCNet::CloseSocketAll()
 {
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.begin();
-    for (; it != mmObject.end(); ++it)
+    for (int i = 0; i < mxObject.Count(); ++i)
     {
-		NFSOCK nFD = it->first;
-        mvRemoveObject.push_back(nFD);
+        mvRemoveObject.push_back(mxObject.KeyAt(i));
     }
 
     ExecuteClose();
 
-    mmObject.clear();
+    mxObject.Clear();
 
     return true;
 }
 
 NetObject* NFCNet::GetNetObject(const NFSOCK nSockIndex)
 {
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.find(nSockIndex);
-    if (it != mmObject.end())
-    {
-        return it->second;
-    }
-
-    return NULL;
+    return mxObject.Find(nSockIndex);
 }
 
 void NFCNet::CloseObject(const NFSOCK nSockIndex)
 {
-    std::map<NFSOCK, NetObject*>::iterator it = mmObject.find(nSockIndex);
-    if (it != mmObject.end())
+    NetObject* pObject = mxObject.Remove(nSockIndex);
+    if (pObject)
     {
-        NetObject* pObject = it->second;
-
         struct bufferevent* bev = pObject->GetBuffEvent();
 
         bufferevent_free(bev);
 
-        mmObject.erase(it);
+        if (pObject->GetSendBuff())
+        {
+            evbuffer_free(pObject->GetSendBuff());
+            pObject->SetSendBuff(NULL);
+        }
+
+        if (pObject->GetNetCaps() & NF_NET_CAPS_LZ4)
+        {
+            mnPackPeerCount--;
+        }
+
+        if (pObject->GetThrottled())
+        {
+            std::vector<NFSOCK>::iterator it = std::find(mvThrottled.begin(), mvThrottled.end(), nSockIndex);
+            if (it != mvThrottled.end())
+            {
+                mvThrottled.erase(it);
+            }
+
+            mxThrottleFrame.erase(nSockIndex);
+        }
 
-        delete pObject;
+        mxObject.DeleteObject(pObject);
         pObject = NULL;
     }
 }
 
 void NFCNet::ExecuteClose()
 {
-    for (int i = 0; i < mvRemoveObject.size(); ++i)
+    for (size_t i = 0; i < mvRemoveObject.size(); ++i)
     {
 		NFSOCK nSocketIndex = mvRemoveObject[i];
         CloseObject(nSocketIndex);
@@ -573,6 +1210,162 @@ void NFCNet::ExecuteClose()
     mvRemoveObject.clear();
 }
 
+bool NFCNet::StartIOThreads()
+{
+    for (int i = 0; i < mnIOThreadCount; ++i)
+    {
+        NFNetIOThread* pIOThread = new NFNetIOThread();
+        pIOThread->mxBase = event_base_new();
+        if (NULL == pIOThread->mxBase)
+        {
+            delete pIOThread;
+            return false;
+        }
+
+        struct event_base* pBase = pIOThread->mxBase;
+        pIOThread->mxThread = std::thread([pBase]()
+        {
+            event_base_loop(pBase, EVLOOP_NO_EXIT_ON_EMPTY);
+        });
+
+        mxIOThreads.push_back(pIOThread);
+    }
+
+    return true;
+}
+
+void NFCNet::StopIOThreads()
+{
+    for (size_t i = 0; i < mxIOThreads.size(); ++i)
+    {
+        NFNetIOThread* pIOThread = mxIOThreads[i];
+        event_base_loopbreak(pIOThread->mxBase);
+        if (pIOThread->mxThread.joinable())
+        {
+            pIOThread->mxThread.join();
+        }
+    }
+
+    for (size_t i = 0; i < mxIOThreads.size(); ++i)
+    {
+        NFNetIOThread* pIOThread = mxIOThreads[i];
+        event_base_free(pIOThread->mxBase);
+        delete pIOThread;
+    }
+
+    mxIOThreads.clear();
+}
+
+NFNetIOThread* NFCNet::GetIOThread(struct event_base* pBase)
+{
+    for (size_t i = 0; i < mxIOThreads.size(); ++i)
+    {
+        if (mxIOThreads[i]->mxBase == pBase)
+        {
+            return mxIOThreads[i];
+        }
+    }
+
+    return NULL;
+}
+
+void NFCNet::PushIOEvent(NFNetIOThread* pIOThread, NFNetIOMsg& xMsg)
+{
+    //a socket gives one event at most, it stops reading and writing then, so the list stays small
+    if (!pIOThread->mxQueue.Push(std::move(xMsg)))
+    {
+        std::lock_guard<std::mutex> xGuard(pIOThread->mxOverflowLock);
+        pIOThread->mxEventList.push_back(xMsg);
+    }
+}
+
+void NFCNet::PauseIORead(NFNetIOThread* pIOThread, NetObject* pObject)
+{
+    //disabled before it is listed, so the logic thread never enables it before this
+    bufferevent_disable(pObject->GetBuffEvent(), EV_READ);
+
+    std::lock_guard<std::mutex> xGuard(pIOThread->mxOverflowLock);
+    pIOThread->mxPauseList.push_back(pObject->GetRealFD());
+}
+
+void NFCNet::ExecuteIOQueue()
+{
+    NFNetIOMsg xMsg;
+    for (size_t i = 0; i < mxIOThreads.size(); ++i)
+    {
+        NFNetIOThread* pIOThread = mxIOThreads[i];
+        while (pIOThread->mxQueue.Pop(xMsg))
+        {
+            ExecuteIOMsg(xMsg);
+        }
+
+        {
+            std::lock_guard<std::mutex> xGuard(pIOThread->mxOverflowLock);
+            mxIOPauseList.swap(pIOThread->mxPauseList);
+            mxIOEventList.swap(pIOThread->mxEventList);
+        }
+
+        //the packages of those sockets were in the queue already, their events come after them
+        for (size_t j = 0; j < mxIOEventList.size(); ++j)
+        {
+            ExecuteIOMsg(mxIOEventList[j]);
+        }
+
+        //the queue has room again, what is left in their input is read on the io thread
+        for (size_t j = 0; j < mxIOPauseList.size(); ++j)
+        {
+            NetObject* pObject = GetNetObject(mxIOPauseList[j]);
+            if (pObject && !pObject->NeedRemove() && pObject->GetBuffEvent())
+            {
+                bufferevent_enable(pObject->GetBuffEvent(), EV_READ);
+                bufferevent_trigger(pObject->GetBuffEvent(), EV_READ, BEV_TRIG_IGNORE_WATERMARKS | BEV_TRIG_DEFER_CALLBACKS);
+            }
+        }
+
+        mxIOEventList.clear();
+        mxIOPauseList.clear();
+    }
+}
+
+void NFCNet::ExecuteIOMsg(NFNetIOMsg& xMsg)
+{
+    //the socket has been closed, anything left from it is stale
+    NetObject* pObject = GetNetObject(xMsg.nFD);
+    if (NULL == pObject || pObject->NeedRemove())
+    {
+        return;
+    }
+
+    if (xMsg.bPack)
+    {
+        if (!UnPackRecv(pObject, xMsg.strMsg.data(), (uint32_t)xMsg.strMsg.length(), mstrUnPackBuff))
+        {
+            conn_eventcb(pObject->GetBuffEvent(), BEV_EVENT_ERROR, (void*)pObject);
+            return;
+        }
+
+        xMsg.strMsg.swap(mstrUnPackBuff);
+    }
+
+    if (xMsg.nMsgID > 0)
+    {
+        if (mRecvCB)
+        {
+            mRecvCB(xMsg.nFD, xMsg.nMsgID, xMsg.strMsg.data(), (uint32_t)xMsg.strMsg.length());
+
+            mnReceiveMsgTotal++;
+        }
+    }
+    else if (0 == xMsg.nEvent)
+    {
+        OnNetHello(pObject, xMsg.strMsg.data(), (uint32_t)xMsg.strMsg.length());
+    }
+    else
+    {
+        conn_eventcb(pObject->GetBuffEvent(), xMsg.nEvent, (void*)pObject);
+    }
+}
+
 void NFCNet::log_cb(int severity, const char* msg)
 {
 
@@ -592,8 +1385,14 @@ bool NFCNet::Log(int severity, const char* msg)
 bool NFCNet::SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const NFSOCK nSockIndex /*= 0*/)
 {
     std::string strOutData;
+    NetObject* pObject = mxObject.Find(nSockIndex);
+    if (pObject && (pObject->GetNetCaps() & NF_NET_CAPS_LZ4) && EnCodePack(nMsgID, msg, nLen, strOutData))
+    {
+        return SendMsg(strOutData.c_str(), strOutData.length(), nSockIndex);
+    }
+
     int nAllLen = EnCode(nMsgID, msg, nLen, strOutData);
-    if (nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
+    if ((size_t)nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
     {
         
         return SendMsg(strOutData.c_str(), strOutData.length(), nSockIndex);
@@ -602,26 +1401,168 @@ bool NFCNet::SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const siz
     return false;
 }
 
-bool NFCNet::SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const std::list<NFSOCK>& fdList)
+char* NFCNet::ReserveMsg(const int16_t nMsgID, const size_t nLen, const NFSOCK nSockIndex)
+{
+    if (NULL != mxReserveBuff || !mbWorking)
+    {
+        return NULL;
+    }
+
+    NetObject* pObject = mxObject.Find(nSockIndex);
+    if (NULL == pObject || NULL == pObject->GetBuffEvent())
+    {
+        return NULL;
+    }
+
+    if ((pObject->GetNetCaps() & NF_NET_CAPS_LZ4) && mnCompressThreshold > 0 && nLen >= mnCompressThreshold)
+    {
+        //the packer needs the whole body first
+        return NULL;
+    }
+
+    if (mnThrottleHighWater > 0)
+    {
+        if (!UpdateThrottle(pObject))
+        {
+            return NULL;
+        }
+
+        if (pObject->GetThrottled() && mxThrottleMsg.find(nMsgID) != mxThrottleMsg.end())
+        {
+            //the policy needs the whole frame
+            return NULL;
+        }
+
+        if (pObject->GetThrottled())
+        {
+            FlushThrottleFrame(pObject);
+        }
+    }
+
+    NFCMsgHead xHead;
+    xHead.SetMsgID(nMsgID);
+    xHead.SetBodyLength((uint32_t)nLen);
+
+    struct evbuffer* pBuff = GetSendBuffer(pObject);
+
+    //the output buffer of an io thread socket must not be touched by that thread until the body has been committed
+    evbuffer_lock(pBuff);
+    if (evbuffer_reserve_space(pBuff, nLen + xHead.GetHeadLength(), &mxReserveVec, 1) != 1)
+    {
+        evbuffer_unlock(pBuff);
+        return NULL;
+    }
+
+    mxReserveVec.iov_len = nLen + xHead.GetHeadLength();
+    mxReserveBuff = pBuff;
+    mxReserveObject = pObject;
+
+    char* pData = (char*)mxReserveVec.iov_base;
+    xHead.EnCode(pData);
+
+    return pData + xHead.GetHeadLength();
+}
+
+bool NFCNet::CommitMsg()
+{
+    if (NULL == mxReserveBuff)
+    {
+        return false;
+    }
+
+    struct evbuffer* pBuff = mxReserveBuff;
+    mxReserveBuff = NULL;
+
+    const bool bRet = (0 == evbuffer_commit_space(pBuff, &mxReserveVec, 1));
+    evbuffer_unlock(pBuff);
+
+    if (bRet)
+    {
+        AfterSend(mxReserveObject);
+    }
+
+    mxReserveObject = NULL;
+
+    return bRet;
+}
+
+bool NFCNet::SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const std::vector<NFSOCK>& fdList)
 {
+    if (mnCompressThreshold > 0 && nLen >= mnCompressThreshold)
+    {
+        //the connections which agreed get the packed frame, the others the plain one
+        mvPackFD.clear();
+        mvPlainFD.clear();
+        for (size_t i = 0; i < fdList.size(); ++i)
+        {
+            NetObject* pObject = mxObject.Find(fdList[i]);
+            if (pObject && (pObject->GetNetCaps() & NF_NET_CAPS_LZ4))
+            {
+                mvPackFD.push_back(fdList[i]);
+            }
+            else
+            {
+                mvPlainFD.push_back(fdList[i]);
+            }
+        }
+
+        if (mvPackFD.size() > 0)
+        {
+            std::string strPackData;
+            if (EnCodePack(nMsgID, msg, nLen, strPackData))
+            {
+                SendFrame(strPackData, mvPackFD);
+            }
+            else
+            {
+                mvPlainFD.insert(mvPlainFD.end(), mvPackFD.begin(), mvPackFD.end());
+            }
+        }
+
+        if (mvPlainFD.size() > 0)
+        {
+            std::string strOutData;
+            EnCode(nMsgID, msg, nLen, strOutData);
+            SendFrame(strOutData, mvPlainFD);
+        }
+
+        return true;
+    }
+
     std::string strOutData;
     int nAllLen = EnCode(nMsgID, msg, nLen, strOutData);
-    if (nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
+    if ((size_t)nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
     {
-        
-        return SendMsg(strOutData.c_str(), strOutData.length(), fdList);
+        return SendFrame(strOutData, fdList);
     }
 
     return false;
 }
 
+bool NFCNet::SendFrame(std::string& strFrame, const std::vector<NFSOCK>& fdList)
+{
+    if (fdList.size() > 1 && strFrame.length() >= NF_SHARED_FRAME_MIN_SIZE)
+    {
+        //encoded once, every connection only references the same frame
+        return SendSharedMsg(strFrame, fdList);
+    }
+
+    return SendMsg(strFrame.c_str(), strFrame.length(), fdList);
+}
+
 bool NFCNet::SendMsgToAllClientWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen)
 {
     std::string strOutData;
     int nAllLen = EnCode(nMsgID, msg, nLen, strOutData);
-    if (nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
+    if ((size_t)nAllLen == nLen + NFIMsgHead::NF_Head::NF_HEAD_LENGTH)
     {
-        
+        //nobody agreed to LZ4, the packed one would never be sent
+        std::string strPackData;
+        if (mnPackPeerCount > 0 && EnCodePack(nMsgID, msg, nLen, strPackData))
+        {
+            return SendFrameToAllClient(strOutData.c_str(), (uint32_t) strOutData.length(), &strPackData);
+        }
+
         return SendMsgToAllClient(strOutData.c_str(), (uint32_t) strOutData.length());
     }
 
@@ -653,13 +1594,14 @@ int NFCNet::DeCode(const char* strData, const uint32_t unAllLen, NFCMsgHead& xHe
         return -1;
     }
 
-    if (NFIMsgHead::NF_Head::NF_HEAD_LENGTH != xHead.DeCode(strData))
+    const int nHeadLength = xHead.DeCode(strData);
+    if ((int)xHead.GetHeadLength() != nHeadLength)
     {
         
         return -2;
     }
 
-    if (xHead.GetBodyLength() > (unAllLen - NFIMsgHead::NF_Head::NF_HEAD_LENGTH))
+    if (unAllLen < xHead.GetHeadLength() || xHead.GetBodyLength() > (unAllLen - xHead.GetHeadLength()))
     {
         
         return -3;
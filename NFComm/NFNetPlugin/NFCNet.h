@@ -9,6 +9,7 @@
 #define NFC_NET_H
 
 #include "NFINet.h"
+#include "NFCNetCompress.h"
 
 #include <event2/bufferevent.h>
 #include <event2/buffer.h>
@@ -16,6 +17,254 @@
 #include <event2/util.h>
 #include <event2/thread.h>
 #include <event2/event_compat.h>
+#include <thread>
+#include <mutex>
+#include <new>
+#include "NFComm/NFCore/NFQueue.hpp"
+
+//sockets beyond this value(windows handles) fall back to a map
+#define NF_NET_OBJECT_SLOT_MAX	(1 << 20)
+
+//a package or a socket event produced by an io thread, handed to the logic thread
+struct NFNetIOMsg
+{
+    NFNetIOMsg()
+    {
+        nFD = 0;
+        nMsgID = 0;
+        nEvent = 0;
+        bPack = false;
+    }
+
+    NFSOCK nFD;
+    //0 means it is a socket event, or the hello package when nEvent is 0 too
+    int nMsgID;
+    short nEvent;
+    //the body is still packed, the logic thread checks the caps of the connection before unpacking it
+    bool bPack;
+    std::string strMsg;
+};
+
+//one event_base for each io thread, it reads, dismantles and writes for the sockets assigned to it
+struct NFNetIOThread
+{
+    NFNetIOThread()
+    {
+        mxBase = NULL;
+    }
+
+    struct event_base* mxBase;
+    std::thread mxThread;
+    NFSPSCQueue<NFNetIOMsg> mxQueue;
+
+    //the io thread never waits for the queue, it holds the lock of the bufferevent the logic thread needs to drain it
+    //a package that does not fit stays in the input and the socket stops reading, an event that does not fit waits here
+    std::mutex mxOverflowLock;
+    std::vector<NFSOCK> mxPauseList;
+    std::vector<NFNetIOMsg> mxEventList;
+};
+
+//NetObjects indexed by fd, the live list keeps them contiguous for broadcasting
+//and the memory of the closed objects is reused by the new connections
+class NFNetObjectTable
+{
+public:
+    NFNetObjectTable()
+    {
+    }
+
+    ~NFNetObjectTable()
+    {
+        Clear();
+
+        for (size_t i = 0; i < mxFreeObject.size(); ++i)
+        {
+            ::operator delete(mxFreeObject[i]);
+        }
+
+        mxFreeObject.clear();
+    }
+
+    NetObject* NewObject(NFINet* pNet, NFSOCK fd, sockaddr_in& addr, struct bufferevent* pBev)
+    {
+        if (mxFreeObject.empty())
+        {
+            return new NetObject(pNet, fd, addr, pBev);
+        }
+
+        void* pMemory = mxFreeObject.back();
+        mxFreeObject.pop_back();
+
+        return new (pMemory) NetObject(pNet, fd, addr, pBev);
+    }
+
+    void DeleteObject(NetObject* pObject)
+    {
+        pObject->~NetObject();
+        mxFreeObject.push_back(pObject);
+    }
+
+    NetObject* Find(const NFSOCK nFD) const
+    {
+        if (nFD >= 0 && (size_t)nFD < mxSlot.size())
+        {
+            return mxSlot[nFD].pObject;
+        }
+
+        if (nFD >= NF_NET_OBJECT_SLOT_MAX)
+        {
+            std::map<NFSOCK, Slot>::const_iterator it = mxLargeSlot.find(nFD);
+            if (it != mxLargeSlot.end())
+            {
+                return it->second.pObject;
+            }
+        }
+
+        return NULL;
+    }
+
+    bool Add(const NFSOCK nFD, NetObject* pObject)
+    {
+        Slot* pSlot = GetSlot(nFD, true);
+        if (NULL == pSlot || NULL != pSlot->pObject)
+        {
+            return false;
+        }
+
+        pSlot->pObject = pObject;
+        pSlot->nLiveIndex = (int)mxLive.size();
+        mxLive.push_back(pObject);
+        mxLiveFD.push_back(nFD);
+
+        return true;
+    }
+
+    NetObject* Remove(const NFSOCK nFD)
+    {
+        Slot* pSlot = GetSlot(nFD, false);
+        if (NULL == pSlot || NULL == pSlot->pObject)
+        {
+            return NULL;
+        }
+
+        NetObject* pObject = pSlot->pObject;
+
+        //move the last one into the hole, the key is not always the real fd(clients use 0)
+        const int nIndex = pSlot->nLiveIndex;
+        const NFSOCK nLastFD = mxLiveFD.back();
+        mxLive[nIndex] = mxLive.back();
+        mxLiveFD[nIndex] = nLastFD;
+        mxLive.pop_back();
+        mxLiveFD.pop_back();
+        GetSlot(nLastFD, false)->nLiveIndex = nIndex;
+
+        pSlot = GetSlot(nFD, false);
+
+        pSlot->pObject = NULL;
+        pSlot->nLiveIndex = -1;
+
+        if (nFD >= NF_NET_OBJECT_SLOT_MAX)
+        {
+            mxLargeSlot.erase(nFD);
+        }
+
+        return pObject;
+    }
+
+    int Count() const
+    {
+        return (int)mxLive.size();
+    }
+
+    NetObject* At(const int nIndex) const
+    {
+        return mxLive[nIndex];
+    }
+
+    NFSOCK KeyAt(const int nIndex) const
+    {
+        return mxLiveFD[nIndex];
+    }
+
+    void Clear()
+    {
+        mxSlot.clear();
+        mxLargeSlot.clear();
+        mxLive.clear();
+        mxLiveFD.clear();
+    }
+
+private:
+    struct Slot
+    {
+        Slot()
+        {
+            pObject = NULL;
+            nLiveIndex = -1;
+        }
+
+        NetObject* pObject;
+        int nLiveIndex;
+    };
+
+    Slot* GetSlot(const NFSOCK nFD, const bool bCreate)
+    {
+        if (nFD < 0)
+        {
+            return NULL;
+        }
+
+        if (nFD >= NF_NET_OBJECT_SLOT_MAX)
+        {
+            if (bCreate)
+            {
+                return &mxLargeSlot[nFD];
+            }
+
+            std::map<NFSOCK, Slot>::iterator it = mxLargeSlot.find(nFD);
+            return it != mxLargeSlot.end() ? &it->second : NULL;
+        }
+
+        if ((size_t)nFD >= mxSlot.size())
+        {
+            if (!bCreate)
+            {
+                return NULL;
+            }
+
+            mxSlot.resize(nFD + 1);
+        }
+
+        return &mxSlot[nFD];
+    }
+
+    std::vector<Slot> mxSlot;
+    std::map<NFSOCK, Slot> mxLargeSlot;
+    std::vector<NetObject*> mxLive;
+    std::vector<NFSOCK> mxLiveFD;
+    std::vector<void*> mxFreeObject;
+};
+
+//the policy of one message id on throttled connections
+struct NFNetThrottleMsg
+{
+    NFNetThrottleMsg()
+    {
+        eThrottle = NF_NET_THROTTLE_NONE;
+    }
+
+    NF_NET_THROTTLE eThrottle;
+    NET_COALESCE_FUNCTOR xKeyFunctor;
+};
+
+//the latest frames kept for a throttled connection, in the order they were sent
+struct NFNetThrottleFrame
+{
+    //an empty one has been replaced by a newer frame further down the list
+    std::vector<std::string> xFrameList;
+    //<<msgid, key>, position in xFrameList>
+    std::map<std::pair<int, std::string>, int> xFrameIndex;
+};
 
 #pragma pack(push, 1)
 
@@ -37,6 +286,29 @@ public:
         mnReceiveMsgTotal = 0;
 
 		mnBufferSize = 0;
+        mnIOThreadCount = 0;
+        mnNextIOThread = 0;
+
+        mbSendBatching = false;
+        mnSendHighWater = 0;
+        mnSendFlushTotal = 0;
+        mnSendFlushBytes = 0;
+        mnSendBatchMsgTotal = 0;
+
+        mnCompressThreshold = 0;
+        mbCompressHello = false;
+        mnPackPeerCount = 0;
+
+        mxReserveBuff = NULL;
+        mxReserveObject = NULL;
+
+        mnThrottleHighWater = 0;
+        mnThrottleLowWater = 0;
+        mnThrottleCloseWater = 0;
+        mnThrottleTotal = 0;
+        mnThrottleDropTotal = 0;
+        mnThrottleCoalesceTotal = 0;
+        mnThrottleCloseTotal = 0;
     }
 
     template<typename BaseType>
@@ -57,6 +329,29 @@ public:
         mnReceiveMsgTotal = 0;
 
 		mnBufferSize = 0;
+        mnIOThreadCount = 0;
+        mnNextIOThread = 0;
+
+        mbSendBatching = false;
+        mnSendHighWater = 0;
+        mnSendFlushTotal = 0;
+        mnSendFlushBytes = 0;
+        mnSendBatchMsgTotal = 0;
+
+        mnCompressThreshold = 0;
+        mbCompressHello = false;
+        mnPackPeerCount = 0;
+
+        mxReserveBuff = NULL;
+        mxReserveObject = NULL;
+
+        mnThrottleHighWater = 0;
+        mnThrottleLowWater = 0;
+        mnThrottleCloseWater = 0;
+        mnThrottleTotal = 0;
+        mnThrottleDropTotal = 0;
+        mnThrottleCoalesceTotal = 0;
+        mnThrottleCloseTotal = 0;
     }
     virtual ~NFCNet() {};
 
@@ -66,6 +361,13 @@ public:
     virtual void Initialization(const char* strIP, const unsigned short nPort);
     virtual int Initialization(const unsigned int nMaxClient, const unsigned short nPort, const int nCpuCount = 4);
 	virtual int ExpandBufferSize(const unsigned int size);
+    virtual int SetIOThreadCount(const unsigned int nCount);
+    virtual void SetSendBatching(const bool bBatching, const unsigned int nHighWater = 0);
+    virtual void GetSendBatchingStat(int64_t& nFlush, int64_t& nBytes, int64_t& nMsg);
+    virtual void SetCompress(const unsigned int nThreshold, const std::string& strDictionary = "", const bool bHello = false);
+    virtual void SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater);
+    virtual void SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor = NET_COALESCE_FUNCTOR());
+    virtual void GetThrottleStat(int& nThrottled, int64_t& nThrottleTotal, int64_t& nDrop, int64_t& nCoalesce, int64_t& nClose);
 
     virtual bool Final();
 
@@ -73,7 +375,10 @@ public:
     virtual bool SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const NFSOCK nSockIndex);
 
     
-    virtual bool SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const std::list<NFSOCK>& fdList);
+    virtual bool SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const std::vector<NFSOCK>& fdList);
+
+    virtual char* ReserveMsg(const int16_t nMsgID, const size_t nLen, const NFSOCK nSockIndex = 0);
+    virtual bool CommitMsg();
 
     
     virtual bool SendMsgToAllClientWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen);
@@ -88,37 +393,70 @@ public:
 
 private:    
     bool SendMsgToAllClient(const char* msg, const size_t nLen);
+    bool SendFrameToAllClient(const char* msg, const size_t nLen, const std::string* pPackData);
     
-    bool SendMsg(const char* msg, const size_t nLen, const std::list<NFSOCK>& fdList);
+    bool SendMsg(const char* msg, const size_t nLen, const std::vector<NFSOCK>& fdList);
     bool SendMsg(const char* msg, const size_t nLen, const NFSOCK nSockIndex);
+    bool SendSharedMsg(std::string& strFrame, const std::vector<NFSOCK>& fdList);
+    bool SendFrame(std::string& strFrame, const std::vector<NFSOCK>& fdList);
+
+    //the key of the object in mxObject, the client net is always at 0
+    NFSOCK GetNetObjectKey(NetObject* pObject);
+    struct evbuffer* GetSendBuffer(NetObject* pObject);
+    void AfterSend(NetObject* pObject);
+    void FlushSend(NetObject* pObject);
+    void ExecuteSend();
+
+    size_t GetPendingLength(NetObject* pObject);
+    bool UpdateThrottle(NetObject* pObject);
+    bool Throttle(NetObject* pObject, const char* msg, const size_t nLen);
+    void FlushThrottleFrame(NetObject* pObject);
+    void ExecuteThrottle();
+
+    void SendNetHello(NetObject* pObject, const int nCaps);
+    void OnNetHello(NetObject* pObject, const char* msg, const uint32_t nLen);
+    bool UnPackRecv(NetObject* pObject, const char* strData, const uint32_t unLen, std::string& strOutData);
 
 
 private:
     void ExecuteClose();
     bool CloseSocketAll();
 
-    bool Dismantle(NetObject* pObject);
+    bool Dismantle(NetObject* pObject, struct evbuffer* input, NFNetIOThread* pIOThread = NULL);
 
 
     int InitClientNet();
     int InitServerNet();
     void CloseObject(const NFSOCK nSockIndex);
 
+    bool StartIOThreads();
+    void StopIOThreads();
+    void ExecuteIOQueue();
+    void ExecuteIOMsg(NFNetIOMsg& xMsg);
+    NFNetIOThread* GetIOThread(struct event_base* pBase);
+    static void PushIOEvent(NFNetIOThread* pIOThread, NFNetIOMsg& xMsg);
+    static void PauseIORead(NFNetIOThread* pIOThread, NetObject* pObject);
+
     static void listener_cb(struct evconnlistener* listener, evutil_socket_t fd, struct sockaddr* sa, int socklen, void* user_data);
     static void conn_readcb(struct bufferevent* bev, void* user_data);
     static void conn_writecb(struct bufferevent* bev, void* user_data);
     static void conn_eventcb(struct bufferevent* bev, short events, void* user_data);
     static void log_cb(int severity, const char* msg);
+    static void io_readcb(struct bufferevent* bev, void* user_data);
+    static void io_eventcb(struct bufferevent* bev, short events, void* user_data);
+    static void shared_frame_cleanup(const void* data, size_t datalen, void* extra);
 
 protected:
     int DeCode(const char* strData, const uint32_t unLen, NFCMsgHead& xHead);
     int EnCode(const uint16_t unMsgID, const char* strData, const uint32_t unDataLen, std::string& strOutData);
+    bool EnCodePack(const uint16_t unMsgID, const char* strData, const uint32_t unDataLen, std::string& strOutData);
+    bool UnPack(const char* strData, const uint32_t unLen, std::string& strOutData) const;
 
 private:
     //<fd,object>
 
 
-    std::map<NFSOCK, NetObject*> mmObject;
+    NFNetObjectTable mxObject;
     std::vector<NFSOCK> mvRemoveObject;
 
     int mnMaxConnect;
@@ -129,6 +467,51 @@ private:
 
 	int mnBufferSize;
 
+    //0 means all sockets are driven by mxBase on the logic thread
+    int mnIOThreadCount;
+    int mnNextIOThread;
+    std::vector<NFNetIOThread*> mxIOThreads;
+    //taken from the io threads by ExecuteIOQueue
+    std::vector<NFSOCK> mxIOPauseList;
+    std::vector<NFNetIOMsg> mxIOEventList;
+
+    bool mbSendBatching;
+    unsigned int mnSendHighWater;
+    //the objects(by their key in mxObject) which got data in their send buffer during this frame
+    std::vector<NFSOCK> mvSendPending;
+    int64_t mnSendFlushTotal;
+    int64_t mnSendFlushBytes;
+    int64_t mnSendBatchMsgTotal;
+
+    //0 means never compress
+    unsigned int mnCompressThreshold;
+    //a client only says hello to the servers which are known to answer it, an older one takes it as a normal message
+    bool mbCompressHello;
+    //the connections which agreed to LZ4, no broadcast is packed while there is none
+    int mnPackPeerCount;
+    NFCNetCompress mxCompress;
+    std::string mstrUnPackBuff;
+    std::vector<NFSOCK> mvPackFD;
+    std::vector<NFSOCK> mvPlainFD;
+
+    //the message between ReserveMsg and CommitMsg, only one at a time
+    struct evbuffer* mxReserveBuff;
+    NetObject* mxReserveObject;
+    struct evbuffer_iovec mxReserveVec;
+
+    //0 means never throttle
+    unsigned int mnThrottleHighWater;
+    unsigned int mnThrottleLowWater;
+    unsigned int mnThrottleCloseWater;
+    std::map<int, NFNetThrottleMsg> mxThrottleMsg;
+    std::vector<NFSOCK> mvThrottled;
+    std::map<NFSOCK, NFNetThrottleFrame> mxThrottleFrame;
+    std::string mstrThrottleBuff;
+    int64_t mnThrottleTotal;
+    int64_t mnThrottleDropTotal;
+    int64_t mnThrottleCoalesceTotal;
+    int64_t mnThrottleCloseTotal;
+
     bool mbWorking;
 
     int64_t mnSendMsgTotal;
@@ -55,7 +55,7 @@ void NFCNetClientModule::RemoveReceiveCallBack(const NF_SERVER_TYPES eType, cons
     NF_SHARE_PTR<CallBack> xCallBack = mxCallBack.GetElement(eType);
     if (xCallBack)
     {
-        std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::iterator it = xCallBack->mxReceiveCallBack.find(nMsgID);
+        std::map<int, std::list<NFNetReceiveCallBack>>::iterator it = xCallBack->mxReceiveCallBack.find(nMsgID);
         if (xCallBack->mxReceiveCallBack.end() == it)
         {
             xCallBack->mxReceiveCallBack.erase(it);
@@ -79,6 +79,17 @@ int NFCNetClientModule::ExpandBufferSize(const unsigned int size)
 
 int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID,
                                            NET_RECEIVE_FUNCTOR_PTR functorPtr)
+{
+    return AddReceiveCallBack(eType, nMsgID, NFNetReceiveCallBack::Functor(functorPtr));
+}
+
+int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, NET_RECEIVE_FUNCTOR_PTR functorPtr)
+{
+    return AddReceiveCallBack(eType, NFNetReceiveCallBack::Functor(functorPtr));
+}
+
+int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID,
+                                           const NFNetReceiveCallBack& xReceiveCallBack)
 {
     NF_SHARE_PTR<CallBack> xCallBack = mxCallBack.GetElement(eType);
     if (!xCallBack)
@@ -87,15 +98,15 @@ int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, const ui
         mxCallBack.AddElement(eType, xCallBack);
     }
 
-	std::list<NET_RECEIVE_FUNCTOR_PTR> xList;
-	xList.push_back(functorPtr);
+	std::list<NFNetReceiveCallBack> xList;
+	xList.push_back(xReceiveCallBack);
 
-    xCallBack->mxReceiveCallBack.insert(std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::value_type(nMsgID, xList));
+    xCallBack->mxReceiveCallBack.insert(std::map<int, std::list<NFNetReceiveCallBack>>::value_type(nMsgID, xList));
 
     return 0;
 }
 
-int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, NET_RECEIVE_FUNCTOR_PTR functorPtr)
+int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, const NFNetReceiveCallBack& xReceiveCallBack)
 {
     NF_SHARE_PTR<CallBack> xCallBack = mxCallBack.GetElement(eType);
     if (!xCallBack)
@@ -104,7 +115,7 @@ int NFCNetClientModule::AddReceiveCallBack(const NF_SERVER_TYPES eType, NET_RECE
         mxCallBack.AddElement(eType, xCallBack);
     }
 
-    xCallBack->mxCallBackList.push_back(functorPtr);
+    xCallBack->mxCallBackList.push_back(xReceiveCallBack);
 
     return 0;
 }
@@ -319,11 +330,11 @@ void NFCNetClientModule::InitCallBacks(NF_SHARE_PTR<ConnectData> pServerData)
     }
 
     //add msg callback
-    std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::iterator itReciveCB = xCallBack->mxReceiveCallBack.begin();
+    std::map<int, std::list<NFNetReceiveCallBack>>::iterator itReciveCB = xCallBack->mxReceiveCallBack.begin();
     for (; xCallBack->mxReceiveCallBack.end() != itReciveCB; ++itReciveCB)
     {
-		std::list<NET_RECEIVE_FUNCTOR_PTR>& xList = itReciveCB->second;
-		for (std::list<NET_RECEIVE_FUNCTOR_PTR>::iterator itList = xList.begin(); itList != xList.end(); ++itList)
+		std::list<NFNetReceiveCallBack>& xList = itReciveCB->second;
+		for (std::list<NFNetReceiveCallBack>::iterator itList = xList.begin(); itList != xList.end(); ++itList)
 		{
 			pServerData->mxNetModule->AddReceiveCallBack(itReciveCB->first, *itList);
 		}
@@ -336,7 +347,7 @@ void NFCNetClientModule::InitCallBacks(NF_SHARE_PTR<ConnectData> pServerData)
         pServerData->mxNetModule->AddEventCallBack(*itEventCB);
     }
 
-    std::list<NET_RECEIVE_FUNCTOR_PTR>::iterator itCB = xCallBack->mxCallBackList.begin();
+    std::list<NFNetReceiveCallBack>::iterator itCB = xCallBack->mxCallBackList.begin();
     for (; xCallBack->mxCallBackList.end() != itCB; ++itCB)
     {
         pServerData->mxNetModule->AddReceiveCallBack(*itCB);
@@ -379,7 +390,7 @@ void NFCNetClientModule::ProcessExecute()
                 break;
             case ConnectDataState::RECONNECT:
             {
-                if ((pServerData->mnLastActionTime + 10) >= GetPluginManager()->GetNowTime())
+                if ((pServerData->mnLastActionTime + 10000) >= NFFrameTimeMS())
                 {
                     break;
                 }
@@ -425,12 +436,12 @@ void NFCNetClientModule::LogServerInfo()
 
 void NFCNetClientModule::KeepState(NF_SHARE_PTR<ConnectData> pServerData)
 {
-    if (pServerData->mnLastActionTime + 10 > GetPluginManager()->GetNowTime())
+    if (pServerData->mnLastActionTime + 10000 > NFFrameTimeMS())
     {
         return;
     }
 
-    pServerData->mnLastActionTime = GetPluginManager()->GetNowTime();
+    pServerData->mnLastActionTime = NFFrameTimeMS();
 
     KeepReport(pServerData);
     LogServerInfo();
@@ -480,7 +491,7 @@ int NFCNetClientModule::OnDisConnected(const NFSOCK fd, NFINet* pNet)
         /////////////////////////////////////////////////////////////////////////////////////
         //RemoveServerWeightData(pServerInfo);
         pServerInfo->eState = ConnectDataState::DISCONNECT;
-        pServerInfo->mnLastActionTime = GetPluginManager()->GetNowTime();
+        pServerInfo->mnLastActionTime = NFFrameTimeMS();
 
         //for type--suit
         NF_SHARE_PTR<NFConsistentHashMapEx<int, ConnectData>> xConnectDataMap = mxServerTypeMap.GetElement(
@@ -515,7 +526,7 @@ void NFCNetClientModule::ProcessAddNetConnect()
             xServerData->strName = xInfo.strName;
             xServerData->eState = ConnectDataState::CONNECTING;
             xServerData->nPort = xInfo.nPort;
-            xServerData->mnLastActionTime = GetPluginManager()->GetNowTime();
+            xServerData->mnLastActionTime = NFFrameTimeMS();
 
             xServerData->mxNetModule = NF_SHARE_PTR<NFINetModule>(NF_NEW NFCNetModule(pPluginManager));
             xServerData->mxNetModule->Initialization(xServerData->strIP.c_str(), xServerData->nPort);
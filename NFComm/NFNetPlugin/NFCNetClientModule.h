@@ -13,6 +13,7 @@
 #include <iosfwd>
 #include "NFComm/NFCore/NFQueue.hpp"
 #include "NFComm/NFCore/NFConsistentHash.hpp"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
 #include "NFComm/NFMessageDefine/NFDefine.pb.h"
 #include "NFComm/NFPluginModule/NFINetClientModule.h"
 #include "NFComm/NFPluginModule/NFINetModule.h"
@@ -42,6 +43,10 @@ public:
     virtual int
     AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID, NET_RECEIVE_FUNCTOR_PTR functorPtr);
 
+    virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, const NFNetReceiveCallBack& xCallBack);
+
+    virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID, const NFNetReceiveCallBack& xCallBack);
+
     virtual int AddEventCallBack(const NF_SERVER_TYPES eType, NET_EVENT_FUNCTOR_PTR functorPtr);
 
     virtual void RemoveReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID);
@@ -124,7 +129,7 @@ private:
     //server_id, server_data
     NFConsistentHashMapEx<int, ConnectData> mxServerMap;
     //server_type, server_id, server_data
-    NFMapEx<int, NFConsistentHashMapEx<int, ConnectData>> mxServerTypeMap;
+    NFHashMapEx<int, NFConsistentHashMapEx<int, ConnectData>> mxServerTypeMap;
 
     std::list<ConnectData> mxTempNetList;
 
@@ -132,12 +137,12 @@ private:
     {
         //call back
 		//std::map<int, NET_RECEIVE_FUNCTOR_PTR> mxReceiveCallBack;
-		std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>> mxReceiveCallBack;
+		std::map<int, std::list<NFNetReceiveCallBack>> mxReceiveCallBack;
         std::list<NET_EVENT_FUNCTOR_PTR> mxEventCallBack;
-        std::list<NET_RECEIVE_FUNCTOR_PTR> mxCallBackList;
+        std::list<NFNetReceiveCallBack> mxCallBackList;
     };
 
-    NFMapEx<int, CallBack> mxCallBack;
+    NFHashMapEx<int, CallBack> mxCallBack;
 };
 
 #endif
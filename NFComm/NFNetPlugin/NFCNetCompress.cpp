@@ -0,0 +1,342 @@
+// -------------------------------------------------------------------------
+//    @FileName			:		NFCNetCompress.cpp
+//    @Author			:		LvSheng.Huang
+//    @Date				:		2017-10-17
+//    @Module			:		NFCNetCompress
+// -------------------------------------------------------------------------
+
+#include "NFCNetCompress.h"
+#include <cstring>
+
+#define NF_LZ4_HASH_LOG			12
+#define NF_LZ4_MIN_MATCH		4
+//the last match must start 12 bytes and end 5 bytes before the end of the block
+#define NF_LZ4_MF_LIMIT			12
+#define NF_LZ4_LAST_LITERALS	5
+#define NF_LZ4_MAX_DISTANCE		65535
+
+static inline uint32_t NFLZ4Read32(const unsigned char* p)
+{
+    uint32_t n = 0;
+    memcpy(&n, p, sizeof(n));
+    return n;
+}
+
+static inline uint32_t NFLZ4Hash(const uint32_t nSequence)
+{
+    return (nSequence * 2654435761U) >> (32 - NF_LZ4_HASH_LOG);
+}
+
+static inline bool NFLZ4WriteLength(unsigned char*& op, const unsigned char* oend, int nLength)
+{
+    while (nLength >= 255)
+    {
+        if (op >= oend)
+        {
+            return false;
+        }
+
+        *op++ = 255;
+        nLength -= 255;
+    }
+
+    if (op >= oend)
+    {
+        return false;
+    }
+
+    *op++ = (unsigned char)nLength;
+    return true;
+}
+
+NFCNetCompress::NFCNetCompress()
+{
+    mnDictionaryID = 0;
+    mxHash.resize(1 << NF_LZ4_HASH_LOG, 0);
+}
+
+void NFCNetCompress::SetDictionary(const std::string& strDictionary)
+{
+    //only the last 64K can be reached by an offset
+    if (strDictionary.length() > NF_LZ4_MAX_DISTANCE)
+    {
+        mstrDictionary = strDictionary.substr(strDictionary.length() - NF_LZ4_MAX_DISTANCE);
+    }
+    else
+    {
+        mstrDictionary = strDictionary;
+    }
+
+    mxDictionaryHash.clear();
+    mnDictionaryID = 0;
+
+    if (mstrDictionary.length() < NF_LZ4_MIN_MATCH)
+    {
+        mstrDictionary.clear();
+        return;
+    }
+
+    //FNV-1a, lets the peers check they loaded the same dictionary
+    mnDictionaryID = 2166136261U;
+    for (size_t i = 0; i < mstrDictionary.length(); ++i)
+    {
+        mnDictionaryID ^= (unsigned char)mstrDictionary[i];
+        mnDictionaryID *= 16777619U;
+    }
+
+    if (0 == mnDictionaryID)
+    {
+        mnDictionaryID = 1;
+    }
+
+    //later positions overwrite the earlier ones, they are closer to the data
+    mxDictionaryHash.resize(1 << NF_LZ4_HASH_LOG, 0);
+    const unsigned char* pDict = (const unsigned char*)mstrDictionary.data();
+    for (size_t i = 0; i + NF_LZ4_MIN_MATCH <= mstrDictionary.length(); ++i)
+    {
+        mxDictionaryHash[NFLZ4Hash(NFLZ4Read32(pDict + i))] = i + 1;
+    }
+}
+
+uint32_t NFCNetCompress::GetDictionaryID() const
+{
+    return mnDictionaryID;
+}
+
+int NFCNetCompress::CompressBound(const int nSrcLen)
+{
+    return nSrcLen + nSrcLen / 255 + 16;
+}
+
+int NFCNetCompress::Compress(const char* pSrc, const int nSrcLen, char* pDst, const int nCapacity)
+{
+    const unsigned char* const istart = (const unsigned char*)pSrc;
+    const unsigned char* const iend = istart + nSrcLen;
+    const unsigned char* const mflimit = iend - NF_LZ4_MF_LIMIT;
+    const unsigned char* const matchlimit = iend - NF_LZ4_LAST_LITERALS;
+    const unsigned char* ip = istart;
+    const unsigned char* anchor = istart;
+
+    unsigned char* op = (unsigned char*)pDst;
+    unsigned char* const oend = op + nCapacity;
+
+    const unsigned char* const pDict = (const unsigned char*)mstrDictionary.data();
+    const int nDictLen = (int)mstrDictionary.length();
+
+    memset(&mxHash[0], 0, mxHash.size() * sizeof(uint32_t));
+
+    while (nSrcLen > NF_LZ4_MF_LIMIT && ip < mflimit)
+    {
+        const uint32_t nSequence = NFLZ4Read32(ip);
+        const uint32_t nHash = NFLZ4Hash(nSequence);
+        const uint32_t nCandidate = mxHash[nHash];
+        mxHash[nHash] = (uint32_t)(ip - istart) + 1;
+
+        int nMatchLen = 0;
+        int nOffset = 0;
+
+        if (nCandidate > 0)
+        {
+            const unsigned char* pRef = istart + nCandidate - 1;
+            if (ip - pRef <= NF_LZ4_MAX_DISTANCE && NFLZ4Read32(pRef) == nSequence)
+            {
+                nMatchLen = NF_LZ4_MIN_MATCH;
+                while (ip + nMatchLen < matchlimit && pRef[nMatchLen] == ip[nMatchLen])
+                {
+                    nMatchLen++;
+                }
+
+                nOffset = (int)(ip - pRef);
+            }
+        }
+
+        if (0 == nMatchLen && nDictLen > 0 && mxDictionaryHash[nHash] > 0)
+        {
+            const int nDictPos = mxDictionaryHash[nHash] - 1;
+            const int nDistance = (int)(ip - istart) + nDictLen - nDictPos;
+            if (nDistance <= NF_LZ4_MAX_DISTANCE && NFLZ4Read32(pDict + nDictPos) == nSequence)
+            {
+                //the match stops at the end of the dictionary
+                nMatchLen = NF_LZ4_MIN_MATCH;
+                while (nDictPos + nMatchLen < nDictLen && ip + nMatchLen < matchlimit && pDict[nDictPos + nMatchLen] == ip[nMatchLen])
+                {
+                    nMatchLen++;
+                }
+
+                nOffset = nDistance;
+            }
+        }
+
+        if (0 == nMatchLen)
+        {
+            ip++;
+            continue;
+        }
+
+        //token | literal length | literals | offset | match length
+        const int nLiteralLen = (int)(ip - anchor);
+        if (op + 1 + nLiteralLen + nLiteralLen / 255 + 1 + 2 > oend)
+        {
+            return 0;
+        }
+
+        unsigned char* pToken = op++;
+        if (nLiteralLen >= 15)
+        {
+            *pToken = 15 << 4;
+            if (!NFLZ4WriteLength(op, oend, nLiteralLen - 15))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            *pToken = (unsigned char)(nLiteralLen << 4);
+        }
+
+        memcpy(op, anchor, nLiteralLen);
+        op += nLiteralLen;
+
+        *op++ = (unsigned char)(nOffset & 0xFF);
+        *op++ = (unsigned char)(nOffset >> 8);
+
+        const int nExtraMatchLen = nMatchLen - NF_LZ4_MIN_MATCH;
+        if (nExtraMatchLen >= 15)
+        {
+            *pToken |= 15;
+            if (!NFLZ4WriteLength(op, oend, nExtraMatchLen - 15))
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            *pToken |= (unsigned char)nExtraMatchLen;
+        }
+
+        ip += nMatchLen;
+        anchor = ip;
+    }
+
+    //the last literals
+    const int nLiteralLen = (int)(iend - anchor);
+    if (op + 1 + nLiteralLen + nLiteralLen / 255 + 1 > oend)
+    {
+        return 0;
+    }
+
+    unsigned char* pToken = op++;
+    if (nLiteralLen >= 15)
+    {
+        *pToken = 15 << 4;
+        if (!NFLZ4WriteLength(op, oend, nLiteralLen - 15))
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        *pToken = (unsigned char)(nLiteralLen << 4);
+    }
+
+    memcpy(op, anchor, nLiteralLen);
+    op += nLiteralLen;
+
+    return (int)(op - (unsigned char*)pDst);
+}
+
+bool NFCNetCompress::DeCompress(const char* pSrc, const int nSrcLen, char* pDst, const int nDstLen) const
+{
+    const unsigned char* ip = (const unsigned char*)pSrc;
+    const unsigned char* const iend = ip + nSrcLen;
+    unsigned char* const ostart = (unsigned char*)pDst;
+    unsigned char* op = ostart;
+    unsigned char* const oend = ostart + nDstLen;
+
+    const unsigned char* const pDict = (const unsigned char*)mstrDictionary.data();
+    const int nDictLen = (int)mstrDictionary.length();
+
+    while (ip < iend)
+    {
+        const unsigned char nToken = *ip++;
+
+        int nLiteralLen = nToken >> 4;
+        if (15 == nLiteralLen)
+        {
+            unsigned char n = 255;
+            while (255 == n)
+            {
+                if (ip >= iend)
+                {
+                    return false;
+                }
+
+                n = *ip++;
+                nLiteralLen += n;
+            }
+        }
+
+        if (nLiteralLen > iend - ip || nLiteralLen > oend - op)
+        {
+            return false;
+        }
+
+        memcpy(op, ip, nLiteralLen);
+        ip += nLiteralLen;
+        op += nLiteralLen;
+
+        if (ip == iend)
+        {
+            //the last sequence has no match
+            break;
+        }
+
+        if (iend - ip < 2)
+        {
+            return false;
+        }
+
+        const int nOffset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        int nMatchLen = nToken & 15;
+        if (15 == nMatchLen)
+        {
+            unsigned char n = 255;
+            while (255 == n)
+            {
+                if (ip >= iend)
+                {
+                    return false;
+                }
+
+                n = *ip++;
+                nMatchLen += n;
+            }
+        }
+
+        nMatchLen += NF_LZ4_MIN_MATCH;
+
+        const int nProduced = (int)(op - ostart);
+        if (0 == nOffset || nOffset > nProduced + nDictLen || nMatchLen > oend - op)
+        {
+            return false;
+        }
+
+        if (nOffset <= nProduced && nOffset >= nMatchLen)
+        {
+            memcpy(op, op - nOffset, nMatchLen);
+            op += nMatchLen;
+            continue;
+        }
+
+        //overlapped or starts in the dictionary
+        for (int i = 0; i < nMatchLen; ++i)
+        {
+            const int nPos = nProduced + i - nOffset;
+            *op++ = nPos < 0 ? pDict[nDictLen + nPos] : ostart[nPos];
+        }
+    }
+
+    return op == oend;
+}
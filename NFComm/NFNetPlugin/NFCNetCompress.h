@@ -0,0 +1,44 @@
+// -------------------------------------------------------------------------
+//    @FileName			:		NFCNetCompress.h
+//    @Author			:		LvSheng.Huang
+//    @Date				:		2017-10-17
+//    @Module			:		NFCNetCompress
+// -------------------------------------------------------------------------
+
+#ifndef NFC_NET_COMPRESS_H
+#define NFC_NET_COMPRESS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//LZ4 block format, so clients can unpack it with any lz4 library(LZ4_decompress_safe_usingDict)
+//the dictionary is raw sample traffic used as the history before every message, both sides must load the same bytes
+class NFCNetCompress
+{
+public:
+    NFCNetCompress();
+
+    void SetDictionary(const std::string& strDictionary);
+
+    //0 means no dictionary
+    uint32_t GetDictionaryID() const;
+
+    static int CompressBound(const int nSrcLen);
+
+    //returns the length written into pDst, 0 if it does not fit into nCapacity
+    int Compress(const char* pSrc, const int nSrcLen, char* pDst, const int nCapacity);
+
+    //nDstLen must be the exact length of the original data, thread safe
+    bool DeCompress(const char* pSrc, const int nSrcLen, char* pDst, const int nDstLen) const;
+
+private:
+    std::string mstrDictionary;
+    uint32_t mnDictionaryID;
+
+    //hash of 4 bytes -> position + 1, 0 means empty
+    std::vector<uint32_t> mxDictionaryHash;
+    std::vector<uint32_t> mxHash;
+};
+
+#endif
@@ -12,8 +12,19 @@ NFCNetModule::NFCNetModule(NFIPluginManager* p)
     pPluginManager = p;
 
     mnBufferSize = 0;
-    nLastTime = GetPluginManager()->GetNowTime();
+    mnIOThreadCount = 0;
+    mbSendBatching = false;
+    mnSendHighWater = 0;
+    mnCompressThreshold = 0;
+    mbCompressHello = false;
+    mnThrottleHighWater = 0;
+    mnThrottleLowWater = 0;
+    mnThrottleCloseWater = 0;
+    nLastTime = NFFrameTimeMS();
     m_pNet = NULL;
+
+    mbReceiveStat = false;
+    memset(mxReceivePage, 0, sizeof(mxReceivePage));
 }
 
 NFCNetModule::~NFCNetModule()
@@ -25,12 +36,20 @@ NFCNetModule::~NFCNetModule()
 
     delete m_pNet;
     m_pNet = NULL;
+
+    for (int i = 0; i < NF_NET_RECEIVE_PAGE_COUNT; ++i)
+    {
+        delete mxReceivePage[i];
+        mxReceivePage[i] = NULL;
+    }
 }
 
 void NFCNetModule::Initialization(const char* strIP, const unsigned short nPort)
 {
     m_pNet = NF_NEW NFCNet(this, &NFCNetModule::OnReceiveNetPack, &NFCNetModule::OnSocketNetEvent);
     m_pNet->ExpandBufferSize(mnBufferSize);
+    m_pNet->SetSendBatching(mbSendBatching, mnSendHighWater);
+    m_pNet->SetCompress(mnCompressThreshold, mstrCompressDictionary, mbCompressHello);
     m_pNet->Initialization(strIP, nPort);
 }
 
@@ -38,6 +57,17 @@ int NFCNetModule::Initialization(const unsigned int nMaxClient, const unsigned s
 {
     m_pNet = NF_NEW NFCNet(this, &NFCNetModule::OnReceiveNetPack, &NFCNetModule::OnSocketNetEvent);
     m_pNet->ExpandBufferSize(mnBufferSize);
+    m_pNet->SetIOThreadCount(mnIOThreadCount);
+    m_pNet->SetSendBatching(mbSendBatching, mnSendHighWater);
+    m_pNet->SetCompress(mnCompressThreshold, mstrCompressDictionary, mbCompressHello);
+    m_pNet->SetThrottle(mnThrottleHighWater, mnThrottleLowWater, mnThrottleCloseWater);
+
+    std::map<int, NFNetThrottleMsg>::iterator it = mxThrottleMsg.begin();
+    for (; it != mxThrottleMsg.end(); ++it)
+    {
+        m_pNet->SetThrottleMsg(it->first, it->second.eThrottle, it->second.xKeyFunctor);
+    }
+
     return m_pNet->Initialization(nMaxClient, nPort, nCpuCount);
 }
 
@@ -55,32 +85,116 @@ int NFCNetModule::ExpandBufferSize(const unsigned int size)
     return mnBufferSize;
 }
 
+int NFCNetModule::SetIOThreadCount(const unsigned int nCount)
+{
+    mnIOThreadCount = nCount;
+    if (m_pNet)
+    {
+        m_pNet->SetIOThreadCount(mnIOThreadCount);
+    }
+
+    return mnIOThreadCount;
+}
+
+void NFCNetModule::SetSendBatching(const bool bBatching, const unsigned int nHighWater)
+{
+    mbSendBatching = bBatching;
+    mnSendHighWater = nHighWater;
+    if (m_pNet)
+    {
+        m_pNet->SetSendBatching(mbSendBatching, mnSendHighWater);
+    }
+}
+
+void NFCNetModule::SetCompress(const unsigned int nThreshold, const std::string& strDictionaryFile, const bool bHello)
+{
+    mnCompressThreshold = nThreshold;
+    mbCompressHello = bHello;
+    mstrCompressDictionary.clear();
+
+    if (!strDictionaryFile.empty())
+    {
+        //without the dictionary the peers which loaded it refuse to compress, they do not get broken data
+        std::string strFile = pPluginManager->GetConfigPath() + strDictionaryFile;
+        pPluginManager->GetFileContent(strFile, mstrCompressDictionary);
+    }
+
+    if (m_pNet)
+    {
+        m_pNet->SetCompress(mnCompressThreshold, mstrCompressDictionary, mbCompressHello);
+    }
+}
+
+void NFCNetModule::SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater)
+{
+    mnThrottleHighWater = nHighWater;
+    mnThrottleLowWater = nLowWater;
+    mnThrottleCloseWater = nCloseWater;
+
+    if (m_pNet)
+    {
+        m_pNet->SetThrottle(mnThrottleHighWater, mnThrottleLowWater, mnThrottleCloseWater);
+    }
+}
+
+void NFCNetModule::SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor)
+{
+    NFNetThrottleMsg& xThrottleMsg = mxThrottleMsg[nMsgID];
+    xThrottleMsg.eThrottle = eThrottle;
+    xThrottleMsg.xKeyFunctor = xKeyFunctor;
+
+    if (m_pNet)
+    {
+        m_pNet->SetThrottleMsg(nMsgID, eThrottle, xKeyFunctor);
+    }
+}
+
 void NFCNetModule::RemoveReceiveCallBack(const int nMsgID)
 {
-    std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::iterator it = mxReceiveCallBack.find(nMsgID);
+    std::map<int, std::list<NFNetReceiveCallBack>>::iterator it = mxReceiveCallBack.find(nMsgID);
     if (mxReceiveCallBack.end() != it)
     {
         mxReceiveCallBack.erase(it);
+
+        RebuildReceiveSlot(nMsgID);
     }
 }
 
 bool NFCNetModule::AddReceiveCallBack(const int nMsgID, const NET_RECEIVE_FUNCTOR_PTR& cb)
 {
+    return AddReceiveCallBack(nMsgID, NFNetReceiveCallBack::Functor(cb));
+}
+
+bool NFCNetModule::AddReceiveCallBack(const NET_RECEIVE_FUNCTOR_PTR& cb)
+{
+    return AddReceiveCallBack(NFNetReceiveCallBack::Functor(cb));
+}
+
+bool NFCNetModule::AddReceiveCallBack(const int nMsgID, const NFNetReceiveCallBack& cb)
+{
+    if (NULL == GetReceivePage(nMsgID, true))
+    {
+        return false;
+    }
+
     if (mxReceiveCallBack.find(nMsgID) == mxReceiveCallBack.end())
     {
-		std::list<NET_RECEIVE_FUNCTOR_PTR> xList;
+		std::list<NFNetReceiveCallBack> xList;
 		xList.push_back(cb);
-		mxReceiveCallBack.insert(std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::value_type(nMsgID, xList));
-        return true;
+		mxReceiveCallBack.insert(std::map<int, std::list<NFNetReceiveCallBack>>::value_type(nMsgID, xList));
+    }
+    else
+    {
+        std::map<int, std::list<NFNetReceiveCallBack>>::iterator it = mxReceiveCallBack.find(nMsgID);
+        it->second.push_back(cb);
     }
 
-	std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::iterator it = mxReceiveCallBack.find(nMsgID);
-	it->second.push_back(cb);
+    RebuildReceiveSlot(nMsgID);
 
     return true;
 }
 
-bool NFCNetModule::AddReceiveCallBack(const NET_RECEIVE_FUNCTOR_PTR& cb)
+bool NFCNetModule::AddReceiveCallBack(const NFNetReceiveCallBack& cb)
 {
     mxCallBackList.push_back(cb);
 
@@ -94,6 +208,44 @@ bool NFCNetModule::AddEventCallBack(const NET_EVENT_FUNCTOR_PTR& cb)
     return true;
 }
 
+void NFCNetModule::SetReceiveStat(const bool bOpen)
+{
+    if (bOpen && !mbReceiveStat)
+    {
+        //start over
+        for (int i = 0; i < NF_NET_RECEIVE_PAGE_COUNT; ++i)
+        {
+            if (mxReceivePage[i])
+            {
+                delete[] mxReceivePage[i]->pStat;
+                mxReceivePage[i]->pStat = NULL;
+            }
+        }
+    }
+
+    mbReceiveStat = bOpen;
+}
+
+void NFCNetModule::GetReceiveStat(std::map<int, NFNetReceiveStat>& xStatMap)
+{
+    for (int i = 0; i < NF_NET_RECEIVE_PAGE_COUNT; ++i)
+    {
+        if (NULL == mxReceivePage[i] || NULL == mxReceivePage[i]->pStat)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < NF_NET_RECEIVE_PAGE_SIZE; ++j)
+        {
+            const NFNetReceiveStat& xStat = mxReceivePage[i]->pStat[j];
+            if (xStat.nCount > 0)
+            {
+                xStatMap[(i << NF_NET_RECEIVE_PAGE_BITS) | j] = xStat;
+            }
+        }
+    }
+}
+
 bool NFCNetModule::Execute()
 {
     if (!m_pNet)
@@ -118,13 +270,17 @@ bool NFCNetModule::SendMsgToAllClientWithOutHead(const int nMsgID, const std::st
 }
 
 bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Message& xData, const NFSOCK nSockIndex)
+{
+    return SendMsgPB(nMsgID, xData, nSockIndex, NFGUID(), NULL);
+}
+
+bool NFCNetModule::SendMsgPBToAllClient(const uint16_t nMsgID, const google::protobuf::Message& xData)
 {
     NFMsg::MsgBase xMsg;
     if (!xData.SerializeToString(xMsg.mutable_msg_data()))
     {
         char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgData, MessageID: %d\n",
-                  (int) nSockIndex, nMsgID);
+        NFSPRINTF(szData, MAX_PATH, "Send Message to all Failed For Serialize of MsgData, MessageID: %d\n", nMsgID);
 
         return false;
     }
@@ -136,45 +292,61 @@ bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Mess
     if (!xMsg.SerializeToString(&strMsg))
     {
         char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgBase, MessageID: %d\n",
-                  (int) nSockIndex, nMsgID);
+        NFSPRINTF(szData, MAX_PATH, "Send Message to all Failed For Serialize of MsgBase, MessageID: %d\n", nMsgID);
 
         return false;
     }
 
-    SendMsgWithOutHead(nMsgID, strMsg, nSockIndex);
-
-    return true;
+    return SendMsgToAllClientWithOutHead(nMsgID, strMsg);
 }
 
-bool NFCNetModule::SendMsgPBToAllClient(const uint16_t nMsgID, const google::protobuf::Message& xData)
+bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Message& xData, const NFSOCK nSockIndex,
+                             const NFGUID nPlayer, const std::vector<NFGUID>* pClientIDList)
 {
     NFMsg::MsgBase xMsg;
-    if (!xData.SerializeToString(xMsg.mutable_msg_data()))
+    NFMsg::Ident* pPlayerID = xMsg.mutable_player_id();
+    *pPlayerID = NFToPB(nPlayer);
+    if (pClientIDList)
     {
-        char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to all Failed For Serialize of MsgData, MessageID: %d\n", nMsgID);
+        for (size_t i = 0; i < pClientIDList->size(); ++i)
+        {
+            const NFGUID& ClientID = (*pClientIDList)[i];
 
-        return false;
+            NFMsg::Ident* pData = xMsg.add_player_client_list();
+            if (pData)
+            {
+                *pData = NFToPB(ClientID);
+            }
+        }
     }
 
-    NFMsg::Ident* pPlayerID = xMsg.mutable_player_id();
-    *pPlayerID = NFToPB(NFGUID());
+    return SendMsgBase(nMsgID, xMsg, &xData, NULL, nSockIndex);
+}
 
-    std::string strMsg;
-    if (!xMsg.SerializeToString(&strMsg))
+bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const std::string& strData, const NFSOCK nSockIndex,
+                             const NFGUID nPlayer, const std::vector<NFGUID>* pClientIDList)
+{
+    NFMsg::MsgBase xMsg;
+    NFMsg::Ident* pPlayerID = xMsg.mutable_player_id();
+    *pPlayerID = NFToPB(nPlayer);
+    if (pClientIDList)
     {
-        char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to all Failed For Serialize of MsgBase, MessageID: %d\n", nMsgID);
+        for (size_t i = 0; i < pClientIDList->size(); ++i)
+        {
+            const NFGUID& ClientID = (*pClientIDList)[i];
 
-        return false;
+            NFMsg::Ident* pData = xMsg.add_player_client_list();
+            if (pData)
+            {
+                *pData = NFToPB(ClientID);
+            }
+        }
     }
 
-    return SendMsgToAllClientWithOutHead(nMsgID, strMsg);
+    return SendMsgBase(nMsgID, xMsg, NULL, &strData, nSockIndex);
 }
 
-bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Message& xData, const NFSOCK nSockIndex,
-                             const NFGUID nPlayer, const std::vector<NFGUID>* pClientIDList)
+bool NFCNetModule::SendMsgBase(const uint16_t nMsgID, NFMsg::MsgBase& xMsg, const google::protobuf::Message* pData, const std::string* pstrData, const NFSOCK nSockIndex)
 {
     if (!m_pNet)
     {
@@ -185,8 +357,7 @@ bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Mess
         return false;
     }
 
-    NFMsg::MsgBase xMsg;
-    if (!xData.SerializeToString(xMsg.mutable_msg_data()))
+    if (pData && !pData->IsInitialized())
     {
         char szData[MAX_PATH] = {0};
         NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgData, MessageID: %d\n",
@@ -195,109 +366,177 @@ bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const google::protobuf::Mess
         return false;
     }
 
+    //msg_data goes after the other fields of MsgBase, so the user message can be serialized straight into the send buffer
+    const uint32_t nTag = google::protobuf::internal::WireFormatLite::MakeTag(NFMsg::MsgBase::kMsgDataFieldNumber,
+                          google::protobuf::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    const int nDataLength = pData ? pData->ByteSize() : (int) pstrData->length();
+    const int nLength = xMsg.ByteSize() + google::protobuf::io::CodedOutputStream::VarintSize32(nTag)
+                        + google::protobuf::io::CodedOutputStream::VarintSize32(nDataLength) + nDataLength;
 
-    NFMsg::Ident* pPlayerID = xMsg.mutable_player_id();
-    *pPlayerID = NFToPB(nPlayer);
-    if (pClientIDList)
+    google::protobuf::uint8* pTarget = (google::protobuf::uint8*) m_pNet->ReserveMsg(nMsgID, nLength, nSockIndex);
+    if (NULL == pTarget)
     {
-        for (int i = 0; i < pClientIDList->size(); ++i)
+        //the connection packs big messages, it needs the whole MsgBase in one piece
+        if (pData)
         {
-            const NFGUID& ClientID = (*pClientIDList)[i];
+            pData->SerializeToString(xMsg.mutable_msg_data());
+        }
+        else
+        {
+            xMsg.set_msg_data(*pstrData);
+        }
 
-            NFMsg::Ident* pData = xMsg.add_player_client_list();
-            if (pData)
-            {
-                *pData = NFToPB(ClientID);
-            }
+        std::string strMsg;
+        if (!xMsg.SerializeToString(&strMsg))
+        {
+            char szData[MAX_PATH] = {0};
+            NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgBase, MessageID: %d\n",
+                      (int) nSockIndex, nMsgID);
+
+            return false;
         }
+
+        return SendMsgWithOutHead(nMsgID, strMsg, nSockIndex);
     }
 
-    std::string strMsg;
-    if (!xMsg.SerializeToString(&strMsg))
+    //the sizes have been cached by ByteSize above
+    pTarget = xMsg.SerializeWithCachedSizesToArray(pTarget);
+    pTarget = google::protobuf::io::CodedOutputStream::WriteTagToArray(nTag, pTarget);
+    pTarget = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(nDataLength, pTarget);
+    if (pData)
     {
-        char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgBase, MessageID: %d\n",
-                  (int) nSockIndex, nMsgID);
-
-        return false;
+        pData->SerializeWithCachedSizesToArray(pTarget);
+    }
+    else
+    {
+        memcpy(pTarget, pstrData->data(), nDataLength);
     }
 
-    return SendMsgWithOutHead(nMsgID, strMsg, nSockIndex);
+    return m_pNet->CommitMsg();
 }
 
-bool NFCNetModule::SendMsgPB(const uint16_t nMsgID, const std::string& strData, const NFSOCK nSockIndex,
-                             const NFGUID nPlayer, const std::vector<NFGUID>* pClientIDList)
+NFINet* NFCNetModule::GetNet()
 {
-    if (!m_pNet)
+    return m_pNet;
+}
+
+void NFCNetModule::OnReceiveNetPack(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+{
+    if (!mbReceiveStat)
     {
-        char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For NULL Of Net, MessageID: %d\n", (int) nSockIndex,
-                  nMsgID);
-        //LogSend(szData);
+        DispatchNetPack(nSockIndex, nMsgID, msg, nLen);
+        return;
+    }
 
-        return false;
+    std::chrono::steady_clock::time_point xStartTime = std::chrono::steady_clock::now();
+
+    DispatchNetPack(nSockIndex, nMsgID, msg, nLen);
+
+    const int64_t nTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - xStartTime).count();
+
+    NFNetReceivePage* pPage = GetReceivePage(nMsgID, true);
+    if (NULL == pPage)
+    {
+        return;
     }
 
-    NFMsg::MsgBase xMsg;
-    xMsg.set_msg_data(strData.data(), strData.length());
+    if (NULL == pPage->pStat)
+    {
+        pPage->pStat = new NFNetReceiveStat[NF_NET_RECEIVE_PAGE_SIZE];
+    }
 
+    NFNetReceiveStat& xStat = pPage->pStat[nMsgID & (NF_NET_RECEIVE_PAGE_SIZE - 1)];
+    xStat.nCount++;
+    xStat.nTotalTime += nTime;
+    if (nTime > xStat.nMaxTime)
+    {
+        xStat.nMaxTime = nTime;
+    }
 
-    NFMsg::Ident* pPlayerID = xMsg.mutable_player_id();
-    *pPlayerID = NFToPB(nPlayer);
-    if (pClientIDList)
+    int nBucket = 0;
+    while (nBucket < NF_NET_RECEIVE_STAT_BUCKET - 1 && ((int64_t)1 << nBucket) <= nTime)
+    {
+        nBucket++;
+    }
+
+    xStat.xHistogram[nBucket]++;
+}
+
+void NFCNetModule::DispatchNetPack(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+{
+    NFNetReceivePage* pPage = GetReceivePage(nMsgID, false);
+    if (pPage)
     {
-        for (int i = 0; i < pClientIDList->size(); ++i)
+        NFNetReceiveSlot& xSlot = pPage->xSlot[nMsgID & (NF_NET_RECEIVE_PAGE_SIZE - 1)];
+        if (xSlot.nCount > 0)
         {
-            const NFGUID& ClientID = (*pClientIDList)[i];
+            xSlot.xHandler(nSockIndex, nMsgID, msg, nLen);
 
-            NFMsg::Ident* pData = xMsg.add_player_client_list();
-            if (pData)
+            //by index, a handler may add another one for the same id
+            for (size_t i = 0; i < xSlot.xMoreHandler.size(); ++i)
             {
-                *pData = NFToPB(ClientID);
+                xSlot.xMoreHandler[i](nSockIndex, nMsgID, msg, nLen);
             }
+
+            return;
         }
     }
 
-    std::string strMsg;
-    if (!xMsg.SerializeToString(&strMsg))
+    for (std::list<NFNetReceiveCallBack>::iterator itList = mxCallBackList.begin(); itList != mxCallBackList.end(); ++itList)
     {
-        char szData[MAX_PATH] = {0};
-        NFSPRINTF(szData, MAX_PATH, "Send Message to %d Failed For Serialize of MsgBase, MessageID: %d\n",
-                  (int) nSockIndex, nMsgID);
-        //LogSend(szData);
-
-        return false;
+        itList->xHandler(nSockIndex, nMsgID, msg, nLen);
     }
-
-    return SendMsgWithOutHead(nMsgID, strMsg, nSockIndex);
 }
 
-NFINet* NFCNetModule::GetNet()
+NFNetReceivePage* NFCNetModule::GetReceivePage(const int nMsgID, const bool bCreate)
 {
-    return m_pNet;
+    if (nMsgID < 0 || nMsgID >= (NF_NET_RECEIVE_PAGE_COUNT << NF_NET_RECEIVE_PAGE_BITS))
+    {
+        return NULL;
+    }
+
+    NFNetReceivePage*& pPage = mxReceivePage[nMsgID >> NF_NET_RECEIVE_PAGE_BITS];
+    if (NULL == pPage && bCreate)
+    {
+        pPage = new NFNetReceivePage();
+    }
+
+    return pPage;
 }
 
-void NFCNetModule::OnReceiveNetPack(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+void NFCNetModule::RebuildReceiveSlot(const int nMsgID)
 {
-    std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>>::iterator it = mxReceiveCallBack.find(nMsgID);
-    if (mxReceiveCallBack.end() != it)
+    NFNetReceivePage* pPage = GetReceivePage(nMsgID, false);
+    if (NULL == pPage)
+    {
+        return;
+    }
+
+    NFNetReceiveSlot& xSlot = pPage->xSlot[nMsgID & (NF_NET_RECEIVE_PAGE_SIZE - 1)];
+    xSlot.nCount = 0;
+    xSlot.xMoreHandler.clear();
+
+    std::map<int, std::list<NFNetReceiveCallBack>>::iterator it = mxReceiveCallBack.find(nMsgID);
+    if (mxReceiveCallBack.end() == it)
+    {
+        return;
+    }
+
+    std::list<NFNetReceiveCallBack>& xFunList = it->second;
+    for (std::list<NFNetReceiveCallBack>::iterator itList = xFunList.begin(); itList != xFunList.end(); ++itList)
     {
-		std::list<NET_RECEIVE_FUNCTOR_PTR>& xFunList = it->second;
-		for (std::list<NET_RECEIVE_FUNCTOR_PTR>::iterator itList = xFunList.begin(); itList != xFunList.end(); ++itList)
-		{
-			NET_RECEIVE_FUNCTOR_PTR& pFunPtr = *itList;
-			NET_RECEIVE_FUNCTOR* pFunc = pFunPtr.get();
-			pFunc->operator()(nSockIndex, nMsgID, msg, nLen);
-		}
-    } 
-	else
-    {
-        for (std::list<NET_RECEIVE_FUNCTOR_PTR>::iterator itList = mxCallBackList.begin(); itList != mxCallBackList.end(); ++itList)
+        const NFNetReceiveHandler& xHandler = itList->xHandler;
+
+        if (0 == xSlot.nCount)
         {
-            NET_RECEIVE_FUNCTOR_PTR& pFunPtr = *itList;
-            NET_RECEIVE_FUNCTOR* pFunc = pFunPtr.get();
-            pFunc->operator()(nSockIndex, nMsgID, msg, nLen);
+            xSlot.xHandler = xHandler;
         }
+        else
+        {
+            xSlot.xMoreHandler.push_back(xHandler);
+        }
+
+        xSlot.nCount++;
     }
 }
 
@@ -324,12 +563,12 @@ void NFCNetModule::KeepAlive()
         return;
     }
 
-    if (nLastTime + 10 > GetPluginManager()->GetNowTime())
+    if (nLastTime + 10000 > NFFrameTimeMS())
     {
         return;
     }
 
-    nLastTime = GetPluginManager()->GetNowTime();
+    nLastTime = NFFrameTimeMS();
 
     NFMsg::ServerHeartBeat xMsg;
     xMsg.set_count(0);
@@ -27,6 +27,41 @@
 #pragma warning(default: 4244 4267)
 #endif
 
+//message ids are uint16, the table is paged so a module only pays for the ranges it handles
+#define NF_NET_RECEIVE_PAGE_BITS	8
+#define NF_NET_RECEIVE_PAGE_SIZE	(1 << NF_NET_RECEIVE_PAGE_BITS)
+#define NF_NET_RECEIVE_PAGE_COUNT	(65536 >> NF_NET_RECEIVE_PAGE_BITS)
+
+//most message ids have only one handler, the others spill into the vector
+struct NFNetReceiveSlot
+{
+    NFNetReceiveSlot()
+    {
+        nCount = 0;
+    }
+
+    int nCount;
+    NFNetReceiveHandler xHandler;
+    std::vector<NFNetReceiveHandler> xMoreHandler;
+};
+
+struct NFNetReceivePage
+{
+    NFNetReceivePage()
+    {
+        pStat = NULL;
+    }
+
+    ~NFNetReceivePage()
+    {
+        delete[] pStat;
+    }
+
+    NFNetReceiveSlot xSlot[NF_NET_RECEIVE_PAGE_SIZE];
+    //only allocated when the stat is open
+    NFNetReceiveStat* pStat;
+};
+
 class NFCNetModule
         : public NFINetModule
 {
@@ -43,14 +78,32 @@ public:
 
     virtual int ExpandBufferSize(const unsigned int size = 1024 * 1024 * 20);
 
+    virtual int SetIOThreadCount(const unsigned int nCount);
+
+    virtual void SetSendBatching(const bool bBatching, const unsigned int nHighWater = 0);
+
+    virtual void SetCompress(const unsigned int nThreshold, const std::string& strDictionaryFile = "", const bool bHello = false);
+
+    virtual void SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater);
+
+    virtual void SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor = NET_COALESCE_FUNCTOR());
+
     virtual void RemoveReceiveCallBack(const int nMsgID);
 
     virtual bool AddReceiveCallBack(const int nMsgID, const NET_RECEIVE_FUNCTOR_PTR& cb);
 
     virtual bool AddReceiveCallBack(const NET_RECEIVE_FUNCTOR_PTR& cb);
 
+    virtual bool AddReceiveCallBack(const int nMsgID, const NFNetReceiveCallBack& cb);
+
+    virtual bool AddReceiveCallBack(const NFNetReceiveCallBack& cb);
+
     virtual bool AddEventCallBack(const NET_EVENT_FUNCTOR_PTR& cb);
 
+    virtual void SetReceiveStat(const bool bOpen);
+
+    virtual void GetReceiveStat(std::map<int, NFNetReceiveStat>& xStatMap);
+
     virtual bool Execute();
 
 
@@ -78,14 +131,33 @@ protected:
 
     void KeepAlive();
 
+    void DispatchNetPack(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen);
+    NFNetReceivePage* GetReceivePage(const int nMsgID, const bool bCreate);
+    void RebuildReceiveSlot(const int nMsgID);
+
+    bool SendMsgBase(const uint16_t nMsgID, NFMsg::MsgBase& xMsg, const google::protobuf::Message* pData, const std::string* pstrData, const NFSOCK nSockIndex);
+
 private:
 
     int mnBufferSize;
+    int mnIOThreadCount;
+    bool mbSendBatching;
+    unsigned int mnSendHighWater;
+    unsigned int mnCompressThreshold;
+    std::string mstrCompressDictionary;
+    bool mbCompressHello;
+    unsigned int mnThrottleHighWater;
+    unsigned int mnThrottleLowWater;
+    unsigned int mnThrottleCloseWater;
+    std::map<int, NFNetThrottleMsg> mxThrottleMsg;
     NFINet* m_pNet;
     NFINT64 nLastTime;
-	std::map<int, std::list<NET_RECEIVE_FUNCTOR_PTR>> mxReceiveCallBack;
+    //owns the handler contexts, the pages only point to them
+	std::map<int, std::list<NFNetReceiveCallBack>> mxReceiveCallBack;
+    NFNetReceivePage* mxReceivePage[NF_NET_RECEIVE_PAGE_COUNT];
+    bool mbReceiveStat;
     std::list<NET_EVENT_FUNCTOR_PTR> mxEventCallBackList;
-    std::list<NET_RECEIVE_FUNCTOR_PTR> mxCallBackList;
+    std::list<NFNetReceiveCallBack> mxCallBackList;
 };
 
 #endif
\ No newline at end of file
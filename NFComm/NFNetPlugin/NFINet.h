@@ -56,14 +56,39 @@ enum NF_NET_EVENT
     NF_NET_EVENT_CONNECTED = 0x80,
 };
 
+//exchanged by the hello package(MsgID 0) after connected, old peers never say hello so they keep the plain head
+enum NF_NET_CAPS
+{
+    NF_NET_CAPS_LZ4 = 0x01,
+};
+
+//what happens to a message while its connection is throttled(too much output waiting for a slow client)
+enum NF_NET_THROTTLE
+{
+    NF_NET_THROTTLE_NONE = 0,       //sent as usual
+    NF_NET_THROTTLE_DROP = 1,       //dropped, the next one makes up for it(move, state sync)
+    NF_NET_THROTTLE_COALESCE = 2,   //only the latest one of each key is kept, sent when the connection drained
+};
+
 
 struct NFIMsgHead
 {
     enum NF_Head
     {
         NF_HEAD_LENGTH = 6,
+        //the highest bit of MsgSize is set, one more byte for the flags
+        NF_HEAD_LENGTH_EX = 7,
     };
 
+    enum NF_Head_Flag
+    {
+        NF_HEAD_FLAG_LZ4 = 0x01,
+        //the high 4 bits are the version of the extended head
+        NF_HEAD_VERSION_1 = 0x10,
+    };
+
+    static const uint32_t NF_HEAD_EX_BIT = 0x80000000;
+
     virtual int EnCode(char* strData) = 0;
 
     virtual int DeCode(const char* strData) = 0;
@@ -76,6 +101,12 @@ struct NFIMsgHead
 
     virtual void SetBodyLength(uint32_t nLength) = 0;
 
+    virtual uint8_t GetFlags() const = 0;
+
+    virtual void SetFlags(uint8_t nFlags) = 0;
+
+    virtual uint32_t GetHeadLength() const = 0;
+
     int64_t NF_HTONLL(int64_t nData)
     {
 #if NF_PLATFORM == NF_PLATFORM_WIN
@@ -157,9 +188,10 @@ public:
     {
         munSize = 0;
         munMsgID = 0;
+        munFlags = 0;
     }
 
-    // Message Head[ MsgID(2) | MsgSize(4) ]
+    // Message Head[ MsgID(2) | MsgSize(4) ], or [ MsgID(2) | MsgSize(4) | Flags(1) ] when it has flags
     virtual int EnCode(char* strData)
     {
         uint32_t nOffset = 0;
@@ -168,12 +200,23 @@ public:
         memcpy(strData + nOffset, (void*) (&nMsgID), sizeof(munMsgID));
         nOffset += sizeof(munMsgID);
 
-        uint32_t nPackSize = munSize + NF_HEAD_LENGTH;
+        uint32_t nPackSize = munSize + GetHeadLength();
+        if (munFlags != 0)
+        {
+            nPackSize |= NF_HEAD_EX_BIT;
+        }
+
         uint32_t nSize = NF_HTONL(nPackSize);
         memcpy(strData + nOffset, (void*) (&nSize), sizeof(munSize));
         nOffset += sizeof(munSize);
 
-        if (nOffset != NF_HEAD_LENGTH)
+        if (munFlags != 0)
+        {
+            memcpy(strData + nOffset, (void*) (&munFlags), sizeof(munFlags));
+            nOffset += sizeof(munFlags);
+        }
+
+        if (nOffset != GetHeadLength())
         {
             assert(0);
         }
@@ -181,7 +224,7 @@ public:
         return nOffset;
     }
 
-    // Message Head[ MsgID(2) | MsgSize(4) ]
+    // Message Head[ MsgID(2) | MsgSize(4) ], strData must hold NF_HEAD_LENGTH_EX bytes if the package has flags
     virtual int DeCode(const char* strData)
     {
         uint32_t nOffset = 0;
@@ -193,10 +236,20 @@ public:
 
         uint32_t nPackSize = 0;
         memcpy(&nPackSize, strData + nOffset, sizeof(munSize));
-        munSize = NF_NTOHL(nPackSize) - NF_HEAD_LENGTH;
+        nPackSize = (uint32_t)NF_NTOHL(nPackSize);
         nOffset += sizeof(munSize);
 
-        if (nOffset != NF_HEAD_LENGTH)
+        munFlags = 0;
+        if (nPackSize & NF_HEAD_EX_BIT)
+        {
+            nPackSize &= ~NF_HEAD_EX_BIT;
+            memcpy(&munFlags, strData + nOffset, sizeof(munFlags));
+            nOffset += sizeof(munFlags);
+        }
+
+        munSize = nPackSize - GetHeadLength();
+
+        if (nOffset != GetHeadLength())
         {
             assert(0);
         }
@@ -224,9 +277,25 @@ public:
         munSize = nLength;
     }
 
+    virtual uint8_t GetFlags() const
+    {
+        return munFlags;
+    }
+
+    virtual void SetFlags(uint8_t nFlags)
+    {
+        munFlags = nFlags;
+    }
+
+    virtual uint32_t GetHeadLength() const
+    {
+        return munFlags != 0 ? NF_HEAD_LENGTH_EX : NF_HEAD_LENGTH;
+    }
+
 protected:
     uint32_t munSize;
     uint16_t munMsgID;
+    uint8_t munFlags;
 };
 
 class NFINet;
@@ -235,9 +304,104 @@ typedef std::function<void(const NFSOCK nSockIndex, const int nMsgID, const char
                            const uint32_t nLen)> NET_RECEIVE_FUNCTOR;
 typedef std::shared_ptr<NET_RECEIVE_FUNCTOR> NET_RECEIVE_FUNCTOR_PTR;
 
+//a function and its context, it never owns or allocates anything
+struct NFNetReceiveHandler
+{
+    typedef void (*HANDLER_STUB)(void* pContext, const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen);
+
+    NFNetReceiveHandler()
+    {
+        pContext = NULL;
+        pStub = NULL;
+    }
+
+    void operator()(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen) const
+    {
+        pStub(pContext, nSockIndex, nMsgID, msg, nLen);
+    }
+
+    void* pContext;
+    HANDLER_STUB pStub;
+};
+
+//an object and one of its member functions, called straight from the stub
+template<typename BaseType>
+struct NFNetMemberReceive
+{
+    typedef void (BaseType::*HANDLER)(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen);
+
+    static void Invoke(void* pContext, const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+    {
+        NFNetMemberReceive* pMember = (NFNetMemberReceive*)pContext;
+        (pMember->pBase->*pMember->pHandler)(nSockIndex, nMsgID, msg, nLen);
+    }
+
+    BaseType* pBase;
+    HANDLER pHandler;
+};
+
+//what a module keeps for a registered handler, the owner keeps the context of the handler alive
+struct NFNetReceiveCallBack
+{
+    NFNetReceiveHandler xHandler;
+    std::shared_ptr<void> xOwner;
+
+    template<typename BaseType>
+    static NFNetReceiveCallBack Member(BaseType* pBase, void (BaseType::*handleRecieve)(const NFSOCK, const int, const char*, const uint32_t))
+    {
+        std::shared_ptr<NFNetMemberReceive<BaseType>> xMember(new NFNetMemberReceive<BaseType>());
+        xMember->pBase = pBase;
+        xMember->pHandler = handleRecieve;
+
+        NFNetReceiveCallBack xCallBack;
+        xCallBack.xHandler.pContext = xMember.get();
+        xCallBack.xHandler.pStub = &NFNetMemberReceive<BaseType>::Invoke;
+        xCallBack.xOwner = xMember;
+        return xCallBack;
+    }
+
+    static NFNetReceiveCallBack Functor(const NET_RECEIVE_FUNCTOR_PTR& cb)
+    {
+        NFNetReceiveCallBack xCallBack;
+        xCallBack.xHandler.pContext = cb.get();
+        xCallBack.xHandler.pStub = &InvokeFunctor;
+        xCallBack.xOwner = cb;
+        return xCallBack;
+    }
+
+private:
+    static void InvokeFunctor(void* pContext, const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+    {
+        NET_RECEIVE_FUNCTOR* pFunc = (NET_RECEIVE_FUNCTOR*)pContext;
+        pFunc->operator()(nSockIndex, nMsgID, msg, nLen);
+    }
+};
+
 typedef std::function<void(const NFSOCK nSockIndex, const NF_NET_EVENT nEvent, NFINet* pNet)> NET_EVENT_FUNCTOR;
 typedef std::shared_ptr<NET_EVENT_FUNCTOR> NET_EVENT_FUNCTOR_PTR;
 
+#define NF_NET_RECEIVE_STAT_BUCKET	16
+
+//the handlers of one message id, times are in microseconds and bucket i counts the calls shorter than 2^i us
+struct NFNetReceiveStat
+{
+    NFNetReceiveStat()
+    {
+        nCount = 0;
+        nTotalTime = 0;
+        nMaxTime = 0;
+        memset(xHistogram, 0, sizeof(xHistogram));
+    }
+
+    int64_t nCount;
+    int64_t nTotalTime;
+    int64_t nMaxTime;
+    int64_t xHistogram[NF_NET_RECEIVE_STAT_BUCKET];
+};
+
+//the coalesce key of a message body, false means the message can not be coalesced and is sent as usual
+typedef std::function<bool(const int nMsgID, const char* msg, const uint32_t nLen, std::string& strKey)> NET_COALESCE_FUNCTOR;
+
 typedef std::function<void(int severity, const char* msg)> NET_EVENT_LOG_FUNCTOR;
 typedef std::shared_ptr<NET_EVENT_LOG_FUNCTOR> NET_EVENT_LOG_FUNCTOR_PTR;
 
@@ -254,6 +418,9 @@ public:
         m_pNet = pNet;
 
         bev = pBev;
+        mxSendBuff = NULL;
+        mnNetCaps = 0;
+        mbThrottled = false;
         memset(&sin, 0, sizeof(sin));
         sin = addr;
     }
@@ -261,56 +428,48 @@ public:
     virtual ~NetObject()
     {
     }
-	
-    int AddBuff(const char* str, size_t nLen)
-    {
-        mstrBuff.append(str, nLen);
 
-        return (int) mstrBuff.length();
+    bufferevent* GetBuffEvent()
+    {
+        return bev;
     }
 
-    int CopyBuffTo(char* str, uint32_t nStart, uint32_t nLen)
+    NFINet* GetNet()
     {
-        if (nStart + nLen > mstrBuff.length())
-        {
-            return 0;
-        }
-
-        memcpy(str, mstrBuff.data() + nStart, nLen);
-
-        return nLen;
+        return m_pNet;
     }
 
-    int RemoveBuff(uint32_t nStart, uint32_t nLen)
+    //the data waiting for the end of frame in send batching mode, owned by the net
+    struct evbuffer* GetSendBuff()
     {
-        if (nStart + nLen > mstrBuff.length())
-        {
-            return 0;
-        }
-
-        mstrBuff.erase(nStart, nLen);
+        return mxSendBuff;
+    }
 
-        return (int) mstrBuff.length();
+    void SetSendBuff(struct evbuffer* pBuff)
+    {
+        mxSendBuff = pBuff;
     }
 
-    const char* GetBuff()
+    //what both sides agreed in the hello, NF_NET_CAPS
+    int GetNetCaps() const
     {
-        return mstrBuff.data();
+        return mnNetCaps;
     }
 
-    int GetBuffLen() const
+    void SetNetCaps(const int nCaps)
     {
-        return (int) mstrBuff.length();
+        mnNetCaps = nCaps;
     }
 
-    bufferevent* GetBuffEvent()
+    //the output passed the high water and has not drained to the low water yet
+    bool GetThrottled() const
     {
-        return bev;
+        return mbThrottled;
     }
 
-    NFINet* GetNet()
+    void SetThrottled(const bool bThrottled)
     {
-        return m_pNet;
+        mbThrottled = bThrottled;
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -402,7 +561,9 @@ public:
 private:
     sockaddr_in sin;
     bufferevent* bev;
-    std::string mstrBuff;
+    struct evbuffer* mxSendBuff;
+    int mnNetCaps;
+    bool mbThrottled;
     std::string mstrUserData;
     std::string mstrSecurityKey;
 
@@ -432,12 +593,46 @@ public:
 
     virtual int ExpandBufferSize(const unsigned int size) = 0;
 
+    //as server, spread the sockets over N io threads(must be set before Initialization), the callbacks still run on the thread which calls Execute
+    virtual int SetIOThreadCount(const unsigned int nCount) = 0;
+
+    //hold the messages sent in one frame and commit them to each socket once in Execute, a socket flushes earlier when its pending data reaches nHighWater bytes
+    virtual void SetSendBatching(const bool bBatching, const unsigned int nHighWater = 0) = 0;
+
+    //nFlush: commits to the socket output buffers, nBytes: bytes committed, nMsg: messages batched
+    virtual void GetSendBatchingStat(int64_t& nFlush, int64_t& nBytes, int64_t& nMsg) = 0;
+
+    //compress the messages larger than nThreshold for the connections which agreed it in the hello, 0 turns it off
+    //the dictionary(raw sample traffic) must be the same on both sides, set it before Initialization
+    //bHello: a client only starts the hello with it, the server must be one that answers it
+    virtual void SetCompress(const unsigned int nThreshold, const std::string& strDictionary = "", const bool bHello = false) = 0;
+
+    //a connection with more than nHighWater bytes waiting is throttled until it drained to nLowWater,
+    //past nCloseWater it is closed, 0 high water turns it off
+    virtual void SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater) = 0;
+
+    //how the message is handled on a throttled connection, the msg id is the only coalesce key without the functor
+    virtual void SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor = NET_COALESCE_FUNCTOR()) = 0;
+
+    //the connections throttled now, and the totals since started
+    virtual void GetThrottleStat(int& nThrottled, int64_t& nThrottleTotal, int64_t& nDrop, int64_t& nCoalesce, int64_t& nClose) = 0;
+
     virtual bool Final() = 0;
 
     //send a message with out msg-head[auto add msg-head in this function]
     virtual bool
     SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const NFSOCK nSockIndex = 0) = 0;
 
+    //send a message with out msg-head to many clients, the frame is encoded once and shared by all of them
+    virtual bool
+    SendMsgWithOutHead(const int16_t nMsgID, const char* msg, const size_t nLen, const std::vector<NFSOCK>& fdList) = 0;
+
+    //reserve msg-head + nLen bytes in the send buffer and write the msg-head, fill the body in place then call CommitMsg
+    //NULL means the socket is gone or the message would be compressed, send it with SendMsgWithOutHead instead
+    virtual char* ReserveMsg(const int16_t nMsgID, const size_t nLen, const NFSOCK nSockIndex = 0) = 0;
+
+    virtual bool CommitMsg() = 0;
+
     //send a message to all client[need to add msg-head for this message by youself]
     virtual bool SendMsgToAllClient(const char* msg, const size_t nLen) = 0;
 
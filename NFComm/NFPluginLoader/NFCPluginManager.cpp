@@ -280,7 +280,9 @@ NFIPlugin* NFCPluginManager::FindPlugin(const std::string& strPluginName)
 
 bool NFCPluginManager::Execute()
 {
-    mnNowTime = time(NULL);
+    mnFrameTimeMS = NFGetSteadyTimeMS();
+    mnFrameWallTimeMS = NFGetTimeMS();
+    mnNowTime = mnFrameWallTimeMS / 1000;
 
     bool bRet = true;
 
@@ -430,11 +432,11 @@ NFIModule* NFCPluginManager::FindModule(const std::string& strModuleName)
 		strSubModuleName = strSubModuleName.substr(position + 1, strSubModuleName.length());
 	}
 #else
-	for (int i = 0; i < strSubModuleName.length(); i++)
+	for (int i = 0; i < (int)strSubModuleName.length(); i++)
 	{
 		std::string s = strSubModuleName.substr(0, i + 1);
 		int n = atof(s.c_str());
-		if (strSubModuleName.length() == i + 1 + n)
+		if ((int)strSubModuleName.length() == i + 1 + n)
 		{
 			strSubModuleName = strSubModuleName.substr(i + 1, strSubModuleName.length());
 			break;
@@ -223,11 +223,11 @@ void NFCoroutineManager::YieldCo(const float fSecond)
     if (this->mnRunningCoroutineID != -1)
     {
         NFCoroutine* t = GetRunningCoroutine();
-        t->nYieldTime = fSecond * 1000 + NFGetTimeMS();
+        t->nYieldTime = fSecond * 1000 + NFGetSteadyTimeMS();
 
         while (1)
         {
-            if (NFGetTimeMS() >= t->nYieldTime)
+            if (NFGetSteadyTimeMS() >= t->nYieldTime)
             {
                 break;
             }
@@ -33,6 +33,11 @@ inline int64_t NFGetTimeMS()
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
+inline int64_t NFGetSteadyTimeMS()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 typedef void (* CoroutineFunction)(void* arg);
 #else
 #include "NFComm/NFPluginModule/NFIModule.h"
@@ -11,6 +11,7 @@
 
 #include "NFPlatform.h"
 #include <iostream>
+#include <functional>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -125,4 +126,16 @@ struct NFGUID
     }
 };
 
+namespace std
+{
+    template<>
+    struct hash<NFGUID>
+    {
+        size_t operator()(const NFGUID& id) const
+        {
+            return std::hash<NFINT64>()(id.nHead64) ^ (std::hash<NFINT64>()(id.nData64) << 1);
+        }
+    };
+}
+
 #endif
@@ -26,6 +26,9 @@ public:
 
     virtual NF_SHARE_PTR<NFIRecordManager> GetRecordManager() = 0;
 
+    virtual void SetClassStore(NF_SHARE_PTR<NFIClassStore> xStore) = 0;
+    virtual NF_SHARE_PTR<NFIClassStore> GetClassStore() = 0;
+
     virtual void SetParent(NF_SHARE_PTR<NFIClass> pClass) = 0;
     virtual NF_SHARE_PTR<NFIClass> GetParent() = 0;
     virtual void SetTypeName(const char* strType) = 0;
@@ -66,6 +69,11 @@ public:
 
     virtual NF_SHARE_PTR<NFIRecordManager> GetClassRecordManager(const std::string& strClassName) = 0;
 
+    //the objects of the class created later keep their int, float, object and vector properties in columns
+    //call it before the first object of the class is created
+    virtual NF_SHARE_PTR<NFIClassStore> EnableClassStore(const std::string& strClassName) = 0;
+    //null if not enabled
+    virtual NF_SHARE_PTR<NFIClassStore> GetClassStore(const std::string& strClassName) = 0;
 };
 
 #endif
\ No newline at end of file
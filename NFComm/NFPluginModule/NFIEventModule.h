@@ -56,6 +56,9 @@ protected:
 public:
 	// only be used in module
     virtual bool DoEvent(const NFEventDefine nEventID, const NFDataList& valueList) = 0;
+	//the same as DoEvent, but the handlers run when the event module executes, in one batch per event ID
+	//for the events nobody waits for, the order is only kept between the events of one ID
+    virtual bool PostEvent(const NFEventDefine nEventID, const NFDataList& valueList) = 0;
 
     virtual bool ExistEventCallBack(const NFEventDefine nEventID) = 0;
     
@@ -71,6 +74,8 @@ public:
     ///////////////////////////////////////////////////////////////////////////////////////////////
 	// can be used for object
     virtual bool DoEvent(const NFGUID self, const NFEventDefine nEventID, const NFDataList& valueList) = 0;
+	//dropped if self is gone before the batch runs
+    virtual bool PostEvent(const NFGUID self, const NFEventDefine nEventID, const NFDataList& valueList) = 0;
 
     virtual bool ExistEventCallBack(const NFGUID self,const NFEventDefine nEventID) = 0;
     
@@ -48,6 +48,9 @@ public:
 public:
 	virtual void SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message& xMsg, const NFGUID& self) = 0;
 	virtual void SendMsgPBToGate(const uint16_t nMsgID, const std::string& strMsg, const NFGUID& self) = 0;
+	//encode once, one frame for each gate which has any receiver of the list
+	virtual void SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message& xMsg, const NFDataList& xPlayerList) = 0;
+	virtual void SendMsgPBToGate(const uint16_t nMsgID, const std::string& strMsg, const NFDataList& xPlayerList) = 0;
     virtual bool AddPlayerGateInfo(const NFGUID& nRoleID, const NFGUID& nClientID, const int nGateID) = 0;
     virtual bool RemovePlayerGateInfo(const NFGUID& nRoleID) = 0;
     virtual NF_SHARE_PTR<GateBaseInfo> GetPlayerGateInfo(const NFGUID& nRoleID) = 0;   
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <string>
 #include <functional>
+#include <vector>
 #include "NFIModule.h"
 #include "NFComm/NFCore/NFIObject.h"
 #include "NFComm/NFPluginModule/NFGUID.h"
@@ -68,11 +69,21 @@ public:
     }
 
     template<typename BaseType>
-    bool RegisterCommonPropertyEvent(BaseType* pBase, int (BaseType::*handler)(const NFGUID&, const std::string&, const NFData&, const NFData&))
+    //nMask: NF_PROPERTY_MASK bits, only the properties with one of them raise the event
+    bool RegisterCommonPropertyEvent(BaseType* pBase, int (BaseType::*handler)(const NFGUID&, const std::string&, const NFData&, const NFData&), const int nMask = NF_PROPERTY_MASK_ALL)
     {
         PROPERTY_EVENT_FUNCTOR functor = std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
         PROPERTY_EVENT_FUNCTOR_PTR functorPtr(new PROPERTY_EVENT_FUNCTOR(functor));
-        return RegisterCommonPropertyEvent(functorPtr);
+        return RegisterCommonPropertyEvent(functorPtr, nMask);
+    }
+
+    template<typename BaseType>
+    //once per frame and object, after the objects executed, with the slots of the properties changed since the last time
+    bool RegisterCommonPropertyBatchEvent(BaseType* pBase, int (BaseType::*handler)(const NFGUID&, const std::vector<int>&), const int nMask = NF_PROPERTY_MASK_ALL)
+    {
+        PROPERTY_BATCH_EVENT_FUNCTOR functor = std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2);
+        PROPERTY_BATCH_EVENT_FUNCTOR_PTR functorPtr(new PROPERTY_BATCH_EVENT_FUNCTOR(functor));
+        return RegisterCommonPropertyBatchEvent(functorPtr, nMask);
     }
 
     template<typename BaseType>
@@ -84,11 +95,11 @@ public:
     }
 
 	template<typename BaseType>
-	bool RegisterClassPropertyEvent(const std::string& strClassName, BaseType* pBase, int (BaseType::*handler)(const NFGUID&, const std::string&, const NFData&, const NFData&))
+	bool RegisterClassPropertyEvent(const std::string& strClassName, BaseType* pBase, int (BaseType::*handler)(const NFGUID&, const std::string&, const NFData&, const NFData&), const int nMask = NF_PROPERTY_MASK_ALL)
 	{
 		PROPERTY_EVENT_FUNCTOR functor = std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
 		PROPERTY_EVENT_FUNCTOR_PTR functorPtr(new PROPERTY_EVENT_FUNCTOR(functor));
-		return RegisterClassPropertyEvent(strClassName, functorPtr);
+		return RegisterClassPropertyEvent(strClassName, functorPtr, nMask);
 	}
 
 	template<typename BaseType>
@@ -107,6 +118,12 @@ public:
 	virtual bool ExistObject(const NFGUID& ident, const int nSceneID, const int nGroupID) = 0;
 
     virtual NF_SHARE_PTR<NFIObject> GetObject(const NFGUID& ident) = 0;
+
+    //a 32-bit handle of a living object, 0 if there is no such object
+    //it stops resolving once the object is destroyed, even if its slot is reused by a new object
+    //the NFGUID stays the id on the network and in the db, the handle is for code that keeps objects around
+    virtual NFUINT32 GetObjectHandle(const NFGUID& ident) = 0;
+    virtual NF_SHARE_PTR<NFIObject> GetObject(const NFUINT32 nHandle) = 0;
     virtual NF_SHARE_PTR<NFIObject> CreateObject(const NFGUID& self, const int nSceneID, const int nGroupID, const std::string& strClassName, const std::string& strConfigIndex, const NFDataList& arg) = 0;
 
 	virtual bool DestroySelf(const NFGUID& self) = 0;
@@ -126,9 +143,41 @@ public:
 	virtual int GetPropertyInt32(const NFGUID& self, const std::string& strPropertyName) = 0;
     virtual double GetPropertyFloat(const NFGUID& self, const std::string& strPropertyName) = 0;
     virtual const std::string& GetPropertyString(const NFGUID& self, const std::string& strPropertyName) = 0;
-    virtual const NFGUID& GetPropertyObject(const NFGUID& self, const std::string& strPropertyName) = 0;
-	virtual const NFVector2& GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName) = 0;
-	virtual const NFVector3& GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName) = 0;
+    virtual NFGUID GetPropertyObject(const NFGUID& self, const std::string& strPropertyName) = 0;
+	virtual NFVector2 GetPropertyVector2(const NFGUID& self, const std::string& strPropertyName) = 0;
+	virtual NFVector3 GetPropertyVector3(const NFGUID& self, const std::string& strPropertyName) = 0;
+
+    //nSlot from NFrame::xxx::PropertySlot, faster than looking the name up
+    virtual bool SetPropertyInt(const NFGUID& self, const int nSlot, const NFINT64 nValue) = 0;
+    virtual bool SetPropertyFloat(const NFGUID& self, const int nSlot, const double dValue) = 0;
+    virtual bool SetPropertyString(const NFGUID& self, const int nSlot, const std::string& strValue) = 0;
+    virtual bool SetPropertyObject(const NFGUID& self, const int nSlot, const NFGUID& objectValue) = 0;
+    virtual bool SetPropertyVector2(const NFGUID& self, const int nSlot, const NFVector2& value) = 0;
+    virtual bool SetPropertyVector3(const NFGUID& self, const int nSlot, const NFVector3& value) = 0;
+
+    virtual NFINT64 GetPropertyInt(const NFGUID& self, const int nSlot) = 0;
+    virtual int GetPropertyInt32(const NFGUID& self, const int nSlot) = 0;
+    virtual double GetPropertyFloat(const NFGUID& self, const int nSlot) = 0;
+    virtual const std::string& GetPropertyString(const NFGUID& self, const int nSlot) = 0;
+    virtual NFGUID GetPropertyObject(const NFGUID& self, const int nSlot) = 0;
+    virtual NFVector2 GetPropertyVector2(const NFGUID& self, const int nSlot) = 0;
+    virtual NFVector3 GetPropertyVector3(const NFGUID& self, const int nSlot) = 0;
+
+    //nHandle from GetObjectHandle, no NFGUID lookup at all
+    virtual bool SetPropertyInt(const NFUINT32 nHandle, const int nSlot, const NFINT64 nValue) = 0;
+    virtual bool SetPropertyFloat(const NFUINT32 nHandle, const int nSlot, const double dValue) = 0;
+    virtual bool SetPropertyString(const NFUINT32 nHandle, const int nSlot, const std::string& strValue) = 0;
+    virtual bool SetPropertyObject(const NFUINT32 nHandle, const int nSlot, const NFGUID& objectValue) = 0;
+    virtual bool SetPropertyVector2(const NFUINT32 nHandle, const int nSlot, const NFVector2& value) = 0;
+    virtual bool SetPropertyVector3(const NFUINT32 nHandle, const int nSlot, const NFVector3& value) = 0;
+
+    virtual NFINT64 GetPropertyInt(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual int GetPropertyInt32(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual double GetPropertyFloat(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual const std::string& GetPropertyString(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual NFGUID GetPropertyObject(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual NFVector2 GetPropertyVector2(const NFUINT32 nHandle, const int nSlot) = 0;
+    virtual NFVector3 GetPropertyVector3(const NFUINT32 nHandle, const int nSlot) = 0;
 
     virtual NF_SHARE_PTR<NFIRecord> FindRecord(const NFGUID& self, const std::string& strRecordName) = 0;
     virtual bool ClearRecord(const NFGUID& self, const std::string& strRecordName) = 0;
@@ -184,6 +233,9 @@ public:
 	virtual bool GetGroupObjectList(const int nSceneID, const int nGroupID, const std::string& strClassName, NFDataList& list, const NFGUID& noSelf) = 0;
 	
 	virtual int GetObjectByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFDataList& valueArg, NFDataList& list) = 0;
+	//the handles of the objects whose indexed property has that value, see GetObject(nHandle)
+	//NULL if the property is not indexed or no object has it, the list is only good until a property of that group changes
+	virtual const std::vector<NFUINT32>* GetObjectHandleByProperty(const int nSceneID, const int nGroupID, const std::string& strPropertyName, const NFData& xValue) = 0;
 
     virtual void Random(int nStart, int nEnd, int nCount, NFDataList& valueList) = 0;
 	virtual int Random(int nStart, int nEnd) = 0;
@@ -196,10 +248,11 @@ protected:
 
 protected:
     virtual bool RegisterCommonClassEvent(const CLASS_EVENT_FUNCTOR_PTR& cb) = 0;
-    virtual bool RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb) = 0;
+    virtual bool RegisterCommonPropertyEvent(const PROPERTY_EVENT_FUNCTOR_PTR& cb, const int nMask) = 0;
+    virtual bool RegisterCommonPropertyBatchEvent(const PROPERTY_BATCH_EVENT_FUNCTOR_PTR& cb, const int nMask) = 0;
     virtual bool RegisterCommonRecordEvent(const RECORD_EVENT_FUNCTOR_PTR& cb) = 0;
 
-	virtual bool RegisterClassPropertyEvent(const std::string& strClassName, const PROPERTY_EVENT_FUNCTOR_PTR& cb) = 0;
+	virtual bool RegisterClassPropertyEvent(const std::string& strClassName, const PROPERTY_EVENT_FUNCTOR_PTR& cb, const int nMask) = 0;
 	virtual bool RegisterClassRecordEvent(const std::string& strClassName, const RECORD_EVENT_FUNCTOR_PTR& cb) = 0;
 };
 
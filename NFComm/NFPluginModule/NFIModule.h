@@ -81,6 +81,12 @@ public:
         return pPluginManager;
     }
 
+    //steady milliseconds of the current frame
+    NFINT64 NFFrameTimeMS() const
+    {
+        return pPluginManager->GetFrameTimeMS();
+    }
+
 	virtual void StartCoroutine()
 	{
 		pPluginManager->StartCoroutine();
@@ -41,6 +41,7 @@ struct ConnectData
 	int nPort;
 	std::string strName;
 	ConnectDataState eState;
+	//steady milliseconds, see NFIPluginManager::GetFrameTimeMS
 	NFINT64 mnLastActionTime;
 
 	NF_SHARE_PTR<NFINetModule> mxNetModule;
@@ -57,10 +58,7 @@ public:
 	template<typename BaseType>
 	bool AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID, BaseType* pBase, void (BaseType::*handleRecieve)(const NFSOCK, const int, const char*, const uint32_t))
 	{
-		NET_RECEIVE_FUNCTOR functor = std::bind(handleRecieve, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-		NET_RECEIVE_FUNCTOR_PTR functorPtr(new NET_RECEIVE_FUNCTOR(functor));
-
-		AddReceiveCallBack(eType, nMsgID, functorPtr);
+		AddReceiveCallBack(eType, nMsgID, NFNetReceiveCallBack::Member(pBase, handleRecieve));
 
 		return true;
 	}
@@ -68,10 +66,7 @@ public:
 	template<typename BaseType>
 	int AddReceiveCallBack(const NF_SERVER_TYPES eType, BaseType* pBase, void (BaseType::*handleRecieve)(const NFSOCK, const int, const char*, const uint32_t))
 	{
-		NET_RECEIVE_FUNCTOR functor = std::bind(handleRecieve, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-		NET_RECEIVE_FUNCTOR_PTR functorPtr(new NET_RECEIVE_FUNCTOR(functor));
-
-		AddReceiveCallBack(eType, functorPtr);
+		AddReceiveCallBack(eType, NFNetReceiveCallBack::Member(pBase, handleRecieve));
 
 		return true;
 	}
@@ -89,6 +84,8 @@ public:
 
 	virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, NET_RECEIVE_FUNCTOR_PTR functorPtr) = 0;
 	virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID, NET_RECEIVE_FUNCTOR_PTR functorPtr) = 0;
+	virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, const NFNetReceiveCallBack& xCallBack) = 0;
+	virtual int AddReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID, const NFNetReceiveCallBack& xCallBack) = 0;
 	virtual int AddEventCallBack(const NF_SERVER_TYPES eType, NET_EVENT_FUNCTOR_PTR functorPtr) = 0;
 
 	virtual void RemoveReceiveCallBack(const NF_SERVER_TYPES eType, const uint16_t nMsgID) = 0;
@@ -21,6 +21,8 @@
 #pragma warning(disable: 4244 4267)
 #endif
 #include "NFComm/NFMessageDefine/NFDefine.pb.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #ifdef _MSC_VER
 #pragma warning(default: 4244 4267)
 #endif
@@ -153,19 +155,13 @@ public:
 	template<typename BaseType>
 	bool AddReceiveCallBack(const int nMsgID, BaseType* pBase, void (BaseType::*handleRecieve)(const NFSOCK, const int, const char*, const uint32_t))
 	{
-		NET_RECEIVE_FUNCTOR functor = std::bind(handleRecieve, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-		NET_RECEIVE_FUNCTOR_PTR functorPtr(new NET_RECEIVE_FUNCTOR(functor));
-
-		return AddReceiveCallBack(nMsgID, functorPtr);
+		return AddReceiveCallBack(nMsgID, NFNetReceiveCallBack::Member(pBase, handleRecieve));
 	}
 
 	template<typename BaseType>
 	bool AddReceiveCallBack(BaseType* pBase, void (BaseType::*handleRecieve)(const NFSOCK, const int, const char*, const uint32_t))
 	{
-		NET_RECEIVE_FUNCTOR functor = std::bind(handleRecieve, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-		NET_RECEIVE_FUNCTOR_PTR functorPtr(new NET_RECEIVE_FUNCTOR(functor));
-
-		return AddReceiveCallBack(functorPtr);
+		return AddReceiveCallBack(NFNetReceiveCallBack::Member(pBase, handleRecieve));
 	}
 
 	template<typename BaseType>
@@ -227,6 +223,151 @@ public:
 		return true;
 	}
 
+	//only read the routing fields(player_id, player_client_list, hash_ident) of a MsgBase, msg_data is skipped without any copy
+	static bool ReceivePBRoute(const int nMsgID, const char* msg, const uint32_t nLen, NFGUID& nPlayer, std::vector<NFGUID>& xClientList, NFGUID& xHashIdent, bool& bHasHashIdent)
+	{
+		using google::protobuf::internal::WireFormatLite;
+
+		bHasHashIdent = false;
+
+		google::protobuf::io::CodedInputStream xInput((const google::protobuf::uint8*)msg, nLen);
+		google::protobuf::uint32 nTag = 0;
+		while ((nTag = xInput.ReadTag()) != 0)
+		{
+			if (WireFormatLite::GetTagWireType(nTag) != WireFormatLite::WIRETYPE_LENGTH_DELIMITED)
+			{
+				if (!WireFormatLite::SkipField(&xInput, nTag))
+				{
+					return false;
+				}
+
+				continue;
+			}
+
+			bool bRet = true;
+			switch (WireFormatLite::GetTagFieldNumber(nTag))
+			{
+			case NFMsg::MsgBase::kPlayerIdFieldNumber:
+				bRet = ReceivePBIdent(xInput, nPlayer);
+				break;
+			case NFMsg::MsgBase::kPlayerClientListFieldNumber:
+			{
+				NFGUID xClientID;
+				bRet = ReceivePBIdent(xInput, xClientID);
+				xClientList.push_back(xClientID);
+			}
+				break;
+			case NFMsg::MsgBase::kHashIdentFieldNumber:
+				bRet = ReceivePBIdent(xInput, xHashIdent);
+				bHasHashIdent = true;
+				break;
+			default:
+				bRet = WireFormatLite::SkipField(&xInput, nTag);
+				break;
+			}
+
+			if (!bRet)
+			{
+				char szData[MAX_PATH] = { 0 };
+				NFSPRINTF(szData, MAX_PATH, "Parse Route Failed from Packet to MsgBase, MessageID: %d\n", nMsgID);
+				//LogRecive(szData);
+
+				return false;
+			}
+		}
+
+		return xInput.ConsumedEntireMessage();
+	}
+
+	static bool ReceivePBIdent(google::protobuf::io::CodedInputStream& xInput, NFGUID& xIdent)
+	{
+		using google::protobuf::internal::WireFormatLite;
+
+		google::protobuf::uint32 nLength = 0;
+		if (!xInput.ReadVarint32(&nLength))
+		{
+			return false;
+		}
+
+		google::protobuf::io::CodedInputStream::Limit xLimit = xInput.PushLimit(nLength);
+
+		google::protobuf::uint32 nTag = 0;
+		while ((nTag = xInput.ReadTag()) != 0)
+		{
+			google::protobuf::uint64 nValue = 0;
+			const int nField = WireFormatLite::GetTagFieldNumber(nTag);
+			if (WireFormatLite::GetTagWireType(nTag) == WireFormatLite::WIRETYPE_VARINT
+				&& (nField == NFMsg::Ident::kSvridFieldNumber || nField == NFMsg::Ident::kIndexFieldNumber))
+			{
+				if (!xInput.ReadVarint64(&nValue))
+				{
+					return false;
+				}
+
+				if (nField == NFMsg::Ident::kSvridFieldNumber)
+				{
+					xIdent.nHead64 = (NFINT64)nValue;
+				}
+				else
+				{
+					xIdent.nData64 = (NFINT64)nValue;
+				}
+			}
+			else if (!WireFormatLite::SkipField(&xInput, nTag))
+			{
+				return false;
+			}
+		}
+
+		if (!xInput.ConsumedEntireMessage())
+		{
+			return false;
+		}
+
+		xInput.PopLimit(xLimit);
+
+		return true;
+	}
+
+	//the same MsgBase without the player_client_list, nothing is parsed:
+	//the tags are walked and the bytes between two client list fields are copied in one go
+	static bool StripPBClientList(const int nMsgID, const char* msg, const uint32_t nLen, std::string& strOutData)
+	{
+		using google::protobuf::internal::WireFormatLite;
+
+		strOutData.clear();
+		strOutData.reserve(nLen);
+
+		google::protobuf::io::CodedInputStream xInput((const google::protobuf::uint8*)msg, nLen);
+		int nKeepStart = 0;
+		int nFieldStart = xInput.CurrentPosition();
+		google::protobuf::uint32 nTag = 0;
+		while ((nTag = xInput.ReadTag()) != 0)
+		{
+			if (!WireFormatLite::SkipField(&xInput, nTag))
+			{
+				return false;
+			}
+
+			if (WireFormatLite::GetTagFieldNumber(nTag) == NFMsg::MsgBase::kPlayerClientListFieldNumber)
+			{
+				strOutData.append(msg + nKeepStart, nFieldStart - nKeepStart);
+				nKeepStart = xInput.CurrentPosition();
+			}
+
+			nFieldStart = xInput.CurrentPosition();
+		}
+
+		if (!xInput.ConsumedEntireMessage())
+		{
+			return false;
+		}
+
+		strOutData.append(msg + nKeepStart, nLen - nKeepStart);
+
+		return true;
+	}
+
 	/////////////////
 	//as client
 	virtual void Initialization(const char* strIP, const unsigned short nPort) = 0;
@@ -235,14 +376,41 @@ public:
 	virtual int Initialization(const unsigned int nMaxClient, const unsigned short nPort, const int nCpuCount = 4) = 0;
 	virtual int ExpandBufferSize(const unsigned int size = 1024 * 1024 * 20) = 0;
 
+	//opt-in multi-reactor mode for servers, 0 keeps all sockets on the logic thread
+	virtual int SetIOThreadCount(const unsigned int nCount) = 0;
+
+	//commit the messages of one frame to each socket at once, 0 high water uses the default
+	virtual void SetSendBatching(const bool bBatching, const unsigned int nHighWater = 0) = 0;
+
+	//compress the messages larger than nThreshold for the peers which agreed it, the dictionary file is under the config path
+	//bHello: as a client, only for servers which answer the hello(msg id 0)
+	virtual void SetCompress(const unsigned int nThreshold, const std::string& strDictionaryFile = "", const bool bHello = false) = 0;
+
+	//slow clients: throttled past nHighWater bytes waiting until drained to nLowWater, closed past nCloseWater
+	virtual void SetThrottle(const unsigned int nHighWater, const unsigned int nLowWater, const unsigned int nCloseWater) = 0;
+
+	//drop or coalesce the message on throttled connections
+	virtual void SetThrottleMsg(const int nMsgID, const NF_NET_THROTTLE eThrottle, const NET_COALESCE_FUNCTOR& xKeyFunctor = NET_COALESCE_FUNCTOR()) = 0;
+
 	virtual void RemoveReceiveCallBack(const int nMsgID) = 0;
 
 	virtual bool AddReceiveCallBack(const int nMsgID, const NET_RECEIVE_FUNCTOR_PTR& cb) = 0;
 
 	virtual bool AddReceiveCallBack(const NET_RECEIVE_FUNCTOR_PTR& cb) = 0;
 
+	//the member function templates come here, their handlers are called without std::function
+	virtual bool AddReceiveCallBack(const int nMsgID, const NFNetReceiveCallBack& cb) = 0;
+
+	virtual bool AddReceiveCallBack(const NFNetReceiveCallBack& cb) = 0;
+
 	virtual bool AddEventCallBack(const NET_EVENT_FUNCTOR_PTR& cb) = 0;
 
+	//count and time the handlers of each message id, off by default
+	virtual void SetReceiveStat(const bool bOpen) = 0;
+
+	//every message id received since the stat opened
+	virtual void GetReceiveStat(std::map<int, NFNetReceiveStat>& xStatMap) = 0;
+
 	virtual bool Execute() = 0;
 
 
@@ -48,7 +48,8 @@ class NFIPluginManager
 public:
     NFIPluginManager()
     {
-
+        mnFrameTimeMS = NFGetSteadyTimeMS();
+        mnFrameWallTimeMS = NFGetTimeMS();
     }
 
 	/////////////////////
@@ -150,6 +151,19 @@ public:
     virtual NFINT64 GetInitTime() const = 0;
     virtual NFINT64 GetNowTime() const = 0;
 
+    //both sampled once at the start of every frame, cheap enough for the hot loops
+    //steady milliseconds, for timers, cooldowns and keepalives, never goes backwards
+    NFINT64 GetFrameTimeMS() const
+    {
+        return mnFrameTimeMS;
+    }
+
+    //wall milliseconds of the same frame, for what is saved or sent out
+    NFINT64 GetFrameWallTimeMS() const
+    {
+        return mnFrameWallTimeMS;
+    }
+
 	virtual const std::string& GetConfigPath() const = 0;
 	virtual void SetConfigPath(const std::string & strPath) = 0;
 
@@ -170,6 +184,10 @@ public:
 	virtual void StartCoroutine(CoroutineFunction func) = 0;
 	virtual void YieldCo(const float nSecond) = 0;
 	virtual void YieldCo() = 0;
+
+protected:
+    NFINT64 mnFrameTimeMS;
+    NFINT64 mnFrameWallTimeMS;
 };
 
 #endif
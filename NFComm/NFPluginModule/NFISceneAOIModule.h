@@ -14,6 +14,9 @@
 #include <algorithm>
 #include "NFComm/NFCore/NFList.hpp"
 #include "NFComm/NFCore/NFMap.hpp"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
+#include "NFComm/NFCore/NFViewGrid.hpp"
+#include "NFComm/NFCore/NFPropertyIndex.hpp"
 #include "NFComm/NFCore/NFDataList.hpp"
 #include "NFComm/NFCore/NFIRecord.h"
 #include "NFComm/NFPluginModule/NFGUID.h"
@@ -47,6 +50,12 @@ public:
         mnGroupID = nGroupID;
     }
 
+    NFCSceneGroupInfo(int nSceneID, int nGroupID, int nWidth, int nViewRange)
+    {
+        mnGroupID = nGroupID;
+        mxViewGrid.Init(nViewRange, nWidth);
+    }
+
     virtual ~NFCSceneGroupInfo()
     {
     }
@@ -56,8 +65,12 @@ public:
         return true;
     }
 
-    NFMapEx<NFGUID, int> mxPlayerList;
-    NFMapEx<NFGUID, int> mxOtherList;
+    NFHashMapEx<NFGUID, int> mxPlayerList;
+    NFHashMapEx<NFGUID, int> mxOtherList;
+    //off if the scene has no view range, then everyone in the group sees everyone
+    NFViewGrid mxViewGrid;
+    //kept by the kernel, the object handles by the values of the indexed properties
+    NFPropertyIndex mxPropertyIndex;
     int mnGroupID;
 };
 
@@ -72,6 +85,7 @@ public:
         mnGroupIndex = -1;
         mnSceneID = nSceneID;
         mnWidth = 512;
+        mnViewRange = 0;
     }
 
     NFCSceneInfo(int nSceneID, int nWidth)
@@ -79,6 +93,7 @@ public:
         mnGroupIndex = -1;
         mnSceneID = nSceneID;
         mnWidth = nWidth;
+        mnViewRange = 0;
     }
 
     virtual ~NFCSceneInfo()
@@ -97,6 +112,31 @@ public:
         return mnWidth;
     }
 
+    //the view grids take it as the scene bounds, set it before the view range
+    void SetWidth(const int nWidth)
+    {
+        mnWidth = nWidth;
+    }
+
+    int GetViewRange()
+    {
+        return mnViewRange;
+    }
+
+    //for the groups made later too, set it before anyone is in the scene
+    void SetViewRange(const int nViewRange)
+    {
+        mnViewRange = nViewRange;
+
+        NF_SHARE_PTR<NFCSceneGroupInfo> pGroupInfo = First();
+        while (pGroupInfo)
+        {
+            pGroupInfo->mxViewGrid.Init(nViewRange, mnWidth);
+
+            pGroupInfo = Next();
+        }
+    }
+
     bool AddObjectToGroup(const int nGroupID, const NFGUID& ident, bool bPlayer)
     {
         NF_SHARE_PTR<NFCSceneGroupInfo> pInfo = GetElement(nGroupID);
@@ -222,6 +262,7 @@ public:
     int mnGroupIndex;
     int mnSceneID;
     int mnWidth;
+    int mnViewRange;
 	//seedID, seedInfo
 	NFMapEx<std::string, SceneSeedResource > mtSceneResourceConfig;
 	NFMapEx<int, NFVector3 > mtSceneRelivePos;
@@ -372,6 +413,9 @@ public:
 	virtual bool AddTagPosition(const int nSceneID, const int nIndex, const NFVector3& vPos) = 0;
 	virtual NFVector3 GetTagPosition(const int nSceneID, const int nIndex, const bool bRoll = true) = 0;
 
+	//the players or the others that see self, all of its group if the scene has no view range
+	virtual bool GetViewObjectList(const NFGUID& self, NFDataList& list, const bool bPlayer, const NFGUID& noSelf = NFGUID()) = 0;
+
 	virtual bool CreateSceneNPC(const int nSceneID, const int nGroupID) = 0;
 	virtual bool CreateSceneNPC(const int nSceneID, const int nGroupID, const NFDataList& argList) = 0;
 	virtual bool DestroySceneNPC(const int nSceneID, const int nGroupID) = 0;
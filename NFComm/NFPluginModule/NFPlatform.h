@@ -377,6 +377,13 @@ inline int64_t NFGetTimeMS()
 	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
+//millisecond, steady clock, never jumps with the wall clock but only means something inside this process
+//use it for intervals and deadlines, NFGetTimeMS for what is saved or sent out
+inline int64_t NFGetSteadyTimeMS()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 //second
 inline int64_t NFGetTimeS()
 {
@@ -16,18 +16,19 @@ bool NFCSkillCooldownModule::AfterInit()
 void NFCSkillCooldownModule::AddSkillCD(const NFGUID& self, const std::string& strSkillName )
 {
     //skillCnfID, usetTime
+    //the record goes to the client and the cache, so it keeps the wall clock, but only the one of this frame
     NF_SHARE_PTR<NFIRecord> xRecord = m_pKernelModule->FindRecord(self, NFrame::NPC::Cooldown::ThisName());
     const int nRow = xRecord->FindString(NFrame::NPC::Cooldown::SkillID, strSkillName);
     if (nRow >= 0)
     {
         //reset the time
-        xRecord->SetInt(nRow, NFrame::NPC::Cooldown::SkillID, NFGetTimeMS());
+        xRecord->SetInt(nRow, NFrame::NPC::Cooldown::Time, pPluginManager->GetFrameWallTimeMS());
     }
     else
     {
         NF_SHARE_PTR<NFDataList> xDataList = xRecord->GetInitData();
         xDataList->SetString(NFrame::NPC::Cooldown::SkillID, strSkillName);
-        xDataList->SetInt(NFrame::NPC::Cooldown::Time, NFGetTimeMS());
+        xDataList->SetInt(NFrame::NPC::Cooldown::Time, pPluginManager->GetFrameWallTimeMS());
 
         xRecord->AddRow(nRow, *xDataList);
     }
@@ -37,13 +38,13 @@ void NFCSkillCooldownModule::AddSkillCD(const NFGUID& self, const std::string& s
 	if (nRowCommon >= 0)
 	{
 		//reset the time
-		xRecord->SetInt(nRowCommon, NFrame::NPC::Cooldown::SkillID, NFGetTimeMS());
+		xRecord->SetInt(nRowCommon, NFrame::NPC::Cooldown::Time, pPluginManager->GetFrameWallTimeMS());
 	}
 	else
 	{
 		NF_SHARE_PTR<NFDataList> xDataList = xRecord->GetInitData();
 		xDataList->SetString(NFrame::NPC::Cooldown::SkillID, mstrCommonSkillID);
-		xDataList->SetInt(NFrame::NPC::Cooldown::Time, NFGetTimeMS());
+		xDataList->SetInt(NFrame::NPC::Cooldown::Time, pPluginManager->GetFrameWallTimeMS());
 
 		xRecord->AddRow(nRowCommon, *xDataList);
 	}
@@ -59,7 +60,7 @@ bool NFCSkillCooldownModule::ExistSkillCD( const NFGUID& self, const std::string
 	{
 		float fCDTime = 1.5f;
 		int64_t nLastTime = xRecord->GetInt(nRowCommon, NFrame::NPC::Cooldown::Time);
-		int64_t nNowTime = NFGetTimeMS();
+		int64_t nNowTime = pPluginManager->GetFrameWallTimeMS();
 		if ((nNowTime - nLastTime) < fCDTime * 1000)
 		{
 			return true;
@@ -72,7 +73,7 @@ bool NFCSkillCooldownModule::ExistSkillCD( const NFGUID& self, const std::string
         //compare the time with the cooldown time
         float fCDTime = m_pElementModule->GetPropertyFloat(strSkillName, NFrame::Skill::CoolDownTime());
         int64_t nLastTime = xRecord->GetInt(nRow, NFrame::NPC::Cooldown::Time);
-        if ((NFGetTimeMS() - nLastTime) < fCDTime * 1000)
+        if ((pPluginManager->GetFrameWallTimeMS() - nLastTime) < fCDTime * 1000)
         {
             return true;
         }
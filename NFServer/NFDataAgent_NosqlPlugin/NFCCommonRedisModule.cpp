@@ -98,6 +98,11 @@ NF_SHARE_PTR<NFIRecordManager> NFCCommonRedisModule::NewRecordManager(const std:
             xRecord->SetSave(pConfigRecordInfo->GetSave());
             xRecord->SetCache(pConfigRecordInfo->GetCache());
 
+            for (int i = 0; i < pConfigRecordInfo->GetCols(); ++i)
+            {
+                xRecord->SetIndex(i, pConfigRecordInfo->GetIndex(i));
+            }
+
             pConfigRecordInfo = pStaticClassRecordManager->Next();
         }
 
@@ -282,6 +287,120 @@ bool NFCCommonRedisModule::SaveCacheRecordInfo(const NFGUID& self, NF_SHARE_PTR<
     return true;
 }
 
+bool NFCCommonRedisModule::SaveDirtyPropertyInfo(const NFGUID& self, NF_SHARE_PTR<NFIPropertyManager> pPropertyManager, const int nExpireSecond)
+{
+	if (self.IsNull() || !pPropertyManager)
+	{
+		return false;
+	}
+
+	std::vector<int> vSlotList;
+	if (pPropertyManager->GetDirtySlot(vSlotList) <= 0)
+	{
+		return true;
+	}
+
+	std::vector<std::string> vKeyList;
+	std::vector<std::string> vValueList;
+	for (size_t i = 0; i < vSlotList.size(); ++i)
+	{
+		NF_SHARE_PTR<NFIProperty> pProperty = pPropertyManager->GetPropertyBySlot(vSlotList[i]);
+		if (!pProperty || (!pProperty->GetCache() && !pProperty->GetSave()))
+		{
+			continue;
+		}
+
+		vKeyList.push_back(pProperty->GetKey());
+		vValueList.push_back(pProperty->ToString());
+	}
+
+	if (!vKeyList.empty())
+	{
+		NF_SHARE_PTR<NFINoSqlDriver> pDriver = m_pNoSqlModule->GetDriverBySuit(self.ToString());
+		if (!pDriver)
+		{
+			return false;
+		}
+
+		std::string strKey = GetPropertyCacheKey(self);
+		if (!pDriver->HMSet(strKey, vKeyList, vValueList))
+		{
+			return false;
+		}
+
+		if (nExpireSecond > 0)
+		{
+			pDriver->Expire(strKey, nExpireSecond);
+		}
+	}
+
+	pPropertyManager->ClearDirty();
+
+	return true;
+}
+
+bool NFCCommonRedisModule::SaveDirtyRecordInfo(const NFGUID& self, NF_SHARE_PTR<NFIRecordManager> pRecordManager, const int nExpireSecond)
+{
+	if (self.IsNull() || !pRecordManager)
+	{
+		return false;
+	}
+
+	std::vector<int> vSlotList;
+	if (pRecordManager->GetDirtySlot(vSlotList) <= 0)
+	{
+		return true;
+	}
+
+	//a record is one field of the hash, so a dirty row still rewrites the whole record
+	std::vector<std::string> vKeyList;
+	std::vector<std::string> vValueList;
+	for (size_t i = 0; i < vSlotList.size(); ++i)
+	{
+		NF_SHARE_PTR<NFIRecord> pRecord = pRecordManager->GetRecordBySlot(vSlotList[i]);
+		if (!pRecord || (!pRecord->GetCache() && !pRecord->GetSave()))
+		{
+			continue;
+		}
+
+		NFMsg::ObjectRecordBase xRecordData;
+		ConvertRecordToPB(pRecord, &xRecordData);
+
+		std::string strValue;
+		if (!xRecordData.SerializeToString(&strValue))
+		{
+			continue;
+		}
+
+		vKeyList.push_back(xRecordData.record_name());
+		vValueList.push_back(strValue);
+	}
+
+	if (!vKeyList.empty())
+	{
+		NF_SHARE_PTR<NFINoSqlDriver> pDriver = m_pNoSqlModule->GetDriverBySuit(self.ToString());
+		if (!pDriver)
+		{
+			return false;
+		}
+
+		std::string strKey = GetRecordCacheKey(self);
+		if (!pDriver->HMSet(strKey, vKeyList, vValueList))
+		{
+			return false;
+		}
+
+		if (nExpireSecond > 0)
+		{
+			pDriver->Expire(strKey, nExpireSecond);
+		}
+	}
+
+	pRecordManager->ClearDirty();
+
+	return true;
+}
+
 bool NFCCommonRedisModule::ConvertPBToPropertyManager(std::vector<std::string>& vKeyList, std::vector<std::string>& vValueList, NF_SHARE_PTR<NFIPropertyManager> pPropertyManager)
 {
 	if (vKeyList.size() == vValueList.size())
@@ -20,13 +20,13 @@ bool NFCPlayerRedisModule::Init()
 	m_pKernelModule = pPluginManager->FindModule<NFIKernelModule>();
 	m_pLogModule = pPluginManager->FindModule<NFILogModule>();
 	
-	m_pKernelModule->RegisterCommonPropertyEvent(this, &NFCPlayerRedisModule::OnPropertyCommonEvent);
+	m_pKernelModule->RegisterCommonPropertyBatchEvent(this, &NFCPlayerRedisModule::OnPropertyBatchEvent, NF_PROPERTY_MASK_FORCE);
 	m_pKernelModule->RegisterCommonRecordEvent(this, &NFCPlayerRedisModule::OnRecordCommonEvent);
 
 	return true;
 }
 
-int NFCPlayerRedisModule::OnPropertyCommonEvent(const NFGUID & self, const std::string & strPropertyName, const NFData & oldVar, const NFData & newVar)
+int NFCPlayerRedisModule::OnPropertyBatchEvent(const NFGUID & self, const std::vector<int>& vSlotList)
 {
 	const std::string& strClassName = m_pKernelModule->GetPropertyString(self, NFrame::IObject::ClassName());
 	if (strClassName == NFrame::Player::ThisName())
@@ -37,12 +37,16 @@ int NFCPlayerRedisModule::OnPropertyCommonEvent(const NFGUID & self, const std::
 			NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pObject->GetPropertyManager();
 			if (pPropertyManager)
 			{
-				NF_SHARE_PTR<NFIProperty> pPropertyInfo = pPropertyManager->GetElement(strPropertyName);
-				if (pPropertyInfo)
+				//the force properties changed in the last frame, saved together
+				for (size_t i = 0; i < vSlotList.size(); ++i)
 				{
-					if (pPropertyInfo->GetForce())
+					NF_SHARE_PTR<NFIProperty> pPropertyInfo = pPropertyManager->GetPropertyBySlot(vSlotList[i]);
+					if (pPropertyInfo)
 					{
-						//save data with real-time
+						if (pPropertyInfo->GetForce())
+						{
+							//save data with real-time
+						}
 					}
 				}
 			}
@@ -340,8 +344,15 @@ NFVector3 NFCPlayerRedisModule::GetPropertyVector3(const NFGUID & self, const st
 
 bool NFCPlayerRedisModule::SavePlayerData(const NFGUID & self)
 {
-	m_pCommonRedisModule->SaveCachePropertyInfo(self, m_pKernelModule->GetObject(self)->GetPropertyManager());
-	m_pCommonRedisModule->SaveCacheRecordInfo(self, m_pKernelModule->GetObject(self)->GetRecordManager());
+	NF_SHARE_PTR<NFIObject> pObject = m_pKernelModule->GetObject(self);
+	if (!pObject)
+	{
+		return false;
+	}
+
+	//the rest is the same as what was loaded or saved last time
+	m_pCommonRedisModule->SaveDirtyPropertyInfo(self, pObject->GetPropertyManager());
+	m_pCommonRedisModule->SaveDirtyRecordInfo(self, pObject->GetRecordManager());
 	
 	return true;
 }
@@ -366,8 +377,22 @@ const bool NFCPlayerRedisModule::AttachData(const NFGUID & self)
 		NF_SHARE_PTR<NFIObject> pObject = m_pKernelModule->GetObject(self);
 		if (pObject)
 		{
-			m_pCommonRedisModule->ConvertPBToPropertyManager(xPlayerDataCache->mvPropertyKeyList, xPlayerDataCache->mvPropertyValueList, pObject->GetPropertyManager());
-			m_pCommonRedisModule->ConvertPBToRecordManager(xPlayerDataCache->mvRecordKeyList, xPlayerDataCache->mvRecordValueList, pObject->GetRecordManager());
+			NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pObject->GetPropertyManager();
+			NF_SHARE_PTR<NFIRecordManager> pRecordManager = pObject->GetRecordManager();
+
+			m_pCommonRedisModule->ConvertPBToPropertyManager(xPlayerDataCache->mvPropertyKeyList, xPlayerDataCache->mvPropertyValueList, pPropertyManager);
+			m_pCommonRedisModule->ConvertPBToRecordManager(xPlayerDataCache->mvRecordKeyList, xPlayerDataCache->mvRecordValueList, pRecordManager);
+
+			//what was just loaded is already in redis, the values set before keep their dirty bits
+			for (size_t i = 0; i < xPlayerDataCache->mvPropertyKeyList.size(); ++i)
+			{
+				pPropertyManager->ClearDirty(pPropertyManager->GetPropertySlot(xPlayerDataCache->mvPropertyKeyList[i]));
+			}
+
+			for (size_t i = 0; i < xPlayerDataCache->mvRecordKeyList.size(); ++i)
+			{
+				pRecordManager->ClearDirty(pRecordManager->GetRecordSlot(xPlayerDataCache->mvRecordKeyList[i]));
+			}
 
 			return true;
 		}
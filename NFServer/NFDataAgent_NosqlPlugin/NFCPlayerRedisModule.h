@@ -62,7 +62,7 @@ protected:
 	void OnOnline(const NFGUID& self);
 	void OnOffline(const NFGUID& self);
 
-	int OnPropertyCommonEvent(const NFGUID & self, const std::string & strPropertyName, const NFData & oldVar, const NFData & newVar);
+	int OnPropertyBatchEvent(const NFGUID & self, const std::vector<int>& vSlotList);
 	int OnRecordCommonEvent(const NFGUID & self, const RECORD_EVENT_DATA & xEventData, const NFData & oldVar, const NFData & newVar);
 
 private:
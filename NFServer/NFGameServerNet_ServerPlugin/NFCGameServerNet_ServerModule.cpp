@@ -6,6 +6,7 @@
 //    @Desc             :
 // -------------------------------------------------------------------------
 
+#include <cmath>
 #include "NFCGameServerNet_ServerModule.h"
 #include "NFComm/NFMessageDefine/NFProtocolDefine.hpp"
 #include "NFComm/NFPluginModule/NFIEventModule.h"
@@ -653,12 +654,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataInt->set_property_name(strProperty);
 		pDataInt->set_data(newVar.GetInt());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_INT, xPropertyInt, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_INT, xPropertyInt, argVar);
 	}
 	break;
 
@@ -672,12 +668,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataFloat->set_property_name(strProperty);
 		pDataFloat->set_data(newVar.GetFloat());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_FLOAT, xPropertyFloat, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_FLOAT, xPropertyFloat, argVar);
 	}
 	break;
 
@@ -691,12 +682,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataString->set_property_name(strProperty);
 		pDataString->set_data(newVar.GetString());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_STRING, xPropertyString, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_STRING, xPropertyString, argVar);
 	}
 	break;
 
@@ -710,12 +696,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataObject->set_property_name(strProperty);
 		*pDataObject->mutable_data() = NFINetModule::NFToPB(newVar.GetObject());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_OBJECT, xPropertyObject, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_OBJECT, xPropertyObject, argVar);
 	}
 	break;
 	case TDATA_VECTOR2:
@@ -728,12 +709,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataObject->set_property_name(strProperty);
 		*pDataObject->mutable_data() = NFINetModule::NFToPB(newVar.GetVector2());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_VECTOR2, xPropertyVector2, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_VECTOR2, xPropertyVector2, argVar);
 	}
 	break;
 	case TDATA_VECTOR3:
@@ -746,12 +722,7 @@ int NFCGameServerNet_ServerModule::OnPropertyEvent(const NFGUID & self, const st
 		pDataObject->set_property_name(strProperty);
 		*pDataObject->mutable_data() = NFINetModule::NFToPB(newVar.GetVector3());
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOld = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_VECTOR3, xPropertyVector3, identOld);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_VECTOR3, xPropertyVector3, argVar);
 	}
 	break;
 	default:
@@ -860,12 +831,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 					}
 				}
 
-				for (int i = 0; i < argVar.GetCount(); i++)
-				{
-					NFGUID identOther = argVar.Object(i);
-
-					SendMsgPBToGate(NFMsg::EGMI_ACK_ADD_ROW, xAddRecordRow, identOther);
-				}
+				SendMsgPBToGate(NFMsg::EGMI_ACK_ADD_ROW, xAddRecordRow, argVar);
 			}
 		}
 	}
@@ -880,12 +846,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 		xReoveRecordRow.set_record_name(strRecord);
 		xReoveRecordRow.add_remove_row(xEventData.nRow);
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOther = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_REMOVE_ROW, xReoveRecordRow, identOther);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_REMOVE_ROW, xReoveRecordRow, argVar);
 	}
 	break;
 	case RECORD_EVENT_DATA::Swap:
@@ -899,12 +860,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 		xSwapRecord.set_row_origin(xEventData.nRow);
 		xSwapRecord.set_row_target(xEventData.nCol);
 
-		for (int i = 0; i < argVar.GetCount(); i++)
-		{
-			NFGUID identOther = argVar.Object(i);
-
-			SendMsgPBToGate(NFMsg::EGMI_ACK_SWAP_ROW, xSwapRecord, identOther);
-		}
+		SendMsgPBToGate(NFMsg::EGMI_ACK_SWAP_ROW, xSwapRecord, argVar);
 	}
 	break;
 	case RECORD_EVENT_DATA::Update:
@@ -923,12 +879,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			int64_t nData = newVar.GetInt();
 			recordProperty->set_data(nData);
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_INT, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_INT, xRecordChanged, argVar);
 		}
 		break;
 
@@ -943,12 +894,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			recordProperty->set_col(xEventData.nCol);
 			recordProperty->set_data(newVar.GetFloat());
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_FLOAT, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_PROPERTY_FLOAT, xRecordChanged, argVar);
 		}
 		break;
 		case TDATA_STRING:
@@ -962,12 +908,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			recordProperty->set_col(xEventData.nCol);
 			recordProperty->set_data(newVar.GetString());
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_STRING, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_STRING, xRecordChanged, argVar);
 		}
 		break;
 		case TDATA_OBJECT:
@@ -981,12 +922,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			recordProperty->set_col(xEventData.nCol);
 			*recordProperty->mutable_data() = NFINetModule::NFToPB(newVar.GetObject());
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_OBJECT, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_OBJECT, xRecordChanged, argVar);
 		}
 		break;
 		case TDATA_VECTOR2:
@@ -1000,12 +936,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			recordProperty->set_col(xEventData.nCol);
 			*recordProperty->mutable_data() = NFINetModule::NFToPB(newVar.GetVector2());
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_VECTOR2, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_VECTOR2, xRecordChanged, argVar);
 		}
 		break;
 		case TDATA_VECTOR3:
@@ -1019,12 +950,7 @@ int NFCGameServerNet_ServerModule::OnRecordEvent(const NFGUID & self, const std:
 			recordProperty->set_col(xEventData.nCol);
 			*recordProperty->mutable_data() = NFINetModule::NFToPB(newVar.GetVector3());
 
-			for (int i = 0; i < argVar.GetCount(); i++)
-			{
-				NFGUID identOther = argVar.Object(i);
-
-				SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_VECTOR2, xRecordChanged, identOther);
-			}
+			SendMsgPBToGate(NFMsg::EGMI_ACK_RECORD_VECTOR2, xRecordChanged, argVar);
 		}
 		break;
 		default:
@@ -1309,6 +1235,30 @@ void NFCGameServerNet_ServerModule::OnClientSwapSceneProcess(const NFSOCK nSockI
 	m_pSceneProcessModule->RequestEnterScene(pObject->Self(), xMsg.scene_id(), 0, NFDataList());
 }
 
+//a NaN or an infinity would go into the Position of the mover and out to everyone who sees it
+bool NFCGameServerNet_ServerModule::CheckMovePosition(const NFGUID& self, const NFMsg::ReqAckPlayerMove& xMsg)
+{
+	bool bFinite = std::isfinite(xMsg.speed());
+	for (int i = 0; bFinite && i < xMsg.target_pos_size(); ++i)
+	{
+		const NFMsg::Vector3& vPos = xMsg.target_pos(i);
+		bFinite = std::isfinite(vPos.x()) && std::isfinite(vPos.y()) && std::isfinite(vPos.z());
+	}
+
+	for (int i = 0; bFinite && i < xMsg.source_pos_size(); ++i)
+	{
+		const NFMsg::Vector3& vPos = xMsg.source_pos(i);
+		bFinite = std::isfinite(vPos.x()) && std::isfinite(vPos.y()) && std::isfinite(vPos.z());
+	}
+
+	if (!bFinite)
+	{
+		m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, self, "", "Move with a position that is not finite", __FUNCTION__, __LINE__);
+	}
+
+	return bFinite;
+}
+
 void NFCGameServerNet_ServerModule::OnClientReqMoveProcess(const NFSOCK nSockIndex, const int nMsgID, const char *msg,
                                                            const uint32_t nLen)
 {
@@ -1316,34 +1266,35 @@ void NFCGameServerNet_ServerModule::OnClientReqMoveProcess(const NFSOCK nSockInd
 
 
 	const NFGUID& xMover = NFINetModule::PBToNF(xMsg.mover());
-	if (xMover == nPlayerID)
+	if (xMover != nPlayerID
+		&& m_pKernelModule->GetPropertyObject(xMover, NFrame::NPC::AIOwnerID()) != nPlayerID)
 	{
-		const int nSceneID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::Player::SceneID());
-		const int nGroupID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::Player::GroupID());
-
-		this->SendMsgPBToGate(NFMsg::EGMI_ACK_MOVE, xMsg, nSceneID, nGroupID);
+		return;
 	}
-	else
-	{
-		const NFGUID xAIOwnerID = m_pKernelModule->GetPropertyObject(xMover, NFrame::NPC::AIOwnerID());
-		if (xAIOwnerID == nPlayerID)
-		{
 
-			NFMsg::Vector3 vPos = xMsg.target_pos(0);
+	if (!CheckMovePosition(nPlayerID, xMsg))
+	{
+		return;
+	}
 
-			NFVector3 v;
-			v.SetX(vPos.x());
-			v.SetY(vPos.y());
-			v.SetZ(vPos.z());
+	if (xMsg.target_pos_size() > 0)
+	{
+		NFMsg::Vector3 vPos = xMsg.target_pos(0);
 
-			//m_pKernelModule->SetPropertyVector3(xMover, NFrame::IObject::Position(), v);
-			const int nSceneID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::Player::SceneID());
-			const int nGroupID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::Player::GroupID());
+		NFVector3 v;
+		v.SetX(vPos.x());
+		v.SetY(vPos.y());
+		v.SetZ(vPos.z());
 
-			this->SendMsgPBToGate(NFMsg::EGMI_ACK_MOVE, xMsg, nSceneID, nGroupID);
-		}
+		//moves the mover to its cell in the view grid too
+		m_pKernelModule->SetPropertyVector3(xMover, NFrame::IObject::Position(), v);
 	}
 
+	//after the position, so that the ones it just came in view of get it too
+	NFDataList xViewList;
+	m_pSceneAOIModule->GetViewObjectList(xMover, xViewList, true);
+
+	this->SendMsgPBToGate(NFMsg::EGMI_ACK_MOVE, xMsg, xViewList);
 }
 
 void NFCGameServerNet_ServerModule::OnClientReqMoveImmuneProcess(const NFSOCK nSockIndex, const int nMsgID,
@@ -1353,12 +1304,14 @@ void NFCGameServerNet_ServerModule::OnClientReqMoveImmuneProcess(const NFSOCK nS
 
 	const NFGUID& self = NFINetModule::PBToNF(xMsg.mover());
 	const NFGUID& xOwnerID = m_pKernelModule->GetPropertyObject(self, NFrame::NPC::AIOwnerID());
+	if (!CheckMovePosition(nPlayerID, xMsg))
+	{
+		return;
+	}
+
 	if (self == nPlayerID
 		|| xOwnerID == nPlayerID)
 	{
-		const int nSceneID = m_pKernelModule->GetPropertyInt32(self, NFrame::Player::SceneID());
-		const int nGroupID = m_pKernelModule->GetPropertyInt32(self, NFrame::Player::GroupID());
-
 		if (xMsg.target_pos_size() > 0)
 		{
 			NFMsg::Vector3 vPos = xMsg.target_pos(0);
@@ -1371,8 +1324,11 @@ void NFCGameServerNet_ServerModule::OnClientReqMoveImmuneProcess(const NFSOCK nS
 			m_pKernelModule->SetPropertyVector3(self, NFrame::IObject::Position(), v);
 		}
 
+		//after the position, so that the ones it just came in view of get it too
+		NFDataList xViewList;
+		m_pSceneAOIModule->GetViewObjectList(self, xViewList, true);
 
-		this->SendMsgPBToGate(NFMsg::EGMI_ACK_MOVE_IMMUNE, xMsg, nSceneID, nGroupID);
+		this->SendMsgPBToGate(NFMsg::EGMI_ACK_MOVE_IMMUNE, xMsg, xViewList);
 	}
 }
 
@@ -1394,8 +1350,10 @@ void NFCGameServerNet_ServerModule::OnClientReqStateSyncProcess(const NFSOCK nSo
 		return;
 	}
 
-	const int nSceneID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::IObject::SceneID());
-	const int nGroupID = m_pKernelModule->GetPropertyInt32(xMover, NFrame::IObject::GroupID());
+	if (!CheckMovePosition(nPlayerID, xMsg))
+	{
+		return;
+	}
 
 	if (xMsg.target_pos_size() > 0)
 	{
@@ -1409,7 +1367,10 @@ void NFCGameServerNet_ServerModule::OnClientReqStateSyncProcess(const NFSOCK nSo
 		m_pKernelModule->SetPropertyVector3(xMover, NFrame::IObject::Position(), v);
 	}
 
-	this->SendMsgPBToGate(NFMsg::EGMI_ACK_STATE_SYNC, xMsg, nSceneID, nGroupID);
+	NFDataList xViewList;
+	m_pSceneAOIModule->GetViewObjectList(xMover, xViewList, true);
+
+	this->SendMsgPBToGate(NFMsg::EGMI_ACK_STATE_SYNC, xMsg, xViewList);
 }
 
 void NFCGameServerNet_ServerModule::OnClientPropertyIntProcess(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
@@ -2038,28 +1999,61 @@ void NFCGameServerNet_ServerModule::SendMsgPBToGate(const uint16_t nMsgID, const
 
 void NFCGameServerNet_ServerModule::SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message & xMsg, const int nSceneID, const int nGroupID)
 {
-	//care: batch
 	NFDataList xList;
 	if (m_pKernelModule->GetGroupObjectList(nSceneID, nGroupID, xList, true))
 	{
-		for (int i = 0; i < xList.GetCount(); ++i)
-		{
-			NFGUID xObject = xList.Object(i);
-			this->SendMsgPBToGate(nMsgID, xMsg, xObject);
-		}
+		this->SendMsgPBToGate(nMsgID, xMsg, xList);
 	}
 }
 
 void NFCGameServerNet_ServerModule::SendMsgPBToGate(const uint16_t nMsgID, const std::string & strMsg, const int nSceneID, const int nGroupID)
 {
-	//care: batch
 	NFDataList xList;
 	if (m_pKernelModule->GetGroupObjectList(nSceneID, nGroupID, xList, true))
 	{
-		for (int i = 0; i < xList.GetCount(); ++i)
+		this->SendMsgPBToGate(nMsgID, strMsg, xList);
+	}
+}
+
+void NFCGameServerNet_ServerModule::SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message & xMsg, const NFDataList & xPlayerList)
+{
+	if (xPlayerList.GetCount() <= 0)
+	{
+		return;
+	}
+
+	//serialize the payload once for every receiver
+	std::string strMsg;
+	if (!xMsg.SerializeToString(&strMsg))
+	{
+		m_pLogModule->LogNormal(NFILogModule::NLL_ERROR_NORMAL, NFGUID(), "Serialize message failed, MessageID:", nMsgID, __FUNCTION__, __LINE__);
+		return;
+	}
+
+	this->SendMsgPBToGate(nMsgID, strMsg, xPlayerList);
+}
+
+void NFCGameServerNet_ServerModule::SendMsgPBToGate(const uint16_t nMsgID, const std::string & strMsg, const NFDataList & xPlayerList)
+{
+	//gate_id, client_id list
+	std::map<int, std::vector<NFGUID>> xGateClientList;
+	for (int i = 0; i < xPlayerList.GetCount(); ++i)
+	{
+		NF_SHARE_PTR<GateBaseInfo> pData = mRoleBaseData.GetElement(xPlayerList.Object(i));
+		if (pData)
+		{
+			xGateClientList[pData->nGateID].push_back(pData->xClientID);
+		}
+	}
+
+	//one MsgBase for each gate, the proxy fans it out by player_client_list
+	std::map<int, std::vector<NFGUID>>::iterator it = xGateClientList.begin();
+	for (; it != xGateClientList.end(); ++it)
+	{
+		NF_SHARE_PTR<GateServerInfo> pProxyData = mProxyMap.GetElement(it->first);
+		if (pProxyData)
 		{
-			NFGUID xObject = xList.Object(i);
-			this->SendMsgPBToGate(nMsgID, strMsg, xObject);
+			m_pNetModule->SendMsgPB(nMsgID, strMsg, pProxyData->xServerData.nFD, NFGUID(), &(it->second));
 		}
 	}
 }
@@ -11,6 +11,11 @@
 
 bool NFCNPCRefreshModule::Init()
 {
+	m_pClassModule = pPluginManager->FindModule<NFIClassModule>();
+
+	//there are many npcs, keep their numbers in columns so they can be swept without the properties
+	m_pClassModule->EnableClassStore(NFrame::NPC::ThisName());
+
     return true;
 }
 
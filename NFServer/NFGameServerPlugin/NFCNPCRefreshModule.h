@@ -10,6 +10,7 @@
 #define NFC_NPC_REFRESH_MODULE_H
 
 #include "NFComm/NFPluginModule/NFIKernelModule.h"
+#include "NFComm/NFPluginModule/NFIClassModule.h"
 #include "NFComm/NFPluginModule/NFINPCRefreshModule.h"
 #include "NFComm/NFPluginModule/NFISceneProcessModule.h"
 #include "NFComm/NFPluginModule/NFIElementModule.h"
@@ -58,6 +59,7 @@ private:
 	NFILogModule* m_pLogModule;
 	NFILevelModule* m_pLevelModule;
 	NFIPropertyModule* m_pPropertyModule;
+	NFIClassModule* m_pClassModule;
 };
 
 
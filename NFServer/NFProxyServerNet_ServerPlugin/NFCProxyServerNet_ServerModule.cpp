@@ -25,6 +25,90 @@ bool NFCProxyServerNet_ServerModule::Init()
     return true;
 }
 
+bool NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey(const int nMsgID, const char* msg, const uint32_t nLen, std::string& strKey)
+{
+    using google::protobuf::internal::WireFormatLite;
+
+    //MsgBase.msg_data -> ObjectPropertyXXX{ player_id, property_list }, one property per message only
+    std::string strMsgData;
+    google::protobuf::io::CodedInputStream xInput((const google::protobuf::uint8*)msg, nLen);
+    google::protobuf::uint32 nTag = 0;
+    while ((nTag = xInput.ReadTag()) != 0)
+    {
+        if (WireFormatLite::GetTagFieldNumber(nTag) == NFMsg::MsgBase::kMsgDataFieldNumber)
+        {
+            if (!WireFormatLite::ReadBytes(&xInput, &strMsgData))
+            {
+                return false;
+            }
+        }
+        else if (!WireFormatLite::SkipField(&xInput, nTag))
+        {
+            return false;
+        }
+    }
+
+    std::string strPlayerID;
+    std::string strProperty;
+    int nPropertyCount = 0;
+    google::protobuf::io::CodedInputStream xData((const google::protobuf::uint8*)strMsgData.data(), (int)strMsgData.length());
+    while ((nTag = xData.ReadTag()) != 0)
+    {
+        bool bRet = true;
+        switch (WireFormatLite::GetTagFieldNumber(nTag))
+        {
+        case NFMsg::ObjectPropertyInt::kPlayerIdFieldNumber:
+            bRet = WireFormatLite::ReadBytes(&xData, &strPlayerID);
+            break;
+        case NFMsg::ObjectPropertyInt::kPropertyListFieldNumber:
+            nPropertyCount++;
+            bRet = WireFormatLite::ReadBytes(&xData, &strProperty);
+            break;
+        default:
+            bRet = WireFormatLite::SkipField(&xData, nTag);
+            break;
+        }
+
+        if (!bRet || nPropertyCount > 1)
+        {
+            return false;
+        }
+    }
+
+    //property_name is the first field of every PropertyXXX
+    std::string strName;
+    google::protobuf::io::CodedInputStream xProperty((const google::protobuf::uint8*)strProperty.data(), (int)strProperty.length());
+    while ((nTag = xProperty.ReadTag()) != 0)
+    {
+        if (WireFormatLite::GetTagFieldNumber(nTag) == NFMsg::PropertyInt::kPropertyNameFieldNumber)
+        {
+            if (!WireFormatLite::ReadBytes(&xProperty, &strName))
+            {
+                return false;
+            }
+
+            break;
+        }
+
+        if (!WireFormatLite::SkipField(&xProperty, nTag))
+        {
+            return false;
+        }
+    }
+
+    if (strPlayerID.empty() || strName.empty())
+    {
+        return false;
+    }
+
+    //the length keeps <id, name> pairs apart
+    strKey.assign(1, (char)strPlayerID.length());
+    strKey.append(strPlayerID);
+    strKey.append(strName);
+
+    return true;
+}
+
 bool NFCProxyServerNet_ServerModule::AfterInit()
 {
 	m_pNetModule->AddReceiveCallBack(NFMsg::EGMI_REQ_CONNECT_KEY, this, &NFCProxyServerNet_ServerModule::OnConnectKeyProcess);
@@ -38,6 +122,20 @@ bool NFCProxyServerNet_ServerModule::AfterInit()
 
 	m_pNetModule->AddEventCallBack(this, &NFCProxyServerNet_ServerModule::OnSocketClientEvent);
 	m_pNetModule->ExpandBufferSize(1024*1024*2);
+	//scene snapshots to the clients, only for the clients which say hello
+	m_pNetModule->SetCompress(1024);
+
+	//a stalled client must not grow the gate without bound, it misses the moves and only gets the latest properties
+	m_pNetModule->SetThrottle(256 * 1024, 64 * 1024, 8 * 1024 * 1024);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_MOVE, NF_NET_THROTTLE_DROP);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_MOVE_IMMUNE, NF_NET_THROTTLE_DROP);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_STATE_SYNC, NF_NET_THROTTLE_DROP);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_INT, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_FLOAT, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_STRING, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_OBJECT, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_VECTOR2, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
+	m_pNetModule->SetThrottleMsg(NFMsg::EGMI_ACK_PROPERTY_VECTOR3, NF_NET_THROTTLE_COALESCE, &NFCProxyServerNet_ServerModule::GetPropertyCoalesceKey);
 
     NF_SHARE_PTR<NFIClass> xLogicClass = m_pClassModule->GetElement(NFrame::Server::ThisName());
     if (xLogicClass)
@@ -336,8 +434,12 @@ void NFCProxyServerNet_ServerModule::OnReqServerListProcess(const NFSOCK nSockIn
 
 int NFCProxyServerNet_ServerModule::Transpond(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
 {
-    NFMsg::MsgBase xMsg;
-    if (!xMsg.ParseFromArray(msg, nLen))
+    //the proxy only forwards, so just scan the routing fields instead of parsing the whole MsgBase
+    NFGUID xPlayerID;
+    NFGUID xHashIdent;
+    bool bHasHashIdent = false;
+    mxRouteClientList.clear();
+    if (!NFINetModule::ReceivePBRoute(nMsgID, msg, nLen, xPlayerID, mxRouteClientList, xHashIdent, bHasHashIdent))
     {
         char szData[MAX_PATH] = { 0 };
         sprintf(szData, "Parse Message Failed from Packet to MsgBase, MessageID: %d\n", nMsgID);
@@ -346,37 +448,49 @@ int NFCProxyServerNet_ServerModule::Transpond(const NFSOCK nSockIndex, const int
     }
 
     //broadcast many palyers
-    for (int i = 0; i < xMsg.player_client_list_size(); ++i)
+    mxRouteFDList.clear();
+    for (size_t i = 0; i < mxRouteClientList.size(); ++i)
     {
-        NF_SHARE_PTR<NFSOCK> pFD = mxClientIdent.GetElement(NFINetModule::PBToNF(xMsg.player_client_list(i)));
+        NF_SHARE_PTR<NFSOCK> pFD = mxClientIdent.GetElement(mxRouteClientList[i]);
         if (pFD)
         {
-            if (xMsg.has_hash_ident())
+            if (bHasHashIdent)
             {
                 NetObject* pNetObject = m_pNetModule->GetNet()->GetNetObject(*pFD);
                 if (pNetObject)
                 {
-                    pNetObject->SetHashIdentID(NFINetModule::PBToNF(xMsg.hash_ident()));
+                    pNetObject->SetHashIdentID(xHashIdent);
                 }
             }
 
-			m_pNetModule->GetNet()->SendMsgWithOutHead(nMsgID, msg, nLen, *pFD);
+            mxRouteFDList.push_back(*pFD);
         }
     }
 
+    if (mxRouteFDList.size() > 0)
+    {
+        //the clients must not see the list(nor the ids of each other), strip it once and share that frame
+        if (!NFINetModule::StripPBClientList(nMsgID, msg, nLen, mstrRouteMsg))
+        {
+            return false;
+        }
+
+        m_pNetModule->GetNet()->SendMsgWithOutHead(nMsgID, mstrRouteMsg.data(), mstrRouteMsg.length(), mxRouteFDList);
+    }
+
     //send message to one player
-    if (xMsg.player_client_list_size() <= 0)
+    if (mxRouteClientList.size() <= 0)
     {
-		NFGUID xClientIdent = NFINetModule::PBToNF(xMsg.player_id());
+		NFGUID xClientIdent = xPlayerID;
         NF_SHARE_PTR<NFSOCK> pFD = mxClientIdent.GetElement(xClientIdent);
         if (pFD)
         {
-            if (xMsg.has_hash_ident())
+            if (bHasHashIdent)
             {
                 NetObject* pNetObject = m_pNetModule->GetNet()->GetNetObject(*pFD);
                 if (pNetObject)
                 {
-                    pNetObject->SetHashIdentID(NFINetModule::PBToNF(xMsg.hash_ident()));
+                    pNetObject->SetHashIdentID(xHashIdent);
                 }
             }
 
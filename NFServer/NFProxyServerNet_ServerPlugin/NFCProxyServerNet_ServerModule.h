@@ -59,9 +59,16 @@ protected:
     //////////////////////////////////////////////////////////////////////////
 
 	void OnOtherMessage(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen);
+
+    static bool GetPropertyCoalesceKey(const int nMsgID, const char* msg, const uint32_t nLen, std::string& strKey);
 protected:
 
     NFMapEx<NFGUID, NFSOCK> mxClientIdent;
+
+    //reused by Transpond to avoid allocations for every forwarded message
+    std::vector<NFGUID> mxRouteClientList;
+    std::vector<NFSOCK> mxRouteFDList;
+    std::string mstrRouteMsg;
 protected:
     NFINetClientModule* m_pNetClientModule;
     NFIKernelModule* m_pKernelModule;
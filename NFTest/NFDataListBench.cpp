@@ -0,0 +1,92 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFDataListBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFDataListBench
+//
+// -------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <functional>
+#include "NFComm/NFCore/NFDataList.hpp"
+
+//every heap allocation of the bench is counted
+static size_t nAllocCount = 0;
+
+void* operator new(size_t nSize)
+{
+    ++nAllocCount;
+    void* p = malloc(nSize ? nSize : 1);
+    if (NULL == p)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+typedef std::function<int(const NFGUID&, const std::string&, const int, const NFDataList&)> BENCH_EVENT_FUNCTOR;
+
+//the common callbacks build their own lists, like the AOI enter list and a record find result
+static int OnViewEvent(const NFGUID& self, const std::string& strClassName, const int nEventID, const NFDataList& var)
+{
+    NFDataList xList;
+    for (int i = 0; i < 6; ++i)
+    {
+        xList << NFGUID(1, i);
+    }
+
+    return xList.GetCount() + var.GetCount();
+}
+
+static int OnFindEvent(const NFGUID& self, const std::string& strClassName, const int nEventID, const NFDataList& var)
+{
+    NFDataList xRows;
+    xRows << 1 << 3;
+
+    NFDataList xCopy = var;
+    return xRows.GetCount() + xCopy.GetCount();
+}
+
+//the shape of NFCKernelModule::DoEvent, the caller builds the arg list and the class callbacks walk it
+int main()
+{
+    std::vector<BENCH_EVENT_FUNCTOR> xCallBackList;
+    xCallBackList.push_back(OnViewEvent);
+    xCallBackList.push_back(OnFindEvent);
+
+    const std::string strClassName("Player");
+    const int nCount = 1000000;
+
+    const size_t nAllocStart = nAllocCount;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+
+    int nSum = 0;
+    for (int n = 0; n < nCount; ++n)
+    {
+        NFDataList var;
+        var << NFGUID(0, n) << 1 << "Player" << NFVector3(1, 2, 3) << 5.0;
+        for (size_t i = 0; i < xCallBackList.size(); ++i)
+        {
+            nSum += xCallBackList[i](NFGUID(0, n), strClassName, 1, var);
+        }
+    }
+
+    const double fNS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count();
+    printf("allocs per event %.2f  %.1f ns per event (%d)\n", (double)(nAllocCount - nAllocStart) / nCount, fNS / nCount, nSum);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFHashMapExBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFHashMapExBench
+//
+// -------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "NFComm/NFCore/NFMapEx.hpp"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
+
+struct NFBenchObject
+{
+    int64_t nValue;
+};
+
+//lookups of random live objects, by key in NFMapEx and NFHashMapEx and by handle, the object count is the first argument
+int main(int argc, char** argv)
+{
+    const int nCount = argc > 1 ? atoi(argv[1]) : 5000;
+    const int nLookup = 2000000;
+
+    NFMapEx<NFGUID, NFBenchObject> xMap;
+    NFHashMapEx<NFGUID, NFBenchObject> xHashMap;
+    std::vector<NFGUID> xIDList;
+    std::vector<NFUINT32> xHandleList;
+    for (int i = 0; i < nCount; ++i)
+    {
+        //the shape of the ids CreateGUID gives out
+        NFGUID ident(3, 1500000000000LL + i * 13);
+        NF_SHARE_PTR<NFBenchObject> xObject(NF_NEW NFBenchObject());
+        xObject->nValue = i;
+
+        xMap.AddElement(ident, xObject);
+        xHashMap.AddElement(ident, xObject);
+        xIDList.push_back(ident);
+    }
+
+    for (int i = 0; i < nCount; ++i)
+    {
+        xHandleList.push_back(xHashMap.GetHandle(xIDList[i]));
+    }
+
+    std::mt19937 xRandom(2);
+    std::vector<int> xQuery(nLookup);
+    for (int i = 0; i < nLookup; ++i)
+    {
+        xQuery[i] = xRandom() % nCount;
+    }
+
+    int64_t nSum = 0;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookup; ++i)
+    {
+        NF_SHARE_PTR<NFBenchObject> xObject = xMap.GetElement(xIDList[xQuery[i]]);
+        nSum += xObject->nValue;
+    }
+
+    const double fMapNS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count() / nLookup;
+
+    xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookup; ++i)
+    {
+        NF_SHARE_PTR<NFBenchObject> xObject = xHashMap.GetElement(xIDList[xQuery[i]]);
+        nSum += xObject->nValue;
+    }
+
+    const double fHashNS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count() / nLookup;
+
+    xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookup; ++i)
+    {
+        nSum += xHashMap.GetElementNudeByHandle(xHandleList[xQuery[i]])->nValue;
+    }
+
+    const double fHandleNS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count() / nLookup;
+
+    //a full walk, the way the kernel visits every object of a frame
+    xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+    {
+        for (NFHashMapEx<NFGUID, NFBenchObject>::iterator it = xHashMap.begin(); it != xHashMap.end(); ++it)
+        {
+            nSum += it->second->nValue;
+        }
+    }
+
+    const double fWalkNS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - xStart).count() / (100.0 * nCount);
+
+    printf("objects %d  NFMapEx %.1f  NFHashMapEx %.1f  handle %.1f ns per lookup  walk %.1f ns per object (%lld)\n",
+           nCount, fMapNS, fHashNS, fHandleNS, fWalkNS, (long long)(nSum % 7));
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFHashMapExTest.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFHashMapExTest
+//
+// -------------------------------------------------------------------------
+
+#include <map>
+#include <set>
+#include <random>
+#include <cstdio>
+#include "NFComm/NFCore/NFHashMapEx.hpp"
+
+static int nFailed = 0;
+
+#define NF_CHECK(x) do { if (!(x)) { ++nFailed; printf("%s:%d: %s\n", __FILE__, __LINE__, #x); } } while (0)
+
+typedef NFHashMapEx<NFGUID, int> NFGUIDMap;
+
+static NF_SHARE_PTR<int> NewValue(const int nValue)
+{
+    return NF_SHARE_PTR<int>(NF_NEW int(nValue));
+}
+
+//two appended elements and the first one removed again, Skip jumps over the end taken before
+static void TestAddRemoveBeyondEnd()
+{
+    NFGUIDMap xMap;
+    for (int i = 0; i < 4; ++i)
+    {
+        xMap.AddElement(NFGUID(1, i), NewValue(i));
+    }
+
+    int nStep = 0;
+    for (NFGUIDMap::Entry& xEntry : xMap)
+    {
+        NF_CHECK(xEntry.second != nullptr);
+        if (nStep == 0)
+        {
+            xMap.AddElement(NFGUID(2, 0), NewValue(100));
+            xMap.AddElement(NFGUID(2, 1), NewValue(101));
+            xMap.RemoveElement(NFGUID(2, 0));
+        }
+
+        ++nStep;
+    }
+
+    NF_CHECK(nStep == 4);
+    NF_CHECK(xMap.Count() == 5);
+}
+
+//every element alive from the start to its turn is visited once, nothing is visited twice
+static void TestChangeWhileIterating()
+{
+    std::mt19937 xRandom(7);
+    for (int nRound = 0; nRound < 200; ++nRound)
+    {
+        NFGUIDMap xMap;
+        std::set<NFGUID> xLive;
+        const int nCount = 1 + nRound % 50;
+        for (int i = 0; i < nCount; ++i)
+        {
+            xMap.AddElement(NFGUID(1, i), NewValue(i));
+            xLive.insert(NFGUID(1, i));
+        }
+
+        //remove and re-add a few so the free indexes are in use
+        for (int i = 0; i < nCount; i += 3)
+        {
+            xMap.RemoveElement(NFGUID(1, i));
+            xLive.erase(NFGUID(1, i));
+        }
+
+        const std::set<NFGUID> xStart = xLive;
+        std::set<NFGUID> xRemoved;
+        std::set<NFGUID> xVisited;
+        int nNext = 0;
+        for (NFGUIDMap::Entry& xEntry : xMap)
+        {
+            const NFGUID xKey = xEntry.first;
+            NF_CHECK(xEntry.second != nullptr);
+            NF_CHECK(xVisited.insert(xKey).second);
+
+            const int nAction = xRandom() % 4;
+            if (nAction == 0)
+            {
+                NFGUID xNew(2, nNext++);
+                NF_CHECK(xMap.AddElement(xNew, NewValue(nNext)));
+                xLive.insert(xNew);
+            }
+            else if (nAction == 1 && !xLive.empty())
+            {
+                std::set<NFGUID>::iterator it = xLive.begin();
+                std::advance(it, xRandom() % xLive.size());
+                const NFGUID xOld = *it;
+                NF_CHECK(xMap.RemoveElement(xOld));
+                xLive.erase(xOld);
+                xRemoved.insert(xOld);
+            }
+            else if (nAction == 2)
+            {
+                //the current one
+                NF_CHECK(xMap.RemoveElement(xKey));
+                xLive.erase(xKey);
+                xRemoved.insert(xKey);
+            }
+        }
+
+        for (std::set<NFGUID>::const_iterator it = xStart.begin(); it != xStart.end(); ++it)
+        {
+            NF_CHECK(xVisited.count(*it) == 1 || xRemoved.count(*it) == 1);
+        }
+
+        NF_CHECK(xMap.Count() == (int)xLive.size());
+
+        std::set<NFGUID> xLeft;
+        for (NFGUIDMap::Entry& xEntry : xMap)
+        {
+            xLeft.insert(xEntry.first);
+        }
+
+        NF_CHECK(xLeft == xLive);
+    }
+}
+
+//random operations checked against std::map
+static void TestAgainstMap()
+{
+    std::mt19937_64 xRandom(1);
+    for (int nRound = 0; nRound < 8; ++nRound)
+    {
+        NFGUIDMap xMap;
+        std::map<NFGUID, int> xCheck;
+        const int nKey = 50 << nRound;
+        for (int nOp = 0; nOp < 50000; ++nOp)
+        {
+            const NFGUID xKey(xRandom() % 3, xRandom() % nKey);
+            const int nAction = xRandom() % 10;
+            if (nAction < 4)
+            {
+                NF_CHECK(xMap.AddElement(xKey, NewValue(nOp)) == xCheck.insert(std::make_pair(xKey, nOp)).second);
+            }
+            else if (nAction < 7)
+            {
+                NF_CHECK(xMap.RemoveElement(xKey) == (xCheck.erase(xKey) == 1));
+            }
+            else
+            {
+                NF_SHARE_PTR<int> xValue = xMap.GetElement(xKey);
+                std::map<NFGUID, int>::iterator it = xCheck.find(xKey);
+                NF_CHECK((xValue != nullptr) == (it != xCheck.end()));
+                if (xValue && it != xCheck.end())
+                {
+                    NF_CHECK(*xValue == it->second);
+                    NF_CHECK(xMap.GetElementByHandle(xMap.GetHandle(xKey)) == xValue);
+                }
+            }
+        }
+
+        NF_CHECK(xMap.Count() == (int)xCheck.size());
+
+        std::set<NFGUID> xRange;
+        for (NFGUIDMap::Entry& xEntry : xMap)
+        {
+            xRange.insert(xEntry.first);
+        }
+
+        std::set<NFGUID> xCursor;
+        NFGUID xKey;
+        for (NF_SHARE_PTR<int> xValue = xMap.First(xKey); xValue; xValue = xMap.Next(xKey))
+        {
+            xCursor.insert(xKey);
+        }
+
+        std::set<NFGUID> xExpect;
+        for (std::map<NFGUID, int>::iterator it = xCheck.begin(); it != xCheck.end(); ++it)
+        {
+            xExpect.insert(it->first);
+        }
+
+        NF_CHECK(xRange == xExpect);
+        NF_CHECK(xCursor == xExpect);
+    }
+}
+
+int main()
+{
+    TestAddRemoveBeyondEnd();
+    TestChangeWhileIterating();
+    TestAgainstMap();
+
+    printf("NFHashMapExTest %s\n", nFailed == 0 ? "passed" : "failed");
+    return nFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFNetBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFNetBench
+//
+// -------------------------------------------------------------------------
+
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "NFComm/NFNetPlugin/NFCNet.h"
+
+//how fast the server frames the messages of one client, for each body size
+class NFNetBenchSink
+{
+public:
+    NFNetBenchSink()
+    {
+        mnRecv = 0;
+        mnBytes = 0;
+        mnCheck = 0;
+    }
+
+    void OnReceive(const NFSOCK nSockIndex, const int nMsgID, const char* msg, const uint32_t nLen)
+    {
+        ++mnRecv;
+        mnBytes += nLen;
+        mnCheck += (unsigned char)msg[nLen - 1];
+    }
+
+    void OnEvent(const NFSOCK nSockIndex, const NF_NET_EVENT eEvent, NFINet* pNet)
+    {
+    }
+
+    int64_t mnRecv;
+    int64_t mnBytes;
+    int64_t mnCheck;
+};
+
+static bool RunSize(const unsigned short nPort, const int nBodySize)
+{
+    NFNetBenchSink xSink;
+    NFCNet xServer(&xSink, &NFNetBenchSink::OnReceive, &NFNetBenchSink::OnEvent);
+    xServer.SetIOThreadCount(1);
+    if (xServer.Initialization(10, nPort, 1) < 0)
+    {
+        printf("listen on %d failed\n", nPort);
+        return false;
+    }
+
+    int64_t nTotal = (64 << 20) / (nBodySize + NFIMsgHead::NF_Head::NF_HEAD_LENGTH);
+    if (nTotal > 400000)
+    {
+        nTotal = 400000;
+    }
+
+    std::string strFrame(NFIMsgHead::NF_Head::NF_HEAD_LENGTH + nBodySize, 'x');
+    NFCMsgHead xHead;
+    xHead.SetMsgID(100);
+    xHead.SetBodyLength(nBodySize);
+    xHead.EnCode(&strFrame[0]);
+
+    int nFD = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in xAddr;
+    memset(&xAddr, 0, sizeof(xAddr));
+    xAddr.sin_family = AF_INET;
+    xAddr.sin_port = htons(nPort);
+    xAddr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (connect(nFD, (sockaddr*)&xAddr, sizeof(xAddr)) < 0)
+    {
+        printf("connect to %d failed\n", nPort);
+        close(nFD);
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+    std::thread xWriter([&]()
+    {
+        std::string strBatch;
+        const int64_t nPerBatch = std::max<int64_t>(1, (256 * 1024) / strFrame.length());
+        for (int64_t i = 0; i < nPerBatch; ++i)
+        {
+            strBatch += strFrame;
+        }
+
+        for (int64_t nSent = 0; nSent < nTotal; nSent += nPerBatch)
+        {
+            const size_t nLen = strFrame.length() * std::min(nPerBatch, nTotal - nSent);
+            size_t nDone = 0;
+            while (nDone < nLen)
+            {
+                ssize_t n = send(nFD, strBatch.data() + nDone, nLen - nDone, 0);
+                if (n <= 0)
+                {
+                    return;
+                }
+                nDone += n;
+            }
+        }
+    });
+
+    while (xSink.mnRecv < nTotal)
+    {
+        xServer.Execute();
+        if (std::chrono::steady_clock::now() - xStart > std::chrono::seconds(60))
+        {
+            break;
+        }
+    }
+
+    const double fSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+    xWriter.join();
+    close(nFD);
+    xServer.Final();
+
+    const bool bOK = xSink.mnRecv == nTotal && xSink.mnCheck == nTotal * 'x';
+    printf("%6d B  msgs=%lld  %.2f Mmsg/s  %.1f MB/s %s\n", nBodySize, (long long)xSink.mnRecv,
+           xSink.mnRecv / fSec / 1e6, xSink.mnBytes / fSec / 1e6, bOK ? "ok" : "lost");
+    return bOK;
+}
+
+int main()
+{
+    const int nBodySize[] = { 16, 128, 1024, 8192, 65536 };
+
+    bool bOK = true;
+    for (int i = 0; i < (int)(sizeof(nBodySize) / sizeof(nBodySize[0])); ++i)
+    {
+        bOK = RunSize((unsigned short)(17801 + i), nBodySize[i]) && bOK;
+    }
+
+    return bOK ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFPropertyManagerTest.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFPropertyManagerTest
+//
+// -------------------------------------------------------------------------
+
+#include <cstdio>
+#include "NFComm/NFCore/NFCPropertyManager.h"
+
+static int nFailed = 0;
+
+#define NF_CHECK(x) do { if (!(x)) { ++nFailed; printf("%s:%d: %s\n", __FILE__, __LINE__, #x); } } while (0)
+
+static NF_SHARE_PTR<NFIPropertyManager> NewClassManager()
+{
+    NF_SHARE_PTR<NFIPropertyManager> xClass(NF_NEW NFCPropertyManager(NFGUID()));
+
+    NF_SHARE_PTR<NFIProperty> xHP = xClass->AddProperty(NFGUID(), "HP", TDATA_INT);
+    xHP->SetPublic(true);
+    xHP->SetSave(true);
+    xClass->SetPropertySlot(0, xHP);
+
+    NF_SHARE_PTR<NFIProperty> xName = xClass->AddProperty(NFGUID(), "AVeryLongPropertyNameForTheHeap", TDATA_STRING);
+    xName->SetCache(true);
+    xClass->SetPropertySlot(1, xName);
+
+    return xClass;
+}
+
+//the objects share the name and flags of the class property, a change is only seen by the one property
+static void TestSharedMeta()
+{
+    NF_SHARE_PTR<NFIPropertyManager> xClass = NewClassManager();
+
+    NFCPropertyManager xObjectA(NFGUID(1, 1));
+    NFCPropertyManager xObjectB(NFGUID(1, 2));
+    NF_CHECK(xObjectA.CloneFrom(xClass));
+    NF_CHECK(xObjectB.CloneFrom(xClass));
+
+    NF_SHARE_PTR<NFIProperty> xClassName = xClass->GetElement("AVeryLongPropertyNameForTheHeap");
+    NF_SHARE_PTR<NFIProperty> xNameA = xObjectA.GetElement("AVeryLongPropertyNameForTheHeap");
+    NF_SHARE_PTR<NFIProperty> xNameB = xObjectB.GetElement("AVeryLongPropertyNameForTheHeap");
+    NF_CHECK(xNameA && xNameB);
+    NF_CHECK(&xNameA->GetKey() == &xClassName->GetKey());
+    NF_CHECK(&xNameB->GetKey() == &xClassName->GetKey());
+    NF_CHECK(xNameA->GetCache() && !xNameA->GetSave());
+
+    NF_SHARE_PTR<NFIProperty> xHPA = xObjectA.GetElement("HP");
+    NF_SHARE_PTR<NFIProperty> xHPB = xObjectB.GetElement("HP");
+    NF_CHECK(xHPA->GetMask() == (NF_PROPERTY_MASK_PUBLIC | NF_PROPERTY_MASK_SAVE));
+
+    xHPA->SetPublic(false);
+    xHPA->SetIndex(true);
+    NF_CHECK(xHPA->GetMask() == (NF_PROPERTY_MASK_SAVE | NF_PROPERTY_MASK_INDEX));
+    NF_CHECK(xHPA->GetKey() == "HP");
+    NF_CHECK(xHPB->GetMask() == (NF_PROPERTY_MASK_PUBLIC | NF_PROPERTY_MASK_SAVE));
+    NF_CHECK(xClass->GetElement("HP")->GetMask() == (NF_PROPERTY_MASK_PUBLIC | NF_PROPERTY_MASK_SAVE));
+
+    //the class changes after the clone, the objects keep what they had
+    xClass->GetElement("HP")->SetPrivate(true);
+    NF_CHECK(!xHPB->GetPrivate());
+    NF_CHECK(xClass->GetElement("HP")->GetPrivate());
+
+    //the object properties outlive the class
+    xClass.reset();
+    xClassName.reset();
+    NF_CHECK(xNameA->GetKey() == "AVeryLongPropertyNameForTheHeap");
+    NF_CHECK(xNameB->GetCache());
+    NF_CHECK(xNameA->SetString("Value") && xNameA->GetString() == "Value");
+}
+
+int main()
+{
+    TestSharedMeta();
+
+    printf("NFPropertyManagerTest %s\n", nFailed == 0 ? "passed" : "failed");
+    return nFailed == 0 ? 0 : 1;
+}
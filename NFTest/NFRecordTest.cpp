@@ -0,0 +1,69 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFRecordTest.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFRecordTest
+//
+// -------------------------------------------------------------------------
+
+#include <cstdio>
+#include "NFComm/NFCore/NFCRecord.h"
+
+static int nFailed = 0;
+
+#define NF_CHECK(x) do { if (!(x)) { ++nFailed; printf("%s:%d: %s\n", __FILE__, __LINE__, #x); } } while (0)
+
+static NF_SHARE_PTR<NFIRecord> NewRecord()
+{
+    NF_SHARE_PTR<NFDataList> xType(NF_NEW NFDataList());
+    *xType << (NFINT64)0 << std::string();
+
+    NF_SHARE_PTR<NFDataList> xTag(NF_NEW NFDataList());
+    *xTag << std::string("ID") << std::string("Name");
+
+    NF_SHARE_PTR<NFIRecord> xRecord(NF_NEW NFCRecord(NFGUID(), "TestRecord", xType, xTag, 4));
+    xRecord->SetIndex(0, NF_RECORD_INDEX_UNIQUE);
+    return xRecord;
+}
+
+static NFDataList Row(const NFINT64 nID, const std::string& strName)
+{
+    NFDataList xRow;
+    xRow << nID << strName;
+    return xRow;
+}
+
+//a row set back to used must pass the same unique check as Set and AddRow
+static void TestSetUsedUnique()
+{
+    NF_SHARE_PTR<NFIRecord> xRecord = NewRecord();
+
+    NF_CHECK(xRecord->AddRow(1, Row(5, "a")) == 1);
+    NF_CHECK(xRecord->AddRow(2, Row(5, "b")) < 0);
+    NF_CHECK(xRecord->SetUsed(1, 0));
+
+    //the unused row keeps its cells, the key is free again
+    NF_CHECK(xRecord->AddRow(2, Row(5, "b")) == 2);
+    NF_CHECK(!xRecord->SetUsed(1, 1));
+    NF_CHECK(!xRecord->IsUsed(1));
+    NF_CHECK(xRecord->FindInt(0, 5) == 2);
+
+    NF_CHECK(xRecord->SetUsed(2, 0));
+    NF_CHECK(xRecord->SetUsed(1, 1));
+    NF_CHECK(xRecord->IsUsed(1));
+    NF_CHECK(xRecord->FindInt(0, 5) == 1);
+
+    //the null value is never a duplicate
+    NF_CHECK(xRecord->SetInt(1, 0, 0));
+    NF_CHECK(xRecord->AddRow(0) == 0);
+    NF_CHECK(xRecord->SetUsed(2, 1));
+    NF_CHECK(xRecord->FindInt(0, 5) == 2);
+}
+
+int main()
+{
+    TestSetUsedUnique();
+
+    printf("NFRecordTest %s\n", nFailed == 0 ? "passed" : "failed");
+    return nFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFRouteStripTest.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFRouteStripTest
+//
+// -------------------------------------------------------------------------
+
+#include <cstdio>
+#include "NFComm/NFPluginModule/NFINetModule.h"
+
+static int nFailed = 0;
+
+#define NF_CHECK(x) do { if (!(x)) { ++nFailed; printf("%s:%d: %s\n", __FILE__, __LINE__, #x); } } while (0)
+
+static NFMsg::MsgBase NewMsgBase(const int nClientCount, const bool bHashIdent)
+{
+    NFMsg::MsgBase xMsg;
+    *xMsg.mutable_player_id() = NFINetModule::NFToPB(NFGUID(1, 2));
+    xMsg.set_msg_data(std::string(300, 'd'));
+    for (int i = 0; i < nClientCount; ++i)
+    {
+        *xMsg.add_player_client_list() = NFINetModule::NFToPB(NFGUID(3, i));
+    }
+
+    if (bHashIdent)
+    {
+        *xMsg.mutable_hash_ident() = NFINetModule::NFToPB(NFGUID(4, 5));
+    }
+
+    return xMsg;
+}
+
+//the wire walk gives the bytes protobuf itself gives without the list
+static void TestSameAsReserialize()
+{
+    for (int nClientCount = 0; nClientCount < 4; ++nClientCount)
+    {
+        for (int nHash = 0; nHash < 2; ++nHash)
+        {
+            NFMsg::MsgBase xMsg = NewMsgBase(nClientCount, nHash != 0);
+            const std::string strData = xMsg.SerializeAsString();
+
+            std::string strStrip;
+            NF_CHECK(NFINetModule::StripPBClientList(0, strData.data(), (uint32_t)strData.length(), strStrip));
+
+            xMsg.clear_player_client_list();
+            NF_CHECK(strStrip == xMsg.SerializeAsString());
+        }
+    }
+}
+
+//the list is dropped wherever it is, also split around the other fields
+static void TestInterleaved()
+{
+    NFMsg::MsgBase xList = NewMsgBase(2, false);
+    xList.clear_player_id();
+    xList.clear_msg_data();
+
+    NFMsg::MsgBase xHead = NewMsgBase(0, false);
+    xHead.clear_msg_data();
+
+    NFMsg::MsgBase xBody = NewMsgBase(0, true);
+    xBody.clear_player_id();
+
+    const std::string strData = xList.SerializePartialAsString() + xHead.SerializePartialAsString() + xList.SerializePartialAsString() + xBody.SerializePartialAsString();
+
+    std::string strStrip;
+    NF_CHECK(NFINetModule::StripPBClientList(0, strData.data(), (uint32_t)strData.length(), strStrip));
+    NF_CHECK(strStrip == xHead.SerializePartialAsString() + xBody.SerializePartialAsString());
+
+    NFMsg::MsgBase xStrip;
+    NF_CHECK(xStrip.ParseFromString(strStrip));
+    NF_CHECK(xStrip.player_client_list_size() == 0);
+    NF_CHECK(xStrip.msg_data() == xBody.msg_data());
+    NF_CHECK(xStrip.has_hash_ident());
+}
+
+static void TestBadData()
+{
+    const std::string strData = NewMsgBase(2, true).SerializeAsString();
+
+    std::string strStrip;
+    for (size_t nLen = 1; nLen < strData.length(); ++nLen)
+    {
+        //a cut inside a field must fail, a cut between two fields is a shorter message
+        if (NFINetModule::StripPBClientList(0, strData.data(), (uint32_t)nLen, strStrip))
+        {
+            NFMsg::MsgBase xStrip;
+            NF_CHECK(xStrip.ParsePartialFromString(strStrip));
+            NF_CHECK(xStrip.player_client_list_size() == 0);
+        }
+    }
+
+    const char szBadTag[] = { 0x0F, 0x01 };
+    NF_CHECK(!NFINetModule::StripPBClientList(0, szBadTag, sizeof(szBadTag), strStrip));
+}
+
+int main()
+{
+    TestSameAsReserialize();
+    TestInterleaved();
+    TestBadData();
+
+    printf("NFRouteStripTest %s\n", nFailed == 0 ? "passed" : "failed");
+    return nFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFScheduleBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFScheduleBench
+//
+// -------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "NFComm/NFKernelPlugin/NFCScheduleModule.h"
+#include "NFTestPluginManager.h"
+
+class NFScheduleBenchSink
+{
+public:
+    NFScheduleBenchSink()
+    {
+        mnFired = 0;
+    }
+
+    int OnHeartBeat(const NFGUID& self, const std::string& strHeartBeat, const float fTime, const int nCount)
+    {
+        ++mnFired;
+        return 0;
+    }
+
+    int64_t mnFired;
+};
+
+//the cost of a frame with many heartbeats on a fake 10 ms frame clock, the heartbeat count is the first argument
+int main(int argc, char** argv)
+{
+    const int nCount = argc > 1 ? atoi(argv[1]) : 100000;
+
+    NFTestPluginManager xPluginManager;
+    NFCScheduleModule xScheduleModule(&xPluginManager);
+    NFIScheduleModule& xSchedule = xScheduleModule;
+    NFScheduleBenchSink xSink;
+
+    //four heartbeats an object, spread from 1 s to 3 s
+    for (int i = 0; i < nCount; ++i)
+    {
+        xSchedule.AddSchedule(NFGUID(1, i / 4), "HeartBeat" + std::to_string(i % 4), &xSink, &NFScheduleBenchSink::OnHeartBeat,
+                              1.0f + (i % 4) * 0.5f + (i % 97) * 0.01f, -1);
+    }
+
+    xScheduleModule.Execute();
+
+    const int nFrame = 2000;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nFrame; ++i)
+    {
+        xPluginManager.AddFrameTime(10);
+        xScheduleModule.Execute();
+    }
+
+    const double fFrameUS = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - xStart).count() / nFrame;
+
+    //nothing is due in these frames
+    xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nFrame; ++i)
+    {
+        xScheduleModule.Execute();
+    }
+
+    const double fIdleUS = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - xStart).count() / nFrame;
+
+    //objects come and go
+    xStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100000; ++i)
+    {
+        xSchedule.AddSchedule(NFGUID(2, i), "Once", &xSink, &NFScheduleBenchSink::OnHeartBeat, 5.0f, 1);
+    }
+
+    xScheduleModule.Execute();
+    for (int i = 0; i < 100000; ++i)
+    {
+        xSchedule.RemoveSchedule(NFGUID(2, i));
+    }
+
+    xScheduleModule.Execute();
+    const double fChurnMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - xStart).count();
+
+    printf("heartbeats %d  %.1f us per frame (%lld fired)  %.1f us per idle frame  add and remove 100k %.1f ms\n",
+           nCount, fFrameUS, (long long)xSink.mnFired, fIdleUS, fChurnMS);
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFSpawnBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFSpawnBench
+//
+// -------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "NFComm/NFConfigPlugin/NFCClassModule.h"
+#include "NFComm/NFCore/NFCObject.h"
+#include "NFTestPluginManager.h"
+
+//every heap allocation of the bench is counted
+static size_t nAllocCount = 0;
+
+void* operator new(size_t nSize)
+{
+    ++nAllocCount;
+    void* p = malloc(nSize ? nSize : 1);
+    if (NULL == p)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+static int OnPropertyEvent(const NFGUID& self, const std::string& strPropertyName, const NFData& oldVar, const NFData& newVar)
+{
+    return 0;
+}
+
+static int OnRecordEvent(const NFGUID& self, const RECORD_EVENT_DATA& xEventData, const NFData& oldVar, const NFData& newVar)
+{
+    return 0;
+}
+
+//the property and record part of NFCKernelModule::CreateObject
+static NF_SHARE_PTR<NFIObject> Spawn(NFCClassModule& xClassModule, const std::string& strClassName, const NFGUID& ident, NFIPluginManager* pPluginManager)
+{
+    static PROPERTY_EVENT_FUNCTOR_PTR xPropertyEvent(NF_NEW PROPERTY_EVENT_FUNCTOR(&OnPropertyEvent));
+    static RECORD_EVENT_FUNCTOR_PTR xRecordEvent(NF_NEW RECORD_EVENT_FUNCTOR(&OnRecordEvent));
+
+    NF_SHARE_PTR<NFIPropertyManager> pStaticClassPropertyManager = xClassModule.GetClassPropertyManager(strClassName);
+    NF_SHARE_PTR<NFIRecordManager> pStaticClassRecordManager = xClassModule.GetClassRecordManager(strClassName);
+
+    NF_SHARE_PTR<NFIObject> pObject(NF_NEW NFCObject(ident, pPluginManager));
+    NF_SHARE_PTR<NFIPropertyManager> pPropertyManager = pObject->GetPropertyManager();
+    NF_SHARE_PTR<NFIRecordManager> pRecordManager = pObject->GetRecordManager();
+
+    NF_SHARE_PTR<NFIClassStore> xClassStore = xClassModule.GetClassStore(strClassName);
+    const int nStoreRow = xClassStore ? xClassStore->AddRow(ident) : -1;
+
+    pPropertyManager->CloneFrom(pStaticClassPropertyManager);
+    pRecordManager->CloneFrom(pStaticClassRecordManager);
+
+    for (int nSlot = 0; nSlot < pPropertyManager->GetPropertySlotCount(); ++nSlot)
+    {
+        NF_SHARE_PTR<NFIProperty> xProperty = pPropertyManager->GetPropertyBySlot(nSlot);
+        if (!xProperty)
+        {
+            continue;
+        }
+
+        if (nStoreRow >= 0)
+        {
+            xProperty->SetStore(xClassStore, nSlot, nStoreRow);
+        }
+
+        if (xProperty->GetMask() & (NF_PROPERTY_MASK_PUBLIC | NF_PROPERTY_MASK_PRIVATE))
+        {
+            xProperty->RegisterCallback(xPropertyEvent);
+        }
+    }
+
+    for (int nSlot = 0; nSlot < pRecordManager->GetRecordSlotCount(); ++nSlot)
+    {
+        NF_SHARE_PTR<NFIRecord> xRecord = pRecordManager->GetRecordBySlot(nSlot);
+        if (xRecord)
+        {
+            xRecord->AddRecordHook(xRecordEvent);
+        }
+    }
+
+    return pObject;
+}
+
+//how fast the objects of a class come out of its prototype, the class name is the first argument
+int main(int argc, char** argv)
+{
+    NFTestPluginManager xPluginManager(NF_TEST_CONFIG_PATH);
+    NFCClassModule xClassModule(&xPluginManager);
+    xClassModule.Load();
+
+    const std::string strClassName = argc > 1 ? argv[1] : "NPC";
+    if (!xClassModule.GetClassPropertyManager(strClassName))
+    {
+        printf("no class %s under %s\n", strClassName.c_str(), NF_TEST_CONFIG_PATH);
+        return 1;
+    }
+
+    const int nCount = 5000;
+    std::vector<NF_SHARE_PTR<NFIObject>> xObjectList;
+    xObjectList.reserve(nCount);
+
+    const size_t nAllocStart = nAllocCount;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < nCount; ++i)
+    {
+        xObjectList.push_back(Spawn(xClassModule, strClassName, NFGUID(1, i + 1), &xPluginManager));
+    }
+
+    const double fSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+    printf("%s: %.0f spawns/s  %.1f allocs per spawn  properties %d  records %d\n", strClassName.c_str(), nCount / fSec,
+           (double)(nAllocCount - nAllocStart) / nCount, xObjectList[0]->GetPropertyManager()->Count(), xObjectList[0]->GetRecordManager()->Count());
+
+    return 0;
+}
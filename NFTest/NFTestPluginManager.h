@@ -0,0 +1,77 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFTestPluginManager.h
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFTestPluginManager
+//
+// -------------------------------------------------------------------------
+
+#ifndef NF_TEST_PLUGIN_MANAGER_H
+#define NF_TEST_PLUGIN_MANAGER_H
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include "NFComm/NFPluginModule/NFIPluginManager.h"
+
+//only what the modules under test ask for, the config files are read from the tree and the frame time moves by hand
+class NFTestPluginManager : public NFIPluginManager
+{
+public:
+    NFTestPluginManager(const std::string& strConfigPath = "")
+    {
+        mstrConfigPath = strConfigPath;
+    }
+
+    virtual bool ReLoadPlugin(const std::string& strPluginDLLName) { return false; }
+    virtual void Registered(NFIPlugin* plugin) {}
+    virtual void UnRegistered(NFIPlugin* plugin) {}
+    virtual NFIPlugin* FindPlugin(const std::string& strPluginName) { return NULL; }
+    virtual void AddModule(const std::string& strModuleName, NFIModule* pModule) {}
+    virtual void RemoveModule(const std::string& strModuleName) {}
+    virtual NFIModule* FindModule(const std::string& strModuleName) { return NULL; }
+    virtual int GetAppID() const { return 0; }
+    virtual void SetAppID(const int nAppID) {}
+    virtual NFINT64 GetInitTime() const { return 0; }
+    virtual NFINT64 GetNowTime() const { return NFGetTimeS(); }
+    virtual const std::string& GetConfigPath() const { return mstrConfigPath; }
+    virtual void SetConfigPath(const std::string & strPath) { mstrConfigPath = strPath; }
+    virtual void SetConfigName(const std::string& strFileName) {}
+    virtual const std::string& GetConfigName() const { return mstrNull; }
+    virtual const std::string& GetAppName() const { return mstrNull; }
+    virtual void SetAppName(const std::string& strAppName) {}
+    virtual const std::string& GetLogConfigName() const { return mstrNull; }
+    virtual void SetLogConfigName(const std::string& strName) {}
+    virtual void SetGetFileContentFunctor(GET_FILECONTENT_FUNCTOR fun) {}
+    virtual void ExecuteCoScheduler() {}
+    virtual void StartCoroutine() {}
+    virtual void StartCoroutine(CoroutineFunction func) {}
+    virtual void YieldCo(const float nSecond) {}
+    virtual void YieldCo() {}
+
+    void AddFrameTime(const NFINT64 nMS)
+    {
+        mnFrameTimeMS += nMS;
+        mnFrameWallTimeMS += nMS;
+    }
+
+    virtual bool GetFileContent(const std::string &strFileName, std::string &strContent)
+    {
+        std::ifstream xFile(strFileName.c_str());
+        if (!xFile)
+        {
+            return false;
+        }
+
+        std::stringstream xStream;
+        xStream << xFile.rdbuf();
+        strContent = xStream.str();
+        return true;
+    }
+
+private:
+    std::string mstrConfigPath;
+    std::string mstrNull;
+};
+
+#endif
@@ -0,0 +1,112 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFViewGridBench.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-24
+//    @Module           :    NFViewGridBench
+//
+// -------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include "NFComm/NFCore/NFViewGrid.hpp"
+#include "NFComm/NFCore/NFHashMapEx.hpp"
+
+//players walk at random in a 1000 x 1000 scene with a view range of 50, every move is sent to the view list
+static void RunCount(const int nCount)
+{
+    const int nSceneWidth = 1000;
+    const int nFrame = 20;
+
+    std::mt19937 xRandom(7);
+    std::uniform_real_distribution<float> xPos(0, (float)nSceneWidth);
+
+    NFViewGrid xGrid;
+    xGrid.Init(50, nSceneWidth);
+
+    std::vector<NFGUID> xIDList(nCount);
+    std::vector<NFVector3> xPosList(nCount);
+    std::vector<NFVector3> xDirList(nCount);
+    for (int i = 0; i < nCount; ++i)
+    {
+        const float fAngle = xPos(xRandom);
+        xIDList[i] = NFGUID(1, i + 1);
+        xPosList[i] = NFVector3(xPos(xRandom), 0, xPos(xRandom));
+        xDirList[i] = NFVector3(cos(fAngle) * 3, 0, sin(fAngle) * 3);
+        xGrid.AddObject(xIDList[i], true, xPosList[i]);
+    }
+
+    int64_t nReceiver = 0;
+    int64_t nEnterLeave = 0;
+    std::chrono::steady_clock::time_point xStart = std::chrono::steady_clock::now();
+    for (int nTick = 0; nTick < nFrame; ++nTick)
+    {
+        for (int i = 0; i < nCount; ++i)
+        {
+            NFVector3 vPos(xPosList[i].X() + xDirList[i].X(), 0, xPosList[i].Z() + xDirList[i].Z());
+            if (vPos.X() < 0 || vPos.X() > nSceneWidth)
+            {
+                xDirList[i].SetX(-xDirList[i].X());
+            }
+
+            if (vPos.Z() < 0 || vPos.Z() > nSceneWidth)
+            {
+                xDirList[i].SetZ(-xDirList[i].Z());
+            }
+
+            xPosList[i] = vPos;
+
+            NFDataList xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther;
+            xGrid.MoveObject(xIDList[i], vPos, xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther);
+            nEnterLeave += xEnterPlayer.GetCount() + xLeavePlayer.GetCount();
+
+            NFDataList xViewList;
+            xGrid.GetViewList(xIDList[i], xViewList, true, NFGUID());
+            nReceiver += xViewList.GetCount();
+        }
+    }
+
+    const double fGridSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+
+    //what the group broadcast did before, every move goes to every player of the group
+    NFHashMapEx<NFGUID, int> xGroup;
+    for (int i = 0; i < nCount; ++i)
+    {
+        xGroup.AddElement(xIDList[i], NF_SHARE_PTR<int>(NF_NEW int(0)));
+    }
+
+    const int nGroupFrame = nCount >= 5000 ? 2 : nFrame;
+    int64_t nGroupReceiver = 0;
+    xStart = std::chrono::steady_clock::now();
+    for (int nTick = 0; nTick < nGroupFrame; ++nTick)
+    {
+        for (int i = 0; i < nCount; ++i)
+        {
+            NFDataList xViewList;
+            for (NFHashMapEx<NFGUID, int>::iterator it = xGroup.begin(); it != xGroup.end(); ++it)
+            {
+                xViewList.Add(it->first);
+            }
+
+            nGroupReceiver += xViewList.GetCount();
+        }
+    }
+
+    const double fGroupSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - xStart).count();
+
+    const double fMove = (double)nCount * nFrame;
+    const double fGroupMove = (double)nCount * nGroupFrame;
+    printf("N=%5d grid: %.0f moves/s, %.1f receivers/move, %.2f enter+leave/move | group: %.0f moves/s, %.0f receivers/move\n",
+           nCount, fMove / fGridSec, nReceiver / fMove, nEnterLeave / fMove, fGroupMove / fGroupSec, nGroupReceiver / fGroupMove);
+}
+
+int main()
+{
+    RunCount(1000);
+    RunCount(5000);
+    RunCount(10000);
+
+    return 0;
+}
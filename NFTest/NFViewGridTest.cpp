@@ -0,0 +1,164 @@
+// -------------------------------------------------------------------------
+//    @FileName         :    NFViewGridTest.cpp
+//    @Author           :    LvSheng.Huang
+//    @Date             :    2017-10-25
+//    @Module           :    NFViewGridTest
+//
+// -------------------------------------------------------------------------
+
+#include <set>
+#include <limits>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include "NFComm/NFCore/NFViewGrid.hpp"
+
+static int nFailed = 0;
+
+#define NF_CHECK(x) do { if (!(x)) { ++nFailed; printf("%s:%d: %s\n", __FILE__, __LINE__, #x); } } while (0)
+
+class NFTestViewGrid : public NFViewGrid
+{
+public:
+    size_t GetCellCount() const
+    {
+        return mxCell.size();
+    }
+};
+
+static const int nCellSize = 40;
+static const int nWidth = 600;
+
+//the cell rule the grid has to follow, a position outside of the scene is on its edge
+static int CellOf(const float fValue)
+{
+    const float fPos = fValue < 0.0f ? 0.0f : (fValue > nWidth ? (float)nWidth : fValue);
+    return (int)std::floor(fPos / nCellSize);
+}
+
+//the enter and leave lists of every move against the visibility of every pair
+static void TestMoveAgainstBruteForce()
+{
+    std::mt19937 xRandom(1);
+    std::uniform_real_distribution<float> xPos(-60.0f, nWidth + 60.0f);
+
+    NFTestViewGrid xGrid;
+    xGrid.Init(nCellSize, nWidth);
+
+    const int nCount = 300;
+    std::vector<NFGUID> xID(nCount);
+    std::vector<NFVector3> xPosList(nCount);
+    std::vector<bool> xPlayer(nCount);
+    for (int i = 0; i < nCount; ++i)
+    {
+        xID[i] = NFGUID(1, i + 1);
+        xPosList[i] = NFVector3(xPos(xRandom), 0.0f, xPos(xRandom));
+        xPlayer[i] = i % 3 == 0;
+        NF_CHECK(xGrid.AddObject(xID[i], xPlayer[i], xPosList[i]));
+    }
+
+    for (int nStep = 0; nStep < 50000; ++nStep)
+    {
+        const int a = xRandom() % nCount;
+        NFVector3 vNew(xPosList[a].X() + (int)(xRandom() % 41) - 20, 0.0f, xPosList[a].Z() + (int)(xRandom() % 41) - 20);
+        if (xRandom() % 10 == 0)
+        {
+            vNew = NFVector3(xPos(xRandom), 0.0f, xPos(xRandom));
+        }
+
+        std::vector<bool> xBefore(nCount);
+        for (int b = 0; b < nCount; ++b)
+        {
+            xBefore[b] = b != a
+                && std::abs(CellOf(xPosList[a].X()) - CellOf(xPosList[b].X())) <= 1
+                && std::abs(CellOf(xPosList[a].Z()) - CellOf(xPosList[b].Z())) <= 1;
+        }
+
+        NFDataList xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther;
+        NF_CHECK(xGrid.MoveObject(xID[a], vNew, xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther));
+        xPosList[a] = vNew;
+
+        std::set<int> xEnter;
+        std::set<int> xLeave;
+        const NFDataList* pList[4] = { &xEnterPlayer, &xEnterOther, &xLeavePlayer, &xLeaveOther };
+        for (int l = 0; l < 4; ++l)
+        {
+            for (int k = 0; k < pList[l]->GetCount(); ++k)
+            {
+                const int b = (int)pList[l]->Object(k).nData64 - 1;
+                NF_CHECK(xPlayer[b] == (l % 2 == 0));
+                NF_CHECK((l < 2 ? xEnter : xLeave).insert(b).second);
+            }
+        }
+
+        for (int b = 0; b < nCount; ++b)
+        {
+            if (b == a)
+            {
+                continue;
+            }
+
+            const bool bAfter = std::abs(CellOf(xPosList[a].X()) - CellOf(xPosList[b].X())) <= 1
+                && std::abs(CellOf(xPosList[a].Z()) - CellOf(xPosList[b].Z())) <= 1;
+            NF_CHECK((!xBefore[b] && bAfter) == (xEnter.count(b) > 0));
+            NF_CHECK((xBefore[b] && !bAfter) == (xLeave.count(b) > 0));
+        }
+    }
+
+    for (int i = 0; i < nCount; ++i)
+    {
+        NF_CHECK(xGrid.RemoveObject(xID[i]));
+    }
+
+    NF_CHECK(xGrid.GetCellCount() == 0);
+}
+
+//NaN and the infinities land on the scene edges, and the cells left empty are dropped
+static void TestBadPosition()
+{
+    const float fNaN = std::numeric_limits<float>::quiet_NaN();
+    const float fInf = std::numeric_limits<float>::infinity();
+
+    NFTestViewGrid xGrid;
+    xGrid.Init(nCellSize, nWidth);
+
+    const NFGUID xSelf(1, 1);
+    const NFGUID xOther(1, 2);
+    NF_CHECK(xGrid.AddObject(xSelf, true, NFVector3(fNaN, 0.0f, fNaN)));
+    NF_CHECK(xGrid.AddObject(xOther, true, NFVector3(0.0f, 0.0f, 0.0f)));
+    NF_CHECK(xGrid.GetCellCount() == 1);
+
+    NFDataList xView;
+    NF_CHECK(xGrid.GetViewList(xSelf, xView, true, xSelf));
+    NF_CHECK(xView.GetCount() == 1);
+
+    NFDataList xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther;
+    NF_CHECK(xGrid.MoveObject(xSelf, NFVector3(fInf, 0.0f, -fInf), xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther));
+    NF_CHECK(xLeavePlayer.GetCount() == 1);
+    NF_CHECK(xGrid.GetCellCount() == 2);
+
+    NF_CHECK(xGrid.MoveObject(xSelf, NFVector3(1e30f, 0.0f, 1e30f), xEnterPlayer, xEnterOther, xLeavePlayer, xLeaveOther));
+    NF_CHECK(xGrid.GetCellCount() == 2);
+
+    //no bounds, the cell index is capped so that its neighbours still fit an int
+    NFTestViewGrid xOpen;
+    xOpen.Init(1, 0);
+    NF_CHECK(xOpen.AddObject(xSelf, false, NFVector3(fInf, 0.0f, -fInf)));
+    NF_CHECK(xOpen.AddObject(xOther, false, NFVector3(3e38f, 0.0f, -3e38f)));
+    xView.Clear();
+    NF_CHECK(xOpen.GetViewList(xSelf, xView, false, xSelf));
+    NF_CHECK(xView.GetCount() == 1);
+
+    NF_CHECK(xOpen.RemoveObject(xSelf));
+    NF_CHECK(xOpen.RemoveObject(xOther));
+    NF_CHECK(xOpen.GetCellCount() == 0);
+}
+
+int main()
+{
+    TestMoveAgainstBruteForce();
+    TestBadPosition();
+
+    printf("NFViewGridTest %s\n", nFailed == 0 ? "passed" : "failed");
+    return nFailed == 0 ? 0 : 1;
+}
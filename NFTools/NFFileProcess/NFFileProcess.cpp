@@ -224,6 +224,14 @@ bool NFFileProcess::LoadDataAndProcessProperty(MiniExcelReader::Sheet & sheet, C
 			}
 		}
 
+		//int|index lets the objects of a scene group be looked up by the value
+		std::string& strType = pClassProperty->descList["Type"];
+		std::string::size_type nIndexPos = strType.find('|');
+		if (nIndexPos != std::string::npos)
+		{
+			pClassProperty->descList["Index"] = strType.substr(nIndexPos + 1) == "index" ? "1" : "0";
+			strType = strType.substr(0, nIndexPos);
+		}
 	}
 
 	return false;
@@ -331,6 +339,15 @@ bool NFFileProcess::LoadDataAndProcessRecord(MiniExcelReader::Sheet & sheet, Cla
 				NFClassRecord::RecordColDesc* pRecordColDesc = new NFClassRecord::RecordColDesc();
 				pRecordColDesc->index = c - 1;
 				pRecordColDesc->type = pCellColType->value;
+
+				//object|unique or string|multi declares an index for the col
+				std::string::size_type nIndexPos = pRecordColDesc->type.find('|');
+				if (nIndexPos != std::string::npos)
+				{
+					pRecordColDesc->index_type = pRecordColDesc->type.substr(nIndexPos + 1);
+					pRecordColDesc->type = pRecordColDesc->type.substr(0, nIndexPos);
+				}
+
 				if (pCellColDesc)
 				{
 					pRecordColDesc->desc = pCellColDesc->value;
@@ -472,8 +489,44 @@ bool NFFileProcess::SaveForCPP()
 
 		fwrite(strRecordInfo.c_str(), strRecordInfo.length(), 1, hppWriter);
 
-		std::string strHppEnumInfo = "";
+		//slot, the order NFCClassModule gives them at load time
+		std::string strHppEnumInfo = "\t\t// Slot\n\t\tstruct PropertySlot\n\t\t{\n\t\t\tenum\n\t\t\t{\n";
+		int nSlot = 0;
+		if (strClassName != "IObject")
+		{
+			for (std::map<std::string, NFClassProperty*>::iterator itProperty = pBaseObject->xStructData.xPropertyList.begin();
+				itProperty != pBaseObject->xStructData.xPropertyList.end(); ++itProperty)
+			{
+				strHppEnumInfo += "\t\t\t\t" + itProperty->first + " = " + std::to_string(nSlot++) + ",\n";
+			}
+		}
 
+		for (std::map<std::string, NFClassProperty*>::iterator itProperty = pClassDta->xStructData.xPropertyList.begin();
+			itProperty != pClassDta->xStructData.xPropertyList.end(); ++itProperty)
+		{
+			strHppEnumInfo += "\t\t\t\t" + itProperty->first + " = " + std::to_string(nSlot++) + ",\n";
+		}
+
+		strHppEnumInfo += "\t\t\t};\n\t\t};\n";
+
+		strHppEnumInfo += "\t\tstruct RecordSlot\n\t\t{\n";
+		if (!pClassDta->xStructData.xRecordList.empty())
+		{
+			strHppEnumInfo += "\t\t\tenum\n\t\t\t{\n";
+
+			nSlot = 0;
+			for (std::map<std::string, NFClassRecord*>::iterator itRecord = pClassDta->xStructData.xRecordList.begin();
+				itRecord != pClassDta->xStructData.xRecordList.end(); ++itRecord)
+			{
+				strHppEnumInfo += "\t\t\t\t" + itRecord->first + " = " + std::to_string(nSlot++) + ",\n";
+			}
+
+			strHppEnumInfo += "\t\t\t};\n";
+		}
+
+		strHppEnumInfo += "\t\t};\n";
+
+		fwrite(strHppEnumInfo.c_str(), strHppEnumInfo.length(), 1, hppWriter);
 
 		std::string strClassEnd;
 		strClassEnd += "\n\t};\n";
@@ -808,7 +861,13 @@ bool NFFileProcess::SaveForStruct()
 
 					if (pRecordColDesc->index == i)
 					{
-						strElementData += "\t\t\t<Col Type =\"" + pRecordColDesc->type + "\"\tTag=\"" + strKey + "\"/>";
+						strElementData += "\t\t\t<Col Type =\"" + pRecordColDesc->type + "\"\tTag=\"" + strKey + "\"";
+						if (!pRecordColDesc->index_type.empty())
+						{
+							strElementData += "\tIndex=\"" + pRecordColDesc->index_type + "\"";
+						}
+
+						strElementData += "/>";
 						if (!pRecordColDesc->desc.empty())
 						{
 							strElementData += "<!--- " + pRecordColDesc->desc + "-->\n";
@@ -29,6 +29,7 @@ public:
 		int index;
 		std::string type;
 		std::string desc;
+		std::string index_type;//unique or multi, empty if the col has no index
 	};
 	
 	std::string strClassName;
@@ -1091,6 +1091,7 @@ namespace NFrame
 		public static readonly String TagPos = "TagPos";// string
 		public static readonly String Tile = "Tile";// int
 		public static readonly String Type = "Type";// int
+		public static readonly String ViewRange = "ViewRange";// int
 		public static readonly String Width = "Width";// int
 		// Record
 
@@ -1114,6 +1114,7 @@ namespace NFrame
 		static const std::string& TagPos(){ static std::string x = "TagPos"; return x; };// string
 		static const std::string& Tile(){ static std::string x = "Tile"; return x; };// int
 		static const std::string& Type(){ static std::string x = "Type"; return x; };// int
+		static const std::string& ViewRange(){ static std::string x = "ViewRange"; return x; };// int
 		static const std::string& Width(){ static std::string x = "Width"; return x; };// int
 		// Record
 
@@ -1085,6 +1085,7 @@ package nframe;
 		public static final String TagPos = "TagPos";// string
 		public static final String Tile = "Tile";// int
 		public static final String Type = "Type";// int
+		public static final String ViewRange = "ViewRange";// int
 		public static final String Width = "Width";// int
 		// Record
 